@@ -0,0 +1,10 @@
+#include "bench.h"
+
+// Main function
+int main(void) {
+    printf("fix_point benchmarks\n");
+
+    bench_q_matrix();
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "bench_q_matrix.h"
+
+#define BENCH_MIN_TIME_NS (200000000ULL) // Minimum accumulated time per measurement (0.2 s)
+
+/**
+ * @brief Returns the monotonic time in nanoseconds
+ * 
+ * @return uint64_t The current time in nanoseconds
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+#endif // BENCH_H
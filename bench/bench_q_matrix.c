@@ -0,0 +1,1105 @@
+#include <math.h>
+#include "bench.h"
+#include "../include/fix_point_simd.h"
+#include "../include/fix_point_matrix_q7.h"
+#include "../include/fix_point_gemm.h"
+#include "../include/fix_point_lu.h"
+#include "../include/fix_point_cholesky.h"
+#include "../include/fix_point_qr.h"
+#include "../include/fix_point_eigen.h"
+#include "../tests/test_fixtures.h"
+
+/**
+ * @brief Reference PLU decomposition as it was implemented before the single pass elimination.
+ * @details A full LU decomposition of the pivoted matrix is performed at every pivot step, which makes it O(n^4).
+ * Kept in the benchmark only to show the complexity change.
+ */
+static void bench_PLU_reference(const q_matrix_t* m, q_matrix_t* P, q_matrix_t* L, q_matrix_t* U)
+{
+    q_matrix_t temp = q_matrix_alloc(m->rows, m->cols);
+    q_matrix_identity(P);
+    q_matrix_identity(L);
+    q_matrix_cpy(m, U);
+    q_matrix_cpy(m, &temp);
+
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        size_t max_idx = i;
+        q_t max_val = q_absolute(Q_MATRIX_AT(U, max_idx, i));
+
+        for(size_t j = i; j < m->cols; j++)
+        {
+            q_t val = q_absolute(Q_MATRIX_AT(U, j, i));
+            if(val > max_val)
+            {
+                max_val = val;
+                max_idx = j;
+            }
+        }
+
+        q_matrix_t copy = q_matrix_alloc(m->rows, m->cols); // The previous row switch copied the whole matrix
+        q_matrix_switch_rows(P, &copy, i, max_idx); q_matrix_cpy(&copy, P);
+        q_matrix_switch_rows(U, &copy, i, max_idx); q_matrix_cpy(&copy, U);
+        q_matrix_switch_rows(&temp, &copy, i, max_idx); q_matrix_cpy(&copy, &temp);
+        q_matrix_free(&copy);
+
+        q_matrix_LU_decomposition(&temp, L, U);
+    }
+
+    q_matrix_free(&temp);
+}
+
+void bench_q_matrix_PLU_decomposition()
+{
+    printf("\nq_matrix_PLU_decomposition (single pass) vs reference (LU per pivot step)\n");
+    printf("%6s %16s %10s %16s %10s\n", "n", "PLU [ns]", "ratio", "reference [ns]", "ratio");
+
+    double prev = 0.0, prev_ref = 0.0;
+
+    for(size_t n = 8; n <= 512; n <<= 1)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t P = q_matrix_square_alloc(n);
+        q_matrix_t L = q_matrix_square_alloc(n);
+        q_matrix_t U = q_matrix_square_alloc(n);
+        fill_well_conditioned(&m, INT_TO_Q(4));
+
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_matrix_PLU_decomposition(&m, &P, &L, &U);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS);
+        double t = (double) elapsed / reps;
+
+        double t_ref = 0.0;
+        if(n <= 128) // The reference grows as O(n^4), larger sizes take too long
+        {
+            reps = 0; start = bench_now_ns();
+            do {
+                bench_PLU_reference(&m, &P, &L, &U);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS);
+            t_ref = (double) elapsed / reps;
+        }
+
+        printf("%6zu %16.0f %10.2f", n, t, prev > 0.0 ? t / prev : 0.0);
+        if(t_ref > 0.0)
+        {
+            printf(" %16.0f %10.2f\n", t_ref, prev_ref > 0.0 ? t_ref / prev_ref : 0.0);
+        }
+        else
+        {
+            printf(" %16s %10s\n", "-", "-");
+        }
+
+        prev = t;
+        prev_ref = t_ref;
+
+        q_matrix_free(&m);
+        q_matrix_free(&P);
+        q_matrix_free(&L);
+        q_matrix_free(&U);
+    }
+}
+
+/**
+ * @brief Reference product with the naive i-j-k triple loop, as q_matrix_dot_product was implemented before the GEMM engine.
+ */
+static void bench_dot_product_reference(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* dst)
+{
+    q_zeros(dst);
+    for(size_t i = 0; i < dst->rows; i++){
+        for(size_t j = 0; j < dst->cols; j++){
+            for(size_t k = 0; k < a->cols; k++){
+                Q_MATRIX_AT(dst, i, j) += q_product(Q_MATRIX_AT(a, i, k), Q_MATRIX_AT(b, k, j));
+            }
+        }
+    }
+}
+
+void bench_q_matrix_dot_product()
+{
+    printf("\nq_matrix_dot_product (GEMM engine) vs reference (naive triple loop)\n");
+    printf("%6s %16s %12s %16s %12s\n", "n", "GEMM [ns]", "GMAC/s", "reference [ns]", "GMAC/s");
+
+    for(size_t n = 32; n <= 1024; n <<= 1)
+    {
+        q_matrix_t a = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_square_alloc(n);
+        q_matrix_t c = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&a, -1.0f, 1.0f);
+        q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+        const double macs = (double) n * n * n;
+
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_matrix_dot_product(&a, &b, &c);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS);
+        double t = (double) elapsed / reps;
+
+        printf("%6zu %16.0f %12.3f", n, t, macs / t);
+
+        if(n <= 512) // The reference takes too long for larger sizes
+        {
+            reps = 0; start = bench_now_ns();
+            do {
+                bench_dot_product_reference(&a, &b, &c);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS);
+            double t_ref = (double) elapsed / reps;
+            printf(" %16.0f %12.3f\n", t_ref, macs / t_ref);
+        }
+        else
+        {
+            printf(" %16s %12s\n", "-", "-");
+        }
+
+        q_matrix_free(&a);
+        q_matrix_free(&b);
+        q_matrix_free(&c);
+    }
+}
+
+void bench_q_matrix_elementwise()
+{
+    static const char* level_names[] = {"scalar", "sse4.1", "avx2"};
+    const q_simd_level_t supported = q_simd_detect();
+
+    printf("\nElement-wise operations per kernel level [ns / element]\n");
+    printf("%6s %8s %10s %10s %10s %10s %10s\n", "n", "level", "sum", "mul", "scalar", "fill", "cpy");
+
+    for(size_t n = 64; n <= 1024; n <<= 2)
+    {
+        q_matrix_t a = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_square_alloc(n);
+        q_matrix_t c = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&a, -1.0f, 1.0f);
+        q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+        const double elements = (double) n * n;
+
+        for(int level = Q_SIMD_SCALAR; level <= (int) supported; level++)
+        {
+            q_simd_set_level((q_simd_level_t) level);
+            double t[5];
+
+            for(size_t op = 0; op < 5; op++)
+            {
+                uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+                do {
+                    switch(op)
+                    {
+                        case 0: q_matrix_sum(&a, &b, &c); break;
+                        case 1: q_matrix_elementwise_mul(&a, &b, &c); break;
+                        case 2: q_matrix_scalar_mul(&c, Q_ONE); break;
+                        case 3: q_matrix_fill(&c, Q_ONE); break;
+                        default: q_matrix_cpy(&a, &c); break;
+                    }
+                    reps++;
+                    elapsed = bench_now_ns() - start;
+                } while(elapsed < BENCH_MIN_TIME_NS / 4);
+                t[op] = (double) elapsed / reps / elements;
+            }
+
+            printf("%6zu %8s %10.3f %10.3f %10.3f %10.3f %10.3f\n", n, level_names[level], t[0], t[1], t[2], t[3], t[4]);
+        }
+
+        q_matrix_free(&a);
+        q_matrix_free(&b);
+        q_matrix_free(&c);
+    }
+
+    q_simd_set_level(supported);
+}
+
+/**
+ * @brief Out of line q_product, reached through a volatile pointer so the compiler cannot inline it. It models the cost of the
+ * arithmetic core when it was only available as an external symbol in another translation unit.
+ */
+__attribute__((noinline)) static q_t bench_q_product_call(q_t a, q_t b)
+{
+    return q_product(a, b);
+}
+static q_t (*volatile bench_q_product_extern)(q_t, q_t) = bench_q_product_call;
+
+void bench_q_matrix_inline_core()
+{
+    const q_simd_level_t supported = q_simd_detect();
+
+    printf("\nInlined vs out of line q_product [ns / element]\n");
+    printf("%6s %14s %14s %14s %14s %14s\n", "n", "dot inline", "dot call", "dot GEMM", "scalar inline", "scalar call");
+
+    q_simd_set_level(Q_SIMD_SCALAR); // Measure the portable C loop of q_matrix_scalar_mul, not the vector kernels
+
+    for(size_t n = 64; n <= 256; n <<= 1)
+    {
+        q_matrix_t a = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_square_alloc(n);
+        q_matrix_t c = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&a, -1.0f, 1.0f);
+        q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+        const double macs = (double) n * n * n;
+        const double elements = (double) n * n;
+        double t[5];
+
+        for(size_t op = 0; op < 5; op++)
+        {
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                switch(op)
+                {
+                    case 0: bench_dot_product_reference(&a, &b, &c); break;
+                    case 1:
+                        q_zeros(&c);
+                        for(size_t i = 0; i < n; i++){
+                            for(size_t j = 0; j < n; j++){
+                                for(size_t k = 0; k < n; k++){
+                                    Q_MATRIX_AT(&c, i, j) += bench_q_product_extern(Q_MATRIX_AT(&a, i, k), Q_MATRIX_AT(&b, k, j));
+                                }
+                            }
+                        }
+                        break;
+                    case 2: q_matrix_dot_product(&a, &b, &c); break;
+                    case 3: q_matrix_scalar_mul(&a, Q_ONE); break;
+                    default:
+                        for(size_t i = 0; i < n; i++){
+                            for(size_t j = 0; j < n; j++){
+                                Q_MATRIX_AT(&a, i, j) = bench_q_product_extern(Q_MATRIX_AT(&a, i, j), Q_ONE);
+                            }
+                        }
+                        break;
+                }
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[op] = (double) elapsed / reps / (op < 3 ? macs : elements);
+        }
+
+        printf("%6zu %14.3f %14.3f %14.3f %14.3f %14.3f\n", n, t[0], t[1], t[2], t[3], t[4]);
+
+        q_matrix_free(&a);
+        q_matrix_free(&b);
+        q_matrix_free(&c);
+    }
+
+    q_simd_set_level(supported);
+}
+
+void bench_q_matrix_q7_dot_product()
+{
+    static const char* level_names[] = {"scalar", "avx2", "vnni"};
+    const q7_gemm_level_t supported = q7_gemm_detect();
+
+    printf("\nq7_gemm (int8, int32 accumulators) vs q_matrix_dot_product (Q16.16) [GMAC/s]\n");
+    printf("%6s %12s", "n", "Q16.16");
+    for(int level = Q7_GEMM_SCALAR; level <= (int) supported; level++)
+    {
+        printf(" %12s", level_names[level]);
+    }
+    printf("\n");
+
+    for(size_t n = 64; n <= 512; n <<= 1)
+    {
+        q_matrix_t a = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_square_alloc(n);
+        q_matrix_t c = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&a, -1.0f, 1.0f);
+        q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+
+        q7_matrix_t a7 = q7_matrix_square_alloc(n);
+        q7_matrix_t b7 = q7_matrix_square_alloc(n);
+        q7_matrix_t c7 = q7_matrix_square_alloc(n);
+        q7_matrix_from_q(&a, &a7);
+        q7_matrix_from_q(&b, &b7);
+        const q7_requant_t requant = q7_requant_from_float(1.0f / (float) n);
+        const double macs = (double) n * n * n;
+
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_matrix_dot_product(&a, &b, &c);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        printf("%6zu %12.3f", n, macs / ((double) elapsed / reps));
+
+        for(int level = Q7_GEMM_SCALAR; level <= (int) supported; level++)
+        {
+            q7_gemm_set_level((q7_gemm_level_t) level);
+            reps = 0; start = bench_now_ns();
+            do {
+                q7_gemm(&a7, &b7, NULL, requant, &c7);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            printf(" %12.3f", macs / ((double) elapsed / reps));
+        }
+        printf("\n");
+
+        q_matrix_free(&a);
+        q_matrix_free(&b);
+        q_matrix_free(&c);
+        q7_matrix_free(&a7);
+        q7_matrix_free(&b7);
+        q7_matrix_free(&c7);
+    }
+
+    q7_gemm_set_level(supported);
+}
+
+void bench_q_matrix_dot_product_threads()
+{
+    const size_t n = 1024;
+    const double macs = (double) n * n * n;
+
+    printf("\nq_gemm_parallel scaling (n = %zu, %zu threads by default)\n", n, q_thread_get_max_threads());
+    printf("%8s %16s %12s %10s\n", "threads", "time [ns]", "GMAC/s", "speedup");
+
+    q_matrix_t a = q_matrix_square_alloc(n);
+    q_matrix_t b = q_matrix_square_alloc(n);
+    q_matrix_t c = q_matrix_square_alloc(n);
+    q_matrix_fill_rand_float(&a, -1.0f, 1.0f);
+    q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+
+    double t_single = 0.0;
+    for(size_t threads = 1; threads <= 2 * q_thread_get_max_threads() && threads <= Q_THREAD_MAX; threads <<= 1)
+    {
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_gemm_parallel(&a, &b, &c, Q_GEMM_OVERWRITE, threads);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS);
+        const double t = (double) elapsed / reps;
+        t_single = (threads == 1) ? t : t_single;
+
+        printf("%8zu %16.0f %12.3f %10.2f\n", threads, t, macs / t, t_single / t);
+    }
+
+    q_matrix_free(&a);
+    q_matrix_free(&b);
+    q_matrix_free(&c);
+}
+
+/**
+ * @brief Element-wise sum and dot product of matrices with odd widths, allocated contiguously (q_matrix_alloc) and with
+ * aligned, padded rows (q_matrix_alloc_aligned).
+ */
+void bench_q_matrix_aligned()
+{
+    static const size_t sizes[] = {17, 33, 65, 127, 257};
+
+    printf("\nContiguous vs aligned rows [ns / element for sum, GMAC/s for dot product]\n");
+    printf("%6s %12s %12s %12s %12s\n", "n", "sum", "sum aligned", "dot", "dot aligned");
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const size_t n = sizes[s];
+        double t[2][2];
+
+        for(size_t aligned = 0; aligned < 2; aligned++)
+        {
+            q_matrix_t a = aligned ? q_matrix_square_alloc_aligned(n) : q_matrix_square_alloc(n);
+            q_matrix_t b = aligned ? q_matrix_square_alloc_aligned(n) : q_matrix_square_alloc(n);
+            q_matrix_t c = aligned ? q_matrix_square_alloc_aligned(n) : q_matrix_square_alloc(n);
+            q_matrix_fill_rand_float(&a, -1.0f, 1.0f);
+            q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                q_matrix_sum(&a, &b, &c);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[aligned][0] = (double) elapsed / reps / ((double) n * n);
+
+            reps = 0; start = bench_now_ns();
+            do {
+                q_matrix_dot_product(&a, &b, &c);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[aligned][1] = (double) n * n * n * reps / elapsed;
+
+            q_matrix_free(&a);
+            q_matrix_free(&b);
+            q_matrix_free(&c);
+        }
+
+        printf("%6zu %12.3f %12.3f %12.3f %12.3f\n", n, t[0][0], t[1][0], t[0][1], t[1][1]);
+    }
+}
+
+/**
+ * @brief Factorization and solve of one system with the dense P of q_matrix_PLU_decomposition and with the packed
+ * factorization and permutation vector of q_lu_decompose.
+ */
+void bench_q_matrix_lu()
+{
+    printf("\nPLU decomposition + LUP solve (dense P) vs q_lu_decompose + q_lu_solve [ns]\n");
+    printf("%6s %16s %16s %10s\n", "n", "dense P", "packed LU", "speedup");
+
+    for(size_t n = 8; n <= 256; n <<= 1)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t P = q_matrix_square_alloc(n);
+        q_matrix_t L = q_matrix_square_alloc(n);
+        q_matrix_t U = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_alloc(n, 1);
+        q_matrix_t x = q_matrix_alloc(n, 1);
+        q_lu_t lu = q_lu_alloc(n);
+        fill_well_conditioned(&m, INT_TO_Q(4));
+        q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_matrix_PLU_decomposition(&m, &P, &L, &U);
+            q_matrix_LUP_solve(&L, &U, &P, &b, &x);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        const double t_dense = (double) elapsed / reps;
+
+        reps = 0; start = bench_now_ns();
+        do {
+            q_lu_decompose(&m, &lu);
+            q_lu_solve(&lu, &b, &x);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        const double t_packed = (double) elapsed / reps;
+
+        printf("%6zu %16.0f %16.0f %10.2f\n", n, t_dense, t_packed, t_dense / t_packed);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&P);
+        q_matrix_free(&L);
+        q_matrix_free(&U);
+        q_matrix_free(&b);
+        q_matrix_free(&x);
+    }
+}
+
+/**
+ * @brief Division of the columns of a matrix by their diagonal element (the elimination of a pivot column) with a hardware
+ * division per element and with a prepared divisor per column, and the reciprocal against q_division(Q_ONE, a).
+ */
+void bench_q_matrix_division()
+{
+    printf("\nColumn division by the pivot, q_division vs q_division_prepared, and reciprocals [ns / element]\n");
+    printf("%6s %14s %14s %10s %14s %14s\n", "n", "q_division", "prepared", "speedup", "1 / a div", "q_reciprocal");
+
+    for(size_t n = 16; n <= 256; n <<= 2)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t dst = q_matrix_square_alloc(n);
+        fill_well_conditioned(&m, INT_TO_Q(4));
+        const double elements = (double) n * n;
+        double t[4];
+
+        for(size_t op = 0; op < 4; op++)
+        {
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                for(size_t j = 0; j < n; j++)
+                {
+                    const q_t pivot = Q_MATRIX_AT(&m, j, j);
+                    const q_t* a = &Q_MATRIX_AT(&m, j, 0); // The row j stands for the column below the pivot
+                    q_t* c = &Q_MATRIX_AT(&dst, j, 0);
+                    switch(op)
+                    {
+                        case 0:
+                            for(size_t i = 0; i < n; i++){ c[i] = q_division(a[i], pivot); }
+                            break;
+                        case 1: {
+                            const q_divisor_t d = q_divisor_prepare(pivot);
+                            for(size_t i = 0; i < n; i++){ c[i] = q_division_prepared(a[i], d); }
+                            break;
+                        }
+                        case 2:
+                            for(size_t i = 0; i < n; i++){ c[i] = q_division(Q_ONE, a[i] | 1); }
+                            break;
+                        default:
+                            for(size_t i = 0; i < n; i++){ c[i] = q_reciprocal(a[i] | 1); }
+                            break;
+                    }
+                }
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[op] = (double) elapsed / reps / elements;
+        }
+
+        printf("%6zu %14.3f %14.3f %10.2f %14.3f %14.3f\n", n, t[0], t[1], t[0] / t[1], t[2], t[3]);
+
+        q_matrix_free(&m);
+        q_matrix_free(&dst);
+    }
+}
+
+/**
+ * @brief A^k with k - 1 successive products against q_matrix_power (repeated squaring on the GEMM engine).
+ */
+void bench_q_matrix_power()
+{
+    const uint32_t k = 100;
+
+    printf("\nA^%u, successive products vs q_matrix_power [ns]\n", k);
+    printf("%6s %16s %16s %10s\n", "n", "products", "squaring", "speedup");
+
+    for(size_t n = 8; n <= 128; n <<= 1)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t power = q_matrix_square_alloc(n);
+        q_matrix_t tmp = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&m, -1.0f / n, 1.0f / n);
+
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_matrix_cpy(&m, &power);
+            for(uint32_t i = 1; i < k; i++)
+            {
+                q_matrix_dot_product(&power, &m, &tmp);
+                q_matrix_cpy(&tmp, &power);
+            }
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        const double t_products = (double) elapsed / reps;
+
+        reps = 0; start = bench_now_ns();
+        do {
+            q_matrix_power(&m, k, &power);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        const double t_squaring = (double) elapsed / reps;
+
+        printf("%6zu %16.0f %16.0f %10.2f\n", n, t_products, t_squaring, t_products / t_squaring);
+
+        q_matrix_free(&m);
+        q_matrix_free(&power);
+        q_matrix_free(&tmp);
+    }
+}
+
+/**
+ * @brief Sine and cosine of a column of angles (the rotations of a kinematic chain): q_sin + q_cos, q_sincos, and the float
+ * functions of the C library for reference.
+ */
+void bench_q_matrix_trig()
+{
+    const size_t n = 4096;
+
+    printf("\nSine and cosine of %zu angles in [-8 pi, 8 pi) [ns / angle]\n", n);
+    printf("%14s %14s %14s %14s\n", "q_sin + q_cos", "q_sincos", "q_tan", "sinf + cosf");
+
+    q_matrix_t angles = q_matrix_alloc(n, 1);
+    q_matrix_t s = q_matrix_alloc(n, 1);
+    q_matrix_t c = q_matrix_alloc(n, 1);
+    q_matrix_fill_rand_float(&angles, -8 * 3.14159265f, 8 * 3.14159265f);
+    float* fs = (float*) malloc(n * sizeof(float));
+    float* fc = (float*) malloc(n * sizeof(float));
+    double t[4];
+
+    for(size_t op = 0; op < 4; op++)
+    {
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            for(size_t i = 0; i < n; i++)
+            {
+                const q_t a = Q_MATRIX_AT(&angles, i, 0);
+                switch(op)
+                {
+                    case 0:
+                        Q_MATRIX_AT(&s, i, 0) = q_sin(a);
+                        Q_MATRIX_AT(&c, i, 0) = q_cos(a);
+                        break;
+                    case 1: q_sincos(a, &Q_MATRIX_AT(&s, i, 0), &Q_MATRIX_AT(&c, i, 0)); break;
+                    case 2: Q_MATRIX_AT(&s, i, 0) = q_tan(a); break;
+                    default:
+                        fs[i] = sinf(q_to_float(a));
+                        fc[i] = cosf(q_to_float(a));
+                        break;
+                }
+            }
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        t[op] = (double) elapsed / reps / n;
+    }
+
+    printf("%14.2f %14.2f %14.2f %14.2f\n", t[0], t[1], t[2], t[3]);
+
+    free(fs);
+    free(fc);
+    q_matrix_free(&angles);
+    q_matrix_free(&s);
+    q_matrix_free(&c);
+}
+
+/**
+ * @brief Solve of k right-hand sides against the same factorization, one column at a time and in a single call.
+ */
+void bench_q_matrix_solve_multi()
+{
+    printf("\nq_lu_solve of n x k right-hand sides: per column vs one call [ns]\n");
+    printf("%6s %6s %16s %16s %10s\n", "n", "k", "per column", "one call", "speedup");
+
+    for(size_t n = 16; n <= 256; n <<= 2)
+    {
+        for(size_t k = 4; k <= 256; k <<= 2)
+        {
+            q_matrix_t m = q_matrix_square_alloc(n);
+            q_matrix_t B = q_matrix_alloc(n, k);
+            q_matrix_t X = q_matrix_alloc(n, k);
+            q_matrix_t x = q_matrix_alloc(n, 1);
+            q_lu_t lu = q_lu_alloc(n);
+            fill_well_conditioned(&m, INT_TO_Q(4));
+            q_matrix_fill_rand_float(&B, -1.0f, 1.0f);
+            q_lu_decompose(&m, &lu);
+
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                for(size_t c = 0; c < k; c++)
+                {
+                    q_matrix_t b = q_matrix_view_col(&B, c);
+                    q_lu_solve(&lu, &b, &x);
+                }
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            const double t_column = (double) elapsed / reps;
+
+            reps = 0; start = bench_now_ns();
+            do {
+                q_lu_solve(&lu, &B, &X);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            const double t_multi = (double) elapsed / reps;
+
+            printf("%6zu %6zu %16.0f %16.0f %10.2f\n", n, k, t_column, t_multi, t_column / t_multi);
+
+            q_lu_free(&lu);
+            q_matrix_free(&m);
+            q_matrix_free(&B);
+            q_matrix_free(&X);
+            q_matrix_free(&x);
+        }
+    }
+}
+
+/**
+ * @brief Reference inverse as q_matrix_inverse was implemented before the in place inversion: PLU decomposition, identity
+ * matrix and one LUP solve per column with a slice of the identity and a write back to the destination.
+ */
+static void bench_inverse_reference(const q_matrix_t* m, q_matrix_t* dst)
+{
+    const size_t n = m->rows;
+    q_matrix_t L = q_matrix_square_alloc(n);
+    q_matrix_t U = q_matrix_square_alloc(n);
+    q_matrix_t P = q_matrix_square_alloc(n);
+    q_matrix_t I = q_matrix_square_alloc(n);
+    q_matrix_t X = q_matrix_alloc(n, 1);
+    q_matrix_t b = q_matrix_alloc(n, 1);
+
+    q_matrix_PLU_decomposition(m, &P, &L, &U);
+    q_matrix_identity(&I);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        q_matrix_slice_col(&I, &b, i);
+        q_matrix_LUP_solve(&L, &U, &P, &b, &X);
+        for(size_t j = 0; j < n; j++)
+        {
+            Q_MATRIX_AT(dst, j, i) = Q_MATRIX_AT(&X, j, 0);
+        }
+    }
+
+    q_matrix_free(&b);
+    q_matrix_free(&X);
+    q_matrix_free(&I);
+    q_matrix_free(&P);
+    q_matrix_free(&U);
+    q_matrix_free(&L);
+}
+
+/**
+ * @brief Largest absolute error of A * A^-1 against the identity
+ */
+static double bench_inverse_error(const q_matrix_t* m, const q_matrix_t* inv)
+{
+    const size_t n = m->rows;
+    q_matrix_t prod = q_matrix_square_alloc(n);
+    q_matrix_dot_product(m, inv, &prod);
+
+    double error = 0.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            const double e = fabs(q_to_float(Q_MATRIX_AT(&prod, i, j)) - ((i == j) ? 1.0 : 0.0));
+            error = (e > error) ? e : error;
+        }
+    }
+
+    q_matrix_free(&prod);
+    return error;
+}
+
+/**
+ * @brief q_matrix_inverse (in place inversion of the factors) against the column by column reference
+ */
+void bench_q_matrix_inverse()
+{
+    printf("\nq_matrix_inverse (in place, getri) vs reference (column by column LUP solves)\n");
+    printf("%6s %16s %16s %10s %12s %12s\n", "n", "in place [ns]", "reference [ns]", "speedup", "error", "error ref");
+
+    for(size_t n = 4; n <= 512; n <<= 1)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t inv = q_matrix_square_alloc(n);
+        q_matrix_t inv_ref = q_matrix_square_alloc(n);
+        fill_well_conditioned(&m, INT_TO_Q(4));
+
+        uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+        do {
+            q_matrix_inverse(&m, &inv);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        const double t = (double) elapsed / reps;
+
+        reps = 0; start = bench_now_ns();
+        do {
+            bench_inverse_reference(&m, &inv_ref);
+            reps++;
+            elapsed = bench_now_ns() - start;
+        } while(elapsed < BENCH_MIN_TIME_NS / 4);
+        const double t_ref = (double) elapsed / reps;
+
+        printf("%6zu %16.0f %16.0f %10.2f %12.2e %12.2e\n", n, t, t_ref, t_ref / t, bench_inverse_error(&m, &inv), bench_inverse_error(&m, &inv_ref));
+
+        q_matrix_free(&m);
+        q_matrix_free(&inv);
+        q_matrix_free(&inv_ref);
+    }
+}
+
+/**
+ * @brief Blocked LU factorization for several panel widths against the unblocked elimination (a single panel), and the
+ * default panel width with the trailing updates on all the threads.
+ */
+void bench_q_matrix_lu_blocked()
+{
+    static const size_t blocks[] = {16, 32, 64};
+    const size_t threads = q_thread_get_max_threads();
+
+    printf("\nq_lu_decompose_blocked [ns] (unblocked = single panel, threads = trailing updates on %zu threads)\n", threads);
+    printf("%6s %14s %14s %14s %14s %14s\n", "n", "unblocked", "nb = 16", "nb = 32", "nb = 64", "threads");
+
+    for(size_t n = 64; n <= 1024; n <<= 1)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_lu_t lu = q_lu_alloc(n);
+        fill_well_conditioned(&m, INT_TO_Q(4));
+
+        double t[5];
+        for(size_t v = 0; v < 5; v++)
+        {
+            const size_t block = (v == 0) ? n : (v == 4) ? Q_LU_BLOCK : blocks[v - 1];
+            const size_t max_threads = (v == 4) ? threads : 1;
+
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                q_lu_decompose_blocked(&m, &lu, block, max_threads);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[v] = (double) elapsed / reps;
+        }
+
+        printf("%6zu %14.0f %14.0f %14.0f %14.0f %14.0f\n", n, t[0], t[1], t[2], t[3], t[4]);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+    }
+}
+
+/**
+ * @brief Factorization and solve of one symmetric positive definite system with the LU factorization, the Cholesky
+ * factorization and the LDL^T factorization.
+ */
+void bench_q_matrix_cholesky()
+{
+    printf("\nSPD factorization + solve [ns]: q_lu_decompose vs q_matrix_cholesky vs q_matrix_ldlt\n");
+    printf("%6s %14s %14s %14s %10s %10s\n", "n", "LU", "Cholesky", "LDL^T", "speedup", "speedup");
+
+    for(size_t n = 8; n <= 512; n <<= 1)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t F = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_alloc(n, 1);
+        q_matrix_t x = q_matrix_alloc(n, 1);
+        q_lu_t lu = q_lu_alloc(n);
+
+        // Symmetric with a dominant diagonal (positive definite)
+        q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(&m, j, i) = Q_MATRIX_AT(&m, i, j);
+            }
+            Q_MATRIX_AT(&m, i, i) += INT_TO_Q(n);
+        }
+        q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+
+        double t[3];
+        for(size_t v = 0; v < 3; v++)
+        {
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                if(v == 0)
+                {
+                    q_lu_decompose(&m, &lu);
+                    q_lu_solve(&lu, &b, &x);
+                }
+                else if(v == 1)
+                {
+                    q_matrix_cholesky(&m, &F);
+                    q_matrix_cholesky_solve(&F, &b, &x);
+                }
+                else
+                {
+                    q_matrix_ldlt(&m, &F);
+                    q_matrix_ldlt_solve(&F, &b, &x);
+                }
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[v] = (double) elapsed / reps;
+        }
+
+        printf("%6zu %14.0f %14.0f %14.0f %10.2f %10.2f\n", n, t[0], t[1], t[2], t[0] / t[1], t[0] / t[2]);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&F);
+        q_matrix_free(&b);
+        q_matrix_free(&x);
+    }
+}
+
+/**
+ * @brief Householder QR factorization of tall matrices, unblocked reflections (a single panel) against the compact WY
+ * trailing updates for several panel widths.
+ */
+void bench_q_matrix_qr()
+{
+    static const size_t shapes[][2] = {{256, 32}, {1024, 64}, {2048, 128}, {4096, 64}, {512, 512}};
+    static const size_t blocks[] = {16, 32, 64};
+
+    printf("\nq_qr_decompose_blocked [ns] (unblocked = single panel)\n");
+    printf("%6s %6s %14s %14s %14s %14s\n", "m", "n", "unblocked", "nb = 16", "nb = 32", "nb = 64");
+
+    for(size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        const size_t m = shapes[s][0], n = shapes[s][1];
+        q_matrix_t A = q_matrix_alloc(m, n);
+        q_qr_t qr = q_qr_alloc(m, n);
+        q_matrix_fill_rand_float(&A, -1.0f, 1.0f);
+
+        double t[4];
+        for(size_t v = 0; v < 4; v++)
+        {
+            const size_t block = (v == 0) ? n : blocks[v - 1];
+
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                q_qr_decompose_blocked(&A, &qr, block, 1);
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[v] = (double) elapsed / reps;
+        }
+
+        printf("%6zu %6zu %14.0f %14.0f %14.0f %14.0f\n", m, n, t[0], t[1], t[2], t[3]);
+
+        q_qr_free(&qr);
+        q_matrix_free(&A);
+    }
+}
+
+/**
+ * @brief Eigenvalues of random general matrices with and without the eigenvectors, and eigen decomposition of symmetric
+ * matrices with the Francis QR iterations (Schur form and vectors), the Jacobi rotations, the tridiagonal QR iterations
+ * and the default choice between the last two (the crossover sets Q_EIGEN_JACOBI_MAX).
+ */
+void bench_q_matrix_eigen()
+{
+    printf("\nEigen decomposition [ns]: general (values, values + vectors) and symmetric with vectors (QR Schur, Jacobi, tridiagonal QR, default)\n");
+    printf("%6s %12s %12s %12s %12s %12s %12s %10s\n", "n", "values", "vectors", "sym Schur", "Jacobi", "tridiag QR", "default", "QR/Jacobi");
+
+    static const size_t sizes[] = {4, 6, 8, 12, 16, 24, 32, 48, 64};
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const size_t n = sizes[s];
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t sym = q_matrix_square_alloc(n);
+        q_matrix_t T = q_matrix_square_alloc(n);
+        q_matrix_t Z = q_matrix_square_alloc(n);
+        q_matrix_t values = q_matrix_alloc(n, 2);
+        q_matrix_t diagonal = q_matrix_view_col(&values, 0);
+
+        q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+        q_matrix_cpy(&m, &sym);
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(&sym, j, i) = Q_MATRIX_AT(&sym, i, j);
+            }
+        }
+
+        double t[6];
+        for(size_t v = 0; v < 6; v++)
+        {
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                if(v == 0)
+                {
+                    (void) q_matrix_eigen(&m, &values, NULL);
+                }
+                else if(v == 1)
+                {
+                    (void) q_matrix_eigen(&m, &values, &Z);
+                }
+                else if(v == 2)
+                {
+                    (void) q_matrix_schur(&sym, &T, &Z);
+                }
+                else
+                {
+                    const q_eigen_method_t methods[] = {Q_EIGEN_JACOBI, Q_EIGEN_TRIDIAGONAL_QR, Q_EIGEN_AUTO};
+                    (void) q_matrix_eigen_symmetric_method(&sym, &diagonal, &Z, methods[v - 3]);
+                }
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[v] = (double) elapsed / reps;
+        }
+
+        printf("%6zu %12.0f %12.0f %12.0f %12.0f %12.0f %12.0f %10.2f\n", n, t[0], t[1], t[2], t[3], t[4], t[5], t[4] / t[3]);
+
+        q_matrix_free(&m);
+        q_matrix_free(&sym);
+        q_matrix_free(&T);
+        q_matrix_free(&Z);
+        q_matrix_free(&values);
+    }
+}
+
+/**
+ * @brief Eigen decomposition of batches of symmetric 3x3 matrices: one q_matrix_eigen_symmetric call per matrix against the
+ * batched kernel with the scalar and the AVX2 code. The AVX2 column is n/a and the speedup is the scalar batch one when
+ * the processor has no AVX2.
+ */
+void bench_q_matrix_eigen3()
+{
+    const q_simd_level_t supported = q_simd_detect();
+    const int avx2 = (supported >= Q_SIMD_AVX2); // q_simd_set_level clamps, the AVX2 column is not measured without it
+
+    printf("\nSymmetric 3x3 eigen decomposition [ns per matrix]: q_matrix_eigen_symmetric vs q_matrix_eigen_symmetric3_batch\n");
+    printf("%8s %14s %14s %14s %10s\n", "count", "per matrix", "batch base", "batch AVX2", "speedup");
+
+    static const size_t index[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+
+    for(size_t count = 64; count <= 65536; count <<= 4)
+    {
+        q_matrix_t A = q_matrix_alloc_aligned(6, count);
+        q_matrix_t values = q_matrix_alloc_aligned(3, count);
+        q_matrix_t vectors = q_matrix_alloc_aligned(9, count);
+        q_matrix_t m = q_matrix_square_alloc(3);
+        q_matrix_t d = q_matrix_alloc(3, 1);
+        q_matrix_t V = q_matrix_square_alloc(3);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+        double t[3] = {0};
+        for(size_t v = 0; v < (avx2 ? 3u : 2u); v++)
+        {
+            q_simd_set_level((v == 0) ? supported : ((v == 1) ? Q_SIMD_SCALAR : Q_SIMD_AVX2));
+
+            uint64_t reps = 0, start = bench_now_ns(), elapsed = 0;
+            do {
+                if(v == 0)
+                {
+                    for(size_t c = 0; c < count; c++)
+                    {
+                        for(size_t i = 0; i < 3; i++)
+                        {
+                            for(size_t j = 0; j < 3; j++)
+                            {
+                                Q_MATRIX_AT(&m, i, j) = Q_MATRIX_AT(&A, index[i][j], c);
+                            }
+                        }
+                        (void) q_matrix_eigen_symmetric(&m, &d, &V);
+                    }
+                }
+                else
+                {
+                    q_matrix_eigen_symmetric3_batch(&A, &values, &vectors);
+                }
+                reps++;
+                elapsed = bench_now_ns() - start;
+            } while(elapsed < BENCH_MIN_TIME_NS / 4);
+            t[v] = (double) elapsed / reps / count;
+        }
+
+        if(avx2)
+        {
+            printf("%8zu %14.1f %14.1f %14.1f %10.2f\n", count, t[0], t[1], t[2], t[0] / t[2]);
+        }
+        else
+        {
+            printf("%8zu %14.1f %14.1f %14s %10.2f\n", count, t[0], t[1], "n/a", t[0] / t[1]);
+        }
+
+        q_matrix_free(&A);
+        q_matrix_free(&values);
+        q_matrix_free(&vectors);
+        q_matrix_free(&m);
+        q_matrix_free(&d);
+        q_matrix_free(&V);
+    }
+
+    q_simd_set_level(supported);
+}
+
+void bench_q_matrix()
+{
+    bench_q_matrix_PLU_decomposition();
+    bench_q_matrix_lu();
+    bench_q_matrix_lu_blocked();
+    bench_q_matrix_cholesky();
+    bench_q_matrix_qr();
+    bench_q_matrix_eigen();
+    bench_q_matrix_eigen3();
+    bench_q_matrix_solve_multi();
+    bench_q_matrix_division();
+    bench_q_matrix_power();
+    bench_q_matrix_trig();
+    bench_q_matrix_inverse();
+    bench_q_matrix_dot_product();
+    bench_q_matrix_dot_product_threads();
+    bench_q_matrix_elementwise();
+    bench_q_matrix_aligned();
+    bench_q_matrix_inline_core();
+    bench_q_matrix_q7_dot_product();
+}
@@ -0,0 +1,26 @@
+#ifndef BENCH_Q_MATRIX_H
+#define BENCH_Q_MATRIX_H
+#include "../include/fix_point_matrix.h"
+
+void bench_q_matrix_PLU_decomposition();
+void bench_q_matrix_lu();
+void bench_q_matrix_lu_blocked();
+void bench_q_matrix_cholesky();
+void bench_q_matrix_qr();
+void bench_q_matrix_eigen();
+void bench_q_matrix_eigen3();
+void bench_q_matrix_solve_multi();
+void bench_q_matrix_division();
+void bench_q_matrix_power();
+void bench_q_matrix_trig();
+void bench_q_matrix_inverse();
+void bench_q_matrix_dot_product();
+void bench_q_matrix_dot_product_threads();
+void bench_q_matrix_elementwise();
+void bench_q_matrix_aligned();
+void bench_q_matrix_inline_core();
+void bench_q_matrix_q7_dot_product();
+
+void bench_q_matrix();
+
+#endif // BENCH_Q_MATRIX_H
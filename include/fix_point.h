@@ -43,22 +43,51 @@
 #error "Q_FORMAT must be greater than 0"
 #endif
 
+// Accumulation mode of the inner products (dot products and substitutions)
+// 1 => The full products are summed in a wide accumulator (q_acc_t) and rescaled and saturated once at the end
+// 0 => Every product is shifted back to q_t before it is summed (legacy behaviour)
+#ifndef Q_ACCUMULATE_WIDE
+#define Q_ACCUMULATE_WIDE 1
+#endif // Q_ACCUMULATE_WIDE
+
 // Check which of the following Q_FORMAT is defined
+// q_long_t holds a single product, q_acc_t holds a sum of products without overflow, q_unsigned_t has the width of q_t
+// for the arithmetic that wraps around
 #if     Q_FORMAT == Q_FORMAT_7
 typedef int8_t q7_t; 
 typedef int16_t q_long_t;
+typedef int32_t q_acc_t;
+#define Q_LONG_MAX INT16_MAX
 typedef q7_t q_t;
+typedef uint8_t q_unsigned_t;
+#define Q_RAW_MAX INT8_MAX
+#define Q_RAW_MIN INT8_MIN
 #elif   Q_FORMAT == Q_FORMAT_15
 typedef int16_t q15_t;
 typedef int32_t q_long_t;
+typedef int64_t q_acc_t;
+#define Q_LONG_MAX INT32_MAX
 typedef q15_t q_t;
+typedef uint16_t q_unsigned_t;
+#define Q_RAW_MAX INT16_MAX
+#define Q_RAW_MIN INT16_MIN
 #elif   Q_FORMAT == Q_FORMAT_31
 typedef int32_t q31_t;
 typedef int64_t q_long_t; 
+__extension__ typedef __int128 q_acc_t;
+#define Q_LONG_MAX INT64_MAX
 typedef q31_t q_t;
+typedef uint32_t q_unsigned_t;
+#define Q_RAW_MAX INT32_MAX
+#define Q_RAW_MIN INT32_MIN
 #elif   Q_FORMAT == Q_FORMAT_CUSTOM
 typedef int32_t q_t;
+typedef uint32_t q_unsigned_t;
 typedef int64_t q_long_t;
+__extension__ typedef __int128 q_acc_t;
+#define Q_LONG_MAX INT64_MAX
+#define Q_RAW_MAX INT32_MAX
+#define Q_RAW_MIN INT32_MIN
 #else
 #error "Q_FORMAT not supported"
 #endif
@@ -81,23 +110,32 @@ typedef int64_t q_long_t;
 #define Q_MIN_FLOAT  (q_to_float((1 << Q_FORM_INT_BITS - 1)))     // Minimum float value
 #define Q_RESOLUTION (q_to_float(1))
 
-#define Q_MINUS_ONE      INT_TO_Q(-1) // Qm.n representation of -1
-#define Q_MINUS_ONE_HALF (float_to_q(-0.5f)) // Qm.n representation of -0.5
+// The constants are stored as integer literals in Q3.60 and rounded to the active format by the preprocessor.
+// Therefore they are integer constant expressions (usable in static initializers and switch cases) without precision loss
+#if FRACTIONAL_BITS > 59
+#error "The Q constants support at most 59 fractional bits"
+#endif
+
+#define Q_FROM_Q60(__R__) ((q_t)(((__R__) + (1LL << (59 - FRACTIONAL_BITS))) >> (60 - FRACTIONAL_BITS))) // Round Q3.60 to Qm.n
+
 #define Q_ZERO           0 // Qm.n representation of 0
-#define Q_ONE_HALF       (float_to_q(0.5f)) // Qm.n representation of 0.5
 #define Q_ONE            INT_TO_Q(1) // Qm.n representation of 1
 #define Q_TWO            INT_TO_Q(2) // Qm.n representation of 2
+#define Q_ONE_HALF       Q_FROM_Q60(0x0800000000000000LL) // Qm.n representation of 0.5
+#define Q_MINUS_ONE      ((q_t) -(1LL << FRACTIONAL_BITS)) // Qm.n representation of -1
+#define Q_MINUS_ONE_HALF ((q_t) -Q_ONE_HALF) // Qm.n representation of -0.5
 
-#define Q_NEG_HALF_PI   float_to_q(-1.57079632679489661923f) // Qm.n representation of -pi/2
-#define Q_NEG_PI        float_to_q(-3.14159265358979323846f) // Qm.n representation of -pi
-#define Q_PI            float_to_q(3.14159265358979323846f)  // Qm.n representation of pi
-#define Q_TWO_PI        float_to_q(6.28318530717958647692f)  // Qm.n representation of 2pi
+#define Q_PI            Q_FROM_Q60(0x3243F6A8885A308DLL) // Qm.n representation of pi
+#define Q_TWO_PI        Q_FROM_Q60(0x6487ED5110B4611ALL) // Qm.n representation of 2pi
 #define Q_TAU           Q_TWO_PI // Qm.n representation of tau
-#define Q_HALF_PI       float_to_q(1.57079632679489661923f) // Qm.n representation of pi/2
-#define Q_QUARTER_PI    float_to_q(0.78539816339744830962f) // Qm.n representation of pi/4
-#define Q_THIRD_PI      float_to_q(1.04719755119659774615f) // Qm.n representation of pi/3
-#define Q_SIXTH_PI      float_to_q(0.52359877559829887308f) // Qm.n representation of pi/6
-#define Q_E             float_to_q(2.71828182845904523536f) // Qm.n representation of Euler's number
+#define Q_HALF_PI       Q_FROM_Q60(0x1921FB54442D1847LL) // Qm.n representation of pi/2
+#define Q_QUARTER_PI    Q_FROM_Q60(0x0C90FDAA22168C23LL) // Qm.n representation of pi/4
+#define Q_THIRD_PI      Q_FROM_Q60(0x10C152382D736584LL) // Qm.n representation of pi/3
+#define Q_SIXTH_PI      Q_FROM_Q60(0x0860A91C16B9B2C2LL) // Qm.n representation of pi/6
+#define Q_E             Q_FROM_Q60(0x2B7E151628AED2A7LL) // Qm.n representation of Euler's number
+#define Q_NEG_HALF_PI   ((q_t) -Q_HALF_PI) // Qm.n representation of -pi/2
+#define Q_NEG_PI        ((q_t) -Q_PI) // Qm.n representation of -pi
+#define Q_MILLI         Q_FROM_Q60(0x0004189374BC6A7FLL) // Qm.n representation of 0.001
 
 #define Q_SIGN_BIT(__Q__)   (((__Q__) >> (Q_FORM_INT_BITS - 1)) & 1) // Get the sign bit of the Qm.n number
 #define Q_SIGN(__Q__)       (Q_SIGN_BIT(__Q__) == Q_ONE ? Q_ONE : Q_MINUS_ONE) // Get the sign of the Qm.n number
@@ -111,8 +149,26 @@ typedef int64_t q_long_t;
 #define PRINT_MAX_FLOAT   printf("Q_MAX_FLOAT = %f\n", q_to_float(Q_MAX_FLOAT)) // Print the maximum float value
 #define PRINT_MIN_FLOAT   printf("Q_MIN_FLOAT = %f\n", q_to_float(Q_MIN_FLOAT)) // Print the minimum float value
 
-q_t float_to_q(float x);
-float q_to_float(q_t x);
+/**
+ * @brief This function converts a floating number to a fixed point number
+ * 
+ * @param x The floating number to be converted
+ * @return q_t The fixed point number representation of the floating number
+ */
+static inline q_t float_to_q(float x) {
+    return (q_t) (x * (1 << FRACTIONAL_BITS));
+}
+
+/**
+ * @brief This function converts a fixed point number to a floating number
+ * 
+ * @param x The fixed point number to be converted
+ * @return float The floating number representation of the fixed point number
+ */
+static inline float q_to_float(q_t x) {
+    return ((float) x) / (1 << FRACTIONAL_BITS);
+}
+
 void q_print(q_t x, char* var_name);
 
 #endif // FIX_POINT_H
@@ -0,0 +1,42 @@
+#ifndef FIX_POINT_ARENA_H
+#define FIX_POINT_ARENA_H
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "fix_point_matrix.h"
+
+// Per-thread workspace for the temporaries of the solvers. Every thread owns a bump allocator made of a chain of blocks,
+// the memory is taken back with q_arena_release and the blocks are kept for the next calls, so the steady state does not
+// touch the heap.
+
+// Minimum size in bytes of a block of the arena
+#ifndef Q_ARENA_BLOCK_BYTES
+#define Q_ARENA_BLOCK_BYTES (64 * 1024)
+#endif // Q_ARENA_BLOCK_BYTES
+
+// Alignment in bytes of every allocation of the arena
+#ifndef Q_ARENA_ALIGNMENT
+#define Q_ARENA_ALIGNMENT Q_MATRIX_ALIGNMENT
+#endif // Q_ARENA_ALIGNMENT
+
+struct arena_block_t;
+
+// Position of the arena of the calling thread, everything allocated after it is taken back by q_arena_release
+struct arena_mark_t {
+    struct arena_block_t* block;
+    size_t used;
+};
+typedef struct arena_mark_t q_arena_mark_t;
+
+q_arena_mark_t q_arena_mark(void);
+void q_arena_release(q_arena_mark_t mark);
+void* q_arena_alloc(size_t bytes);
+q_matrix_t q_arena_matrix_alloc(size_t rows, size_t cols);
+void q_arena_free(void);
+
+// Heap allocation counter of the calling thread (matrices, arena blocks and GEMM buffers)
+
+size_t q_arena_heap_allocations(void);
+void q_arena_count_heap_allocation(void);
+
+#endif // FIX_POINT_ARENA_H
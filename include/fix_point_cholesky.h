@@ -0,0 +1,31 @@
+#ifndef FIX_POINT_CHOLESKY_H
+#define FIX_POINT_CHOLESKY_H
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "fix_point_matrix.h"
+
+// Factorizations of symmetric positive definite matrices (covariance matrices, normal equations). Only the lower triangle
+// of the input is read and only the lower triangle of the factors is written, the upper triangles are never touched:
+// - Cholesky: A = L * L^T, L is lower triangular with a positive diagonal
+// - LDL^T:    A = L * D * L^T, L is unit lower triangular (stored below the diagonal) and D is stored on the diagonal. It
+//             does not need the square roots of the Cholesky factorization.
+
+// Panel width of the blocked factorizations, the matrices up to this size are factorized without blocking
+#ifndef Q_CHOLESKY_BLOCK
+#define Q_CHOLESKY_BLOCK 64
+#endif // Q_CHOLESKY_BLOCK
+
+void q_matrix_cholesky(const q_matrix_t* m, q_matrix_t* L);
+void q_matrix_cholesky_blocked(const q_matrix_t* m, q_matrix_t* L, size_t block, size_t max_threads);
+void q_matrix_cholesky_solve(const q_matrix_t* L, const q_matrix_t* b, q_matrix_t* x);
+q_t q_matrix_cholesky_determinant(const q_matrix_t* L);
+void q_matrix_cholesky_inverse(const q_matrix_t* L, q_matrix_t* dst);
+
+void q_matrix_ldlt(const q_matrix_t* m, q_matrix_t* LD);
+void q_matrix_ldlt_blocked(const q_matrix_t* m, q_matrix_t* LD, size_t block, size_t max_threads);
+void q_matrix_ldlt_solve(const q_matrix_t* LD, const q_matrix_t* b, q_matrix_t* x);
+q_t q_matrix_ldlt_determinant(const q_matrix_t* LD);
+void q_matrix_ldlt_inverse(const q_matrix_t* LD, q_matrix_t* dst);
+
+#endif // FIX_POINT_CHOLESKY_H
@@ -0,0 +1,86 @@
+#ifndef FIX_POINT_EIGEN_H
+#define FIX_POINT_EIGEN_H
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "fix_point_matrix.h"
+
+// Eigenvalues and eigenvectors of real square matrices:
+// - General matrices: reduction to upper Hessenberg form with Householder reflectors, then Francis implicit double-shift
+//   QR iterations with deflation give the real Schur form A = Z * T * Z^T. T is quasi upper triangular, a real eigenvalue
+//   is a 1x1 block of the diagonal and a complex conjugate pair a 2x2 block. The eigenvectors are computed from T by back
+//   substitution and multiplied by Z.
+// - Symmetric matrices: cyclic Jacobi rotations for the small ones, Householder tridiagonalization and QR steps with the
+//   Wilkinson shift for the larger ones. The eigenvalues are real and the eigenvectors orthonormal.
+// - Batches of symmetric 3x3 matrices (inertia tensors, covariances): a fixed number of Jacobi sweeps on a structure of
+//   arrays, several matrices per vector register.
+// The matrix is scaled by a power of two before the iterations so its largest element uses the same number of integer bits
+// whatever the input, the eigenvalues are scaled back at the end.
+//
+// Output formats:
+// - Eigenvalues: n x 2 matrix, the row i holds (re, im) of the i-th eigenvalue. The eigenvalues are sorted by decreasing
+//   real part, the two eigenvalues of a complex conjugate pair are stored in consecutive rows, positive imaginary part first.
+// - Eigenvectors: n x n matrix, the column j belongs to the row j of the eigenvalues and has a unit 2-norm. A real
+//   eigenvalue has a real eigenvector. For a complex pair in the rows j and j + 1, v = col(j) + i * col(j + 1) is the
+//   eigenvector of the row j and its conjugate col(j) - i * col(j + 1) the eigenvector of the row j + 1.
+
+// Average number of QR iterations allowed per eigenvalue before the iteration is reported as not converged
+#ifndef Q_EIGEN_MAX_ITERATIONS
+#define Q_EIGEN_MAX_ITERATIONS 30
+#endif // Q_EIGEN_MAX_ITERATIONS
+
+// Largest symmetric matrix diagonalized with Jacobi rotations by default, the larger ones are reduced to tridiagonal form.
+// The tridiagonal QR iterations are faster from 5 or 6 rows with the vectors (bench_q_matrix_eigen)
+#ifndef Q_EIGEN_JACOBI_MAX
+#define Q_EIGEN_JACOBI_MAX 4
+#endif // Q_EIGEN_JACOBI_MAX
+
+// Number of Jacobi sweeps (rotations of every off-diagonal pair) allowed for the symmetric matrices
+#ifndef Q_EIGEN_MAX_SWEEPS
+#define Q_EIGEN_MAX_SWEEPS 30
+#endif // Q_EIGEN_MAX_SWEEPS
+
+// A subdiagonal element of the QR iterations is zero when it is not larger than the Frobenius norm of the scaled matrix times
+// 2^-Q_EIGEN_PRECISION, nor than Q_EIGEN_TOLERANCE raw units: every QR step rounds the whole matrix, the subdiagonal of a
+// converged eigenvalue that is not at the bottom stalls at that rounding noise. The off-diagonal elements of the Jacobi
+// rotations go down to Q_EIGEN_TOLERANCE raw units.
+#ifndef Q_EIGEN_PRECISION
+#define Q_EIGEN_PRECISION 15
+#endif // Q_EIGEN_PRECISION
+
+#ifndef Q_EIGEN_TOLERANCE
+#define Q_EIGEN_TOLERANCE 4
+#endif // Q_EIGEN_TOLERANCE
+
+// Integer bits left free above the largest element of the scaled matrix for the growth of the eigenvalues and the sums
+#ifndef Q_EIGEN_HEADROOM
+#define Q_EIGEN_HEADROOM 12
+#endif // Q_EIGEN_HEADROOM
+
+// Jacobi sweeps of the batched 3x3 symmetric kernel, every sweep rotates the pairs (0, 1), (0, 2) and (1, 2). The
+// convergence is quadratic: three sweeps reach the rounding on random matrices, the fourth one leaves margin.
+#ifndef Q_EIGEN3_SWEEPS
+#define Q_EIGEN3_SWEEPS 4
+#endif // Q_EIGEN3_SWEEPS
+
+// Matrices processed together by the batched 3x3 kernel. Every step of the kernel is a loop over the block which the
+// compiler vectorizes, the block must be long enough not to be unrolled instead and short enough to stay in the L1 cache.
+#ifndef Q_EIGEN3_BLOCK
+#define Q_EIGEN3_BLOCK 64
+#endif // Q_EIGEN3_BLOCK
+
+enum eigen_method_t {
+    Q_EIGEN_AUTO           = 0, // Jacobi up to Q_EIGEN_JACOBI_MAX rows, tridiagonal QR above
+    Q_EIGEN_JACOBI         = 1, // Cyclic Jacobi rotations
+    Q_EIGEN_TRIDIAGONAL_QR = 2  // Householder tridiagonalization and shifted symmetric QR steps
+};
+typedef enum eigen_method_t q_eigen_method_t;
+
+void q_matrix_hessenberg(const q_matrix_t* m, q_matrix_t* H, q_matrix_t* Q);
+q_status_t q_matrix_schur(const q_matrix_t* m, q_matrix_t* T, q_matrix_t* Z);
+q_status_t q_matrix_eigen(const q_matrix_t* m, q_matrix_t* values, q_matrix_t* vectors);
+q_status_t q_matrix_eigen_symmetric(const q_matrix_t* m, q_matrix_t* values, q_matrix_t* vectors);
+q_status_t q_matrix_eigen_symmetric_method(const q_matrix_t* m, q_matrix_t* values, q_matrix_t* vectors, q_eigen_method_t method);
+void q_matrix_eigen_symmetric3_batch(const q_matrix_t* A, q_matrix_t* values, q_matrix_t* vectors);
+
+#endif // FIX_POINT_EIGEN_H
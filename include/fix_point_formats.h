@@ -0,0 +1,96 @@
+#ifndef FIX_POINT_FORMATS_H
+#define FIX_POINT_FORMATS_H
+#include <stdint.h>
+#include "fix_point.h"
+
+// Typed Q format families that can be used side-by-side with the active Q_FORMAT (q_t) in the same binary.
+// Every family is generated from Q_DECLARE_FORMAT, the arithmetic saturates to the range of the family.
+
+/**
+ * @brief Moves the radix point of a raw Q value from one number of fractional bits to another (truncating towards -inf)
+ *
+ * @param x The raw value
+ * @param from The number of fractional bits of x
+ * @param to The number of fractional bits of the result
+ * @return int64_t The raw value with the new number of fractional bits
+ */
+static inline int64_t q_format_rescale(int64_t x, int32_t from, int32_t to)
+{
+    return (to >= from) ? x * ((int64_t) 1 << (to - from)) : x >> (from - to);
+}
+
+/**
+ * @brief Declares a Qm.n family with its own type and arithmetic
+ * @details Generates the types NAME_t (storage) and NAME_long_t (single product) and the functions
+ * NAME_saturate, NAME_from_int, NAME_to_int, NAME_from_float, NAME_to_float, NAME_from_q, NAME_to_q, NAME_add, NAME_sub,
+ * NAME_product, NAME_division and NAME_absolute. The constants NAME_FRACTIONAL_BITS, NAME_ONE, NAME_MAX and NAME_MIN are
+ * also declared.
+ *
+ * @example
+ * Q_DECLARE_FORMAT(q8_24, int32_t, int64_t, 24, INT32_MIN, INT32_MAX) // Q8.24 family
+ * q8_24_t x = q8_24_from_float(1.5f);
+ * q8_24_t y = q8_24_product(x, x);
+ * q15_t z = Q_CONVERT(q8_24, q15, x); // Saturates to the Q15 range
+ */
+#define Q_DECLARE_FORMAT(NAME, TYPE, LONG_TYPE, FRAC, MIN, MAX) \
+typedef TYPE NAME##_t; \
+typedef LONG_TYPE NAME##_long_t; \
+enum { \
+    NAME##_FRACTIONAL_BITS = (FRAC), \
+    NAME##_MAX = (MAX), \
+    NAME##_MIN = (MIN), \
+    NAME##_ONE = ((FRAC) < (int32_t) (sizeof(TYPE) * 8 - 1)) ? (int32_t) ((int64_t) 1 << (FRAC)) : (MAX) /* 1 or the closest value */ \
+}; \
+static inline NAME##_t NAME##_saturate(int64_t x) { \
+    return (x > (MAX)) ? (MAX) : ((x < (MIN)) ? (MIN) : (NAME##_t) x); \
+} \
+static inline NAME##_t NAME##_from_int(int32_t x) { \
+    return NAME##_saturate(q_format_rescale(x, 0, (FRAC))); \
+} \
+static inline int32_t NAME##_to_int(NAME##_t x) { \
+    return (int32_t) (x >> (FRAC)); \
+} \
+static inline NAME##_t NAME##_from_float(float x) { \
+    const double scaled = (double) x * (double) ((int64_t) 1 << (FRAC)); \
+    return (scaled >= (double) (MAX)) ? (MAX) : ((scaled <= (double) (MIN)) ? (MIN) : (NAME##_t) scaled); \
+} \
+static inline float NAME##_to_float(NAME##_t x) { \
+    return (float) ((double) x / (double) ((int64_t) 1 << (FRAC))); \
+} \
+static inline NAME##_t NAME##_from_q(q_t x) { \
+    return NAME##_saturate(q_format_rescale(x, FRACTIONAL_BITS, (FRAC))); \
+} \
+static inline q_t NAME##_to_q(NAME##_t x) { \
+    const int64_t r = q_format_rescale(x, (FRAC), FRACTIONAL_BITS); \
+    return (r > Q_RAW_MAX) ? Q_RAW_MAX : ((r < Q_RAW_MIN) ? Q_RAW_MIN : (q_t) r); \
+} \
+static inline NAME##_t NAME##_add(NAME##_t a, NAME##_t b) { \
+    return NAME##_saturate((int64_t) a + b); \
+} \
+static inline NAME##_t NAME##_sub(NAME##_t a, NAME##_t b) { \
+    return NAME##_saturate((int64_t) a - b); \
+} \
+static inline NAME##_t NAME##_product(NAME##_t a, NAME##_t b) { \
+    return NAME##_saturate(((NAME##_long_t) a * b) >> (FRAC)); \
+} \
+static inline NAME##_t NAME##_division(NAME##_t a, NAME##_t b) { /* Saturates to the sign of a when b is zero */ \
+    if(b == 0) { \
+        return (a < 0) ? (MIN) : (MAX); \
+    } \
+    return NAME##_saturate(((NAME##_long_t) a * ((NAME##_long_t) 1 << (FRAC))) / b); \
+} \
+static inline NAME##_t NAME##_absolute(NAME##_t a) { \
+    return (a == (MIN)) ? (MAX) : ((a < 0) ? (NAME##_t) -a : a); \
+}
+
+/**
+ * @brief Converts a raw value between two families declared with Q_DECLARE_FORMAT, saturating to the destination range
+ */
+#define Q_CONVERT(FROM, TO, x) TO##_saturate(q_format_rescale((FROM##_t) (x), FROM##_FRACTIONAL_BITS, TO##_FRACTIONAL_BITS))
+
+Q_DECLARE_FORMAT(q7, int8_t, int16_t, 7, INT8_MIN, INT8_MAX)          // Q0.7
+Q_DECLARE_FORMAT(q15, int16_t, int32_t, 15, INT16_MIN, INT16_MAX)     // Q0.15
+Q_DECLARE_FORMAT(q31, int32_t, int64_t, 31, INT32_MIN, INT32_MAX)     // Q0.31
+Q_DECLARE_FORMAT(q16_16, int32_t, int64_t, 16, INT32_MIN, INT32_MAX)  // Q15.16 (sign + 15 integer bits)
+
+#endif // FIX_POINT_FORMATS_H
@@ -0,0 +1,61 @@
+#ifndef FIX_POINT_GEMM_H
+#define FIX_POINT_GEMM_H
+#include <stdlib.h>
+#include <string.h>
+#include "fix_point_matrix.h"
+#include "fix_point_thread.h"
+
+// Register blocking of the micro-kernel (MR rows of A by NR columns of B are kept in registers)
+#ifndef Q_GEMM_MR
+#define Q_GEMM_MR 4
+#endif // Q_GEMM_MR
+
+#ifndef Q_GEMM_NR
+#define Q_GEMM_NR 4
+#endif // Q_GEMM_NR
+
+// Cache blocking targets in bytes, the slivers of a depth slice are sized for the L1 cache, the packed panel of A for the
+// L2 cache and the packed panel of B for the L3 cache
+#ifndef Q_GEMM_L1_BYTES
+#define Q_GEMM_L1_BYTES (32 * 1024)
+#endif // Q_GEMM_L1_BYTES
+
+#ifndef Q_GEMM_L2_BYTES
+#define Q_GEMM_L2_BYTES (256 * 1024)
+#endif // Q_GEMM_L2_BYTES
+
+#ifndef Q_GEMM_L3_BYTES
+#define Q_GEMM_L3_BYTES (2 * 1024 * 1024)
+#endif // Q_GEMM_L3_BYTES
+
+// Products with less multiply-accumulate operations than this are computed directly without packing
+#ifndef Q_GEMM_SMALL_OPS
+#define Q_GEMM_SMALL_OPS (16 * 16 * 16)
+#endif // Q_GEMM_SMALL_OPS
+
+// Products with at least this many multiply-accumulate operations are split over the threads of the pool
+#ifndef Q_GEMM_PARALLEL_OPS
+#define Q_GEMM_PARALLEL_OPS (128 * 128 * 128)
+#endif // Q_GEMM_PARALLEL_OPS
+
+// Target number of tiles per thread of a panel of B, so the threads that finish early can steal work
+#ifndef Q_GEMM_TASKS_PER_THREAD
+#define Q_GEMM_TASKS_PER_THREAD 4
+#endif // Q_GEMM_TASKS_PER_THREAD
+
+// Narrowest column tile of a task, so the packed rows of A are reused over enough columns
+#ifndef Q_GEMM_PARALLEL_MIN_NC
+#define Q_GEMM_PARALLEL_MIN_NC 64
+#endif // Q_GEMM_PARALLEL_MIN_NC
+
+enum gemm_mode_t {
+    Q_GEMM_OVERWRITE = 0, // C = A * B
+    Q_GEMM_ADD       = 1, // C = C + A * B
+    Q_GEMM_SUBTRACT  = 2  // C = C - A * B
+};
+typedef enum gemm_mode_t q_gemm_mode_t;
+
+void q_gemm(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* c, q_gemm_mode_t mode);
+void q_gemm_parallel(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* c, q_gemm_mode_t mode, size_t max_threads);
+
+#endif // FIX_POINT_GEMM_H
@@ -0,0 +1,42 @@
+#ifndef FIX_POINT_LU_H
+#define FIX_POINT_LU_H
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "fix_point_matrix.h"
+
+// Reusable LU factorization with partial pivoting, A = P * L * U. L and U are packed in a single n x n matrix (the unit
+// diagonal of L is implied) and the permutation is kept as a vector of row indices: the i-th row of LU comes from the row
+// perm[i] of A. q_lu_decompose runs on the calling thread, q_lu_decompose_blocked can split the trailing updates over
+// the thread pool.
+
+// Panel width of the blocked factorization, the matrices up to this size are factorized without blocking
+#ifndef Q_LU_BLOCK
+#define Q_LU_BLOCK 64
+#endif // Q_LU_BLOCK
+
+#define Q_LU_ASSERT(lu) {\
+    assert(((lu) != NULL) && "LU factorization is NULL");\
+    Q_MATRIX_ASSERT(&(lu)->LU);\
+    assert(((lu)->perm != NULL) && "LU permutation is NULL");\
+}
+
+struct lu_t {
+    q_matrix_t LU; // L below the diagonal, U on and above the diagonal
+    size_t* perm;  // Original row of every row of LU
+    int parity;    // Sign of the permutation, 1 or -1
+};
+typedef struct lu_t q_lu_t;
+
+q_lu_t q_lu_alloc(size_t n);
+q_lu_t q_lu_arena_alloc(size_t n);
+void q_lu_free(q_lu_t* lu);
+
+void q_lu_decompose(const q_matrix_t* m, q_lu_t* lu);
+void q_lu_decompose_blocked(const q_matrix_t* m, q_lu_t* lu, size_t block, size_t max_threads);
+void q_lu_solve(const q_lu_t* lu, const q_matrix_t* b, q_matrix_t* x);
+q_t q_lu_determinant(const q_lu_t* lu);
+void q_lu_inverse(const q_lu_t* lu, q_matrix_t* dst);
+void q_lu_inverse_in_place(q_lu_t* lu);
+
+#endif // FIX_POINT_LU_H
@@ -3,17 +3,146 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "fix_point.h"
+#include "fix_point_formats.h"
+
+// The arithmetic core is defined in the header so every kernel can inline it
+
+/**
+ * @brief This functions multiplies two fixed point numbers (a*b)
+ * 
+ * @param a The first fixed point number
+ * @param b The second fixed point number
+ * @return q_t The result of the multiplication
+ */
+static inline q_t q_product(q_t a, q_t b) {
+    /*
+        In order to perform the multiplication we need to upscale one of the fix point number in order to allow for the overflow
+        that may occur during the multiplication. Then downscale the result to the original format.
+    */
+    return ((q_long_t) a * b) >> FRACTIONAL_BITS;
+}
+
+/**
+ * @brief This function divides two fixed point numbers (a/b)
+ * 
+ * @param a The numerator of the division
+ * @param b The denominator of the division
+ * @return q_t The result of the division
+ */
+static inline q_t q_division(q_t a, q_t b) {
+    /*
+        In order to perform the division we need to upscale the numerator in order to allow for the overflow that occurs when
+        performing the fractional bit shift.
+    */
+    return (((q_long_t) (a) << FRACTIONAL_BITS) / b);
+}
+
+/**
+ * @brief This function returns the absolute value of a fixed point number
+ * 
+ * @param a The fixed point number to get the absolute value of
+ * @return q_t The absolute value of the fixed point number
+ */
+static inline q_t q_absolute(q_t a){
+    q_t mask = a >> (Q_FORM_INT_BITS - 1); // mask = 0xFFFFFFFF if a is negative, 0x00000000 otherwise
+    // if a is negative, return -a, otherwise return a
+    return (a ^ mask) - mask; 
+}
+
+// Rounding of the rescaled products
+enum round_t {
+    Q_ROUND_DOWN    = 0, // Toward minus infinity, the arithmetic shift of q_product
+    Q_ROUND_NEAREST = 1  // To the nearest, the halves toward plus infinity
+};
+typedef enum round_t q_round_t;
 
-q_t q_product(q_t a, q_t b);
-q_t q_division(q_t a, q_t b);
 q_t q_int_power(q_t a, int32_t n);
-q_t q_absolute(q_t a);
+q_t q_int_power_round(q_t a, int32_t n, q_round_t round);
 q_t q_sqrt(q_t a);
+q_t q_rsqrt(q_t a);
+q_t q_reciprocal(q_t a);
+
+// Trigonometric functions: the angle is reduced to a phase of 2^32 units per turn, the sine and cosine are interpolated in
+// a quarter-wave table of sin(x) in Q2.30 (lib/table/fix_point_sin_table.h, 2^Q_TRIG_TABLE_BITS intervals, see make table).
+// With the default 256 intervals the linear interpolation is within 4.7e-6 of sin(x) and the quadratic one within 2e-8.
+#define Q_TRIG_LINEAR    1 // y0 + t * (y1 - y0)
+#define Q_TRIG_QUADRATIC 2 // Newton form through three entries, y0 + t * (y1 - y0) + t * (t - 1) / 2 * (y2 - 2 * y1 + y0)
+
+// The linear interpolation is below the resolution of the formats with up to 16 fractional bits
+#ifndef Q_TRIG_INTERPOLATION
+#if FRACTIONAL_BITS > 16
+#define Q_TRIG_INTERPOLATION Q_TRIG_QUADRATIC
+#else
+#define Q_TRIG_INTERPOLATION Q_TRIG_LINEAR
+#endif
+#endif // Q_TRIG_INTERPOLATION
 
 q_t q_sin(q_t a);
 q_t q_cos(q_t a);
+void q_sincos(q_t a, q_t* sin, q_t* cos);
 q_t q_tan(q_t a); 
 
 q_t q_rand(q_t min, q_t max);
 
+/**
+ * @brief Saturates a wide accumulator to the range of q_t
+ * 
+ * @param acc The accumulated value (already in the Q format)
+ * @return q_t The saturated value
+ */
+static inline q_t q_saturate(q_acc_t acc)
+{
+    return (acc > Q_RAW_MAX) ? Q_RAW_MAX : ((acc < Q_RAW_MIN) ? Q_RAW_MIN : (q_t) acc);
+}
+
+// Wide accumulation of inner products: acc = Q_ACC_FROM_Q(c); acc += Q_ACC_TERM(a, b) ...; c = Q_ACC_TO_Q(acc)
+#if Q_ACCUMULATE_WIDE
+#define Q_ACC_TERM(__A__, __B__) ((q_acc_t) ((q_long_t) (__A__) * (__B__)))          // Full product, not rescaled
+#define Q_ACC_FROM_Q(__Q__)      ((q_acc_t) (__Q__) * ((q_acc_t) 1 << FRACTIONAL_BITS)) // Upscale a Q number to the scale of the products
+#define Q_ACC_TO_Q(__ACC__)      q_saturate((__ACC__) >> FRACTIONAL_BITS)              // Single rescale and saturation
+#else
+#define Q_ACC_TERM(__A__, __B__) ((q_acc_t) (((q_long_t) (__A__) * (__B__)) >> FRACTIONAL_BITS)) // Product rescaled to q_t
+#define Q_ACC_FROM_Q(__Q__)      ((q_acc_t) (__Q__))
+#define Q_ACC_TO_Q(__ACC__)      ((q_t) (__ACC__))
+#endif // Q_ACCUMULATE_WIDE
+
+q_acc_t q_isqrt(q_acc_t x);
+q_t q_sqrt_acc(q_acc_t sum);
+
+// Prepared divisor: a / d computed as |a| * magic >> shift, a multiplication and a shift instead of a hardware division
+// when the same d divides many numerators (a pivot column, a row of right-hand sides)
+struct divisor_t {
+    q_long_t magic; // ceil(2^(shift + FRACTIONAL_BITS) / |d|), below 2^(Q_FORM_INT_BITS + FRACTIONAL_BITS)
+    int shift;      // Q_FORM_INT_BITS - 1 + ceil(log2(|d|))
+    int negative;   // 1 if d is negative
+};
+typedef struct divisor_t q_divisor_t;
+
+q_divisor_t q_divisor_prepare(q_t d);
+
+/**
+ * @brief Divides a fixed point number by a prepared divisor (a/d)
+ * @details The quotient is the same as q_division(a, d) for every a, truncated toward zero: magic / 2^shift is
+ * 2^FRACTIONAL_BITS / |d| rounded up by less than 2^-shift, |a| <= 2^(Q_FORM_INT_BITS - 1) so the error stays below 1 / |d|
+ * and never reaches the next integer. The product of q_long_t operands fits in q_acc_t.
+ *
+ * @example
+ * const q_divisor_t pivot = q_divisor_prepare(Q_MATRIX_AT(A, i, i));
+ * for(size_t j = i + 1; j < n; j++)
+ * {
+ *     Q_MATRIX_AT(A, j, i) = q_division_prepared(Q_MATRIX_AT(A, j, i), pivot);
+ * }
+ *
+ * @param a The numerator of the division
+ * @param d The divisor prepared by q_divisor_prepare
+ * @return q_t The result of the division
+ */
+static inline q_t q_division_prepared(q_t a, q_divisor_t d)
+{
+    const q_long_t magnitude = (a < 0) ? -(q_long_t) a : (q_long_t) a;
+    const q_long_t quotient = (q_long_t) (((q_acc_t) magnitude * d.magic) >> d.shift);
+    const q_long_t mask = -(q_long_t) ((a < 0) != d.negative); // Sign of the quotient without a branch
+    return (q_t) ((quotient ^ mask) - mask);
+}
+
 #endif // FIX_POINT_MATH_H
@@ -3,10 +3,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 #include <time.h>
-#define Q_FORMAT_CUSTOM 16
-#define Q_FORMAT Q_FORMAT_CUSTOM
 
 #include "fix_point_math.h"
 
@@ -17,10 +16,21 @@
     assert(((m)->elements != NULL) && "Matrix elements are NULL");\
 }
 
+// Alignment in bytes of the buffers of q_matrix_alloc_aligned (a cache line), every row starts on such a boundary
+#ifndef Q_MATRIX_ALIGNMENT
+#define Q_MATRIX_ALIGNMENT 64
+#endif // Q_MATRIX_ALIGNMENT
+
+// Number of right-hand sides solved together by q_matrix_triangular_solve (wide accumulators kept on the stack)
+#ifndef Q_TRSM_BLOCK
+#define Q_TRSM_BLOCK 64
+#endif // Q_TRSM_BLOCK
+
 #define Q_MATRIX_AT(m, i, j) ((m)->elements[(i) * (m)->stride + (j)]) // Access the element at the i-th row and j-th column of the matrix
 #define Q_MATRIX_PRINT(m) q_matrix_print(&(m), (#m)) // Print the matrix
 
 #define q_matrix_square_alloc(size) q_matrix_alloc((size), (size)) // Allocate a square matrix
+#define q_matrix_square_alloc_aligned(size) q_matrix_alloc_aligned((size), (size)) // Allocate a square matrix with aligned rows
 
 #define q_matrix_fill_float(m, value) q_matrix_fill((m), float_to_q((value))) // Fill the matrix with a given value in float format
 #define q_ones(m)                     q_matrix_fill((m), Q_ONE) // Fill the matrix with ones
@@ -30,6 +40,7 @@
 #define q_matrix_scalar_mul_float(m, scalar) q_matrix_scalar_mul((m), float_to_q((scalar))) // Multiply the matrix by a scalar value in float format
 
 #define q_matrix_is_approx_float(a, b, abs_tol) q_matrix_is_approx((a), (b), float_to_q((abs_tol))) // Check if the matrices are approximately equal within an absolute tolerance in float format
+
 struct matrix_t {
     size_t rows;
     size_t cols;
@@ -44,7 +55,25 @@ enum status_t {
 };
 typedef enum status_t q_status_t;
 
+enum triangle_t {
+    Q_TRIANGLE_LOWER      = 0, // Lower triangle and diagonal
+    Q_TRIANGLE_UPPER      = 1, // Upper triangle and diagonal
+    Q_TRIANGLE_UNIT_LOWER = 2, // Strict lower triangle, the diagonal is one
+    Q_TRIANGLE_UNIT_UPPER = 3, // Strict upper triangle, the diagonal is one
+    Q_TRIANGLE_LOWER_TRANSPOSE      = 4, // Transpose of the lower triangle and diagonal (an upper triangle read by columns)
+    Q_TRIANGLE_UNIT_LOWER_TRANSPOSE = 5  // Transpose of the strict lower triangle, the diagonal is one
+};
+typedef enum triangle_t q_triangle_t;
+
 q_matrix_t q_matrix_alloc(size_t rows, size_t cols);
+q_matrix_t q_matrix_alloc_aligned(size_t rows, size_t cols);
+
+// Matrix views (share the buffer of the parent matrix, must not be freed)
+
+q_matrix_t q_matrix_view(const q_matrix_t* m, size_t row, size_t col, size_t rows, size_t cols);
+q_matrix_t q_matrix_view_strided(const q_matrix_t* m, size_t row, size_t col, size_t rows, size_t cols, size_t row_step);
+q_matrix_t q_matrix_view_row(const q_matrix_t* m, size_t row);
+q_matrix_t q_matrix_view_col(const q_matrix_t* m, size_t col);
 
 void q_matrix_slice_row(const q_matrix_t* m, q_matrix_t* dst, size_t row);
 void q_matrix_slice_col(const q_matrix_t* m, q_matrix_t* dst, size_t col);
@@ -62,6 +91,7 @@ void q_matrix_fill_rand(const q_matrix_t* m, q_t min, q_t max);
 
 void q_matrix_LU_decomposition(const q_matrix_t* m, q_matrix_t* L, q_matrix_t* U);
 void q_matrix_PLU_decomposition(const q_matrix_t* m , q_matrix_t* P, q_matrix_t* L, q_matrix_t* U);
+void q_matrix_triangular_solve(const q_matrix_t* T, const q_matrix_t* b, const q_matrix_t* X, q_triangle_t triangle);
 void q_matrix_forward_substitution(const q_matrix_t* L, const q_matrix_t* b, const q_matrix_t* Y);
 void q_matrix_back_substitution(const q_matrix_t* U, const q_matrix_t* Y, const q_matrix_t* X);
 void q_matrix_LU_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix_t* b, const q_matrix_t* X);
@@ -88,8 +118,9 @@ q_t q_matrix_euclidean_norm(const q_matrix_t* m);
 
 void q_cross_product(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* dst);
 void q_matrix_dot_product(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* dst);
-void q_matrix_eigenvalues(const q_matrix_t* m, q_matrix_t* dst); // TODO: might need to change the return type (Add complex numbers)
-void q_matrix_eigenvectors(const q_matrix_t* m, q_matrix_t* dst); // TODO: might need to change the return type (Add complex numbers)
+void q_matrix_power(const q_matrix_t* m, uint32_t k, q_matrix_t* dst);
+void q_matrix_eigenvalues(const q_matrix_t* m, q_matrix_t* dst); // n x 2 matrix of (re, im), see fix_point_eigen.h
+void q_matrix_eigenvectors(const q_matrix_t* m, q_matrix_t* dst); // Columns of unit 2-norm, complex pairs as (re, im) columns, see fix_point_eigen.h
 
 // Matrix validation
 
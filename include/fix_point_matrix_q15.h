@@ -0,0 +1,53 @@
+#ifndef FIX_POINT_MATRIX_Q15_H
+#define FIX_POINT_MATRIX_Q15_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "fix_point_formats.h"
+#include "fix_point_matrix.h"
+
+// Matrices stored in Q0.15 (16 bits per element). The kernels accumulate the Q30 products in 64 bits and round to the
+// nearest only once when the result is stored, the reductions and the solutions of the systems are returned in the active
+// format (q_t).
+
+#define Q15_MATRIX_ASSERT(m) {\
+    assert(((m) != NULL) && "Matrix is NULL");\
+    assert(((m)->elements != NULL) && "Matrix elements are NULL");\
+}
+
+#define Q15_MATRIX_AT(m, i, j) ((m)->elements[(i) * (m)->stride + (j)]) // Access the element at the i-th row and j-th column of the matrix
+
+#define q15_matrix_square_alloc(size) q15_matrix_alloc((size), (size)) // Allocate a square matrix
+
+struct matrix_q15_t {
+    size_t rows;
+    size_t cols;
+    size_t stride;
+    q15_t* elements;
+};
+typedef struct matrix_q15_t q15_matrix_t;
+
+q15_matrix_t q15_matrix_alloc(size_t rows, size_t cols);
+void q15_matrix_free(q15_matrix_t* m);
+
+// Conversion with the active format
+
+void q15_matrix_from_q(const q_matrix_t* src, q15_matrix_t* dst);
+void q15_matrix_to_q(const q15_matrix_t* src, q_matrix_t* dst);
+
+// Linear algebra operations
+
+void q15_matrix_dot_product(const q15_matrix_t* a, const q15_matrix_t* b, q15_matrix_t* dst);
+void q15_matrix_vector_product(const q15_matrix_t* a, const q_matrix_t* x, q_matrix_t* dst);
+void q15_matrix_forward_substitution(const q15_matrix_t* L, const q_matrix_t* b, const q_matrix_t* Y);
+void q15_matrix_back_substitution(const q15_matrix_t* U, const q_matrix_t* Y, const q_matrix_t* X);
+
+// Reductions
+
+q_t q15_matrix_trace(const q15_matrix_t* m);
+q_t q15_matrix_sum_contents(const q15_matrix_t* m);
+q_t q15_matrix_infinity_norm(const q15_matrix_t* m);
+q_t q15_matrix_euclidean_norm(const q15_matrix_t* m);
+
+#endif // FIX_POINT_MATRIX_Q15_H
@@ -0,0 +1,73 @@
+#ifndef FIX_POINT_MATRIX_Q7_H
+#define FIX_POINT_MATRIX_Q7_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "fix_point_formats.h"
+#include "fix_point_matrix.h"
+
+// Matrices stored in Q0.7 (8 bits per element) for quantized inference. The products are accumulated exactly in int32
+// (Q14) and requantized once per element with a per-tensor multiplier and shift.
+
+// The vector kernels are only available on x86 processors
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(Q_SIMD_DISABLE)
+#define Q7_GEMM_X86 1
+#else
+#define Q7_GEMM_X86 0
+#endif
+
+// Largest depth for which the int32 accumulators can not overflow (|a * b| <= 2^14)
+#define Q7_GEMM_MAX_DEPTH ((1 << 17) - 1)
+
+#define Q7_MATRIX_ASSERT(m) {\
+    assert(((m) != NULL) && "Matrix is NULL");\
+    assert(((m)->elements != NULL) && "Matrix elements are NULL");\
+}
+
+#define Q7_MATRIX_AT(m, i, j) ((m)->elements[(i) * (m)->stride + (j)]) // Access the element at the i-th row and j-th column of the matrix
+
+#define q7_matrix_square_alloc(size) q7_matrix_alloc((size), (size)) // Allocate a square matrix
+
+struct matrix_q7_t {
+    size_t rows;
+    size_t cols;
+    size_t stride;
+    q7_t* elements;
+};
+typedef struct matrix_q7_t q7_matrix_t;
+
+// Requantization of an int32 Q14 accumulator to Q7: q7 = saturate((acc * multiplier + 2^(shift - 1)) >> shift)
+struct q7_requant_t {
+    int32_t multiplier;
+    int32_t shift;
+};
+typedef struct q7_requant_t q7_requant_t;
+
+#define Q7_REQUANT_IDENTITY ((q7_requant_t) {1 << 30, 37}) // Plain Q7 product (acc / 2^7 rounded to nearest)
+
+enum q7_gemm_level_t {
+    Q7_GEMM_SCALAR = 0, // Portable C loops
+    Q7_GEMM_AVX2   = 1, // 8 lanes, _mm256_madd_epi16 on sign extended pairs
+    Q7_GEMM_VNNI   = 2  // 8 lanes, vpdpbusd on quads (AVX512-VNNI or AVX-VNNI)
+};
+typedef enum q7_gemm_level_t q7_gemm_level_t;
+
+q7_matrix_t q7_matrix_alloc(size_t rows, size_t cols);
+void q7_matrix_free(q7_matrix_t* m);
+
+// Conversion with the active format
+
+void q7_matrix_from_q(const q_matrix_t* src, q7_matrix_t* dst);
+void q7_matrix_to_q(const q7_matrix_t* src, q_matrix_t* dst);
+
+// Quantized GEMM
+
+q7_requant_t q7_requant_from_float(float scale);
+q7_gemm_level_t q7_gemm_detect(void);
+q7_gemm_level_t q7_gemm_set_level(q7_gemm_level_t level);
+void q7_gemm(const q7_matrix_t* a, const q7_matrix_t* b, const int32_t* bias, q7_requant_t requant, q7_matrix_t* dst);
+void q7_matrix_dot_product(const q7_matrix_t* a, const q7_matrix_t* b, q7_matrix_t* dst);
+
+#endif // FIX_POINT_MATRIX_Q7_H
@@ -0,0 +1,47 @@
+#ifndef FIX_POINT_QR_H
+#define FIX_POINT_QR_H
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "fix_point_matrix.h"
+
+// Householder QR factorization of a m x n matrix (m >= n), A = Q * R. R is stored on and above the diagonal and the
+// Householder vectors below it (their first element is one and is not stored), H_j = I - tau[j] * v_j * v_j^T and
+// Q = H_0 * H_1 * ... * H_n-1. Q is never formed by the solvers.
+
+// Panel width of the blocked factorization, the matrices with up to this many columns are factorized without blocking
+#ifndef Q_QR_BLOCK
+#define Q_QR_BLOCK 16
+#endif // Q_QR_BLOCK
+
+#define Q_QR_ASSERT(qr) {\
+    assert(((qr) != NULL) && "QR factorization is NULL");\
+    Q_MATRIX_ASSERT(&(qr)->QR);\
+    assert(((qr)->tau != NULL) && "QR scalar factors are NULL");\
+}
+
+struct qr_t {
+    q_matrix_t QR; // R on and above the diagonal, Householder vectors below the diagonal
+    q_t* tau;      // Scalar factor of every Householder reflector
+};
+typedef struct qr_t q_qr_t;
+
+q_qr_t q_qr_alloc(size_t rows, size_t cols);
+q_qr_t q_qr_arena_alloc(size_t rows, size_t cols);
+void q_qr_free(q_qr_t* qr);
+
+void q_qr_decompose(const q_matrix_t* m, q_qr_t* qr);
+void q_qr_decompose_blocked(const q_matrix_t* m, q_qr_t* qr, size_t block, size_t max_threads);
+void q_qr_apply_qt(const q_qr_t* qr, q_matrix_t* b);
+void q_qr_solve(const q_qr_t* qr, const q_matrix_t* b, q_matrix_t* x);
+void q_qr_get_q(const q_qr_t* qr, q_matrix_t* Q);
+void q_qr_get_r(const q_qr_t* qr, q_matrix_t* R);
+
+void q_matrix_least_squares(const q_matrix_t* m, const q_matrix_t* b, q_matrix_t* x);
+
+// Givens rotations, [c s; -s c] * [a; b] = [r; 0]
+
+void q_givens(q_t a, q_t b, q_t* c, q_t* s, q_t* r);
+void q_qr_givens_update(q_matrix_t* R, q_matrix_t* z, const q_matrix_t* row, const q_matrix_t* rhs);
+
+#endif // FIX_POINT_QR_H
@@ -0,0 +1,43 @@
+#ifndef FIX_POINT_SIMD_H
+#define FIX_POINT_SIMD_H
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "fix_point_math.h"
+
+// The vector kernels are only available for the 32 bits Q formats on x86 processors
+#if (defined(__x86_64__) || defined(__i386__)) && (Q_RAW_MAX == INT32_MAX) && !defined(Q_SIMD_DISABLE)
+#define Q_SIMD_X86 1
+#else
+#define Q_SIMD_X86 0
+#endif
+
+enum simd_level_t {
+    Q_SIMD_SCALAR = 0, // Portable C loops
+    Q_SIMD_SSE41  = 1, // 4 lanes, _mm_mul_epi32 widening products
+    Q_SIMD_AVX2   = 2  // 8 lanes, _mm256_mul_epi32 widening products
+};
+typedef enum simd_level_t q_simd_level_t;
+
+// Kernels over contiguous rows of n elements, dst may alias the sources
+struct simd_kernels_t {
+    q_simd_level_t level;
+    void (*add)(const q_t* a, const q_t* b, q_t* dst, size_t n);   // dst = a + b
+    void (*mul)(const q_t* a, const q_t* b, q_t* dst, size_t n);   // dst = a .* b (q_product)
+    void (*scale)(const q_t* a, q_t scalar, q_t* dst, size_t n);   // dst = a * scalar (q_product)
+    void (*fill)(q_t* dst, q_t value, size_t n);                   // dst = value
+    void (*copy)(const q_t* src, q_t* dst, size_t n);              // dst = src
+};
+typedef struct simd_kernels_t q_simd_kernels_t;
+
+// Lazily resolved dispatch slot (a pointer to a constant kernel table), safe to read and set from any thread
+typedef _Atomic(const void*) q_dispatch_t;
+
+const void* q_dispatch_get(q_dispatch_t* slot, const void* (*resolve)(void));
+void q_dispatch_set(q_dispatch_t* slot, const void* table);
+
+q_simd_level_t q_simd_detect(void);
+q_simd_level_t q_simd_set_level(q_simd_level_t level);
+const q_simd_kernels_t* q_simd_kernels(void);
+
+#endif // FIX_POINT_SIMD_H
@@ -0,0 +1,21 @@
+#ifndef FIX_POINT_THREAD_H
+#define FIX_POINT_THREAD_H
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+// Upper bound of the number of threads taking part in a parallel loop (the caller included)
+#ifndef Q_THREAD_MAX
+#define Q_THREAD_MAX 64
+#endif // Q_THREAD_MAX
+
+// A task of a parallel loop, worker is the index of the executing thread in [0, number of threads)
+typedef void (*q_thread_task_t)(void* ctx, size_t task, size_t worker);
+
+void q_thread_set_max_threads(size_t max_threads);
+size_t q_thread_get_max_threads(void);
+size_t q_thread_resolve(size_t max_threads);
+void q_thread_parallel_for(size_t tasks, size_t threads, q_thread_task_t fn, void* ctx);
+void q_thread_pool_shutdown(void);
+
+#endif // FIX_POINT_THREAD_H
@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+"""Generates the quarter-wave sine table of the trigonometric functions (lib/table/fix_point_sin_table.h).
+
+The entry i is sin(i * pi / 2^(bits + 1)) in Q2.30, rounded to the nearest, for i = 0 to 2^bits + 2: the quarter wave
+[0, pi / 2] with 2^bits intervals and the two entries after it read by the interpolation.
+
+Usage: python3 scripts/sin_table.py [bits] > lib/table/fix_point_sin_table.h (or make table trig_bits=<bits>)
+"""
+import math
+import sys
+
+MIN_BITS = 4
+MAX_BITS = 16
+PER_LINE = 8
+
+
+def main():
+    bits = int(sys.argv[1]) if len(sys.argv) > 1 else 8
+    if not MIN_BITS <= bits <= MAX_BITS:
+        sys.exit(f"The table bits must be in [{MIN_BITS}, {MAX_BITS}]")
+
+    n = 1 << bits
+    values = [round(math.sin(i * math.pi / (2 * n)) * (1 << 30)) for i in range(n + 3)]
+
+    print(f"// Generated by scripts/sin_table.py, do not edit. Regenerate with: make table trig_bits={bits}")
+    print("#ifndef FIX_POINT_SIN_TABLE_H")
+    print("#define FIX_POINT_SIN_TABLE_H")
+    print("#include <stdint.h>")
+    print()
+    print("// Intervals per quarter wave (2^Q_TRIG_TABLE_BITS)")
+    print(f"#define Q_TRIG_TABLE_BITS {bits}")
+    print()
+    print("// sin(i * pi / 2^(Q_TRIG_TABLE_BITS + 1)) in Q2.30 for i = 0 to 2^Q_TRIG_TABLE_BITS + 2")
+    print("static const int32_t q_sin_table[(1 << Q_TRIG_TABLE_BITS) + 3] = {")
+    for i in range(0, len(values), PER_LINE):
+        print("    " + ", ".join(f"{v}" for v in values[i:i + PER_LINE]) + ",")
+    print("};")
+    print()
+    print("#endif // FIX_POINT_SIN_TABLE_H")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,222 @@
+#include <pthread.h>
+#include "../include/fix_point_arena.h"
+
+// A block of the arena, the data starts at the first aligned address after the header
+struct arena_block_t {
+    struct arena_block_t* next;
+    size_t size;                // Usable bytes of the block
+    size_t used;                // Bytes in use, the blocks after the current one are empty
+    unsigned char* data;
+};
+
+struct arena_t {
+    struct arena_block_t* head;
+    struct arena_block_t* current; // Block the allocations are taken from, NULL while the arena has no blocks
+};
+
+static _Thread_local struct arena_t q_arena;
+static _Thread_local size_t q_arena_heap_count = 0;
+
+// The blocks of a thread are freed when it exits
+static pthread_key_t q_arena_key;
+static pthread_once_t q_arena_key_once = PTHREAD_ONCE_INIT;
+
+#define Q_ARENA_ROUND_UP(x) (((x) + Q_ARENA_ALIGNMENT - 1) / Q_ARENA_ALIGNMENT * Q_ARENA_ALIGNMENT)
+
+// MARK: Blocks
+
+static void q_arena_free_blocks(struct arena_t* arena)
+{
+    struct arena_block_t* block = arena->head;
+    while(block != NULL)
+    {
+        struct arena_block_t* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+}
+
+static void q_arena_thread_exit(void* arena)
+{
+    q_arena_free_blocks((struct arena_t*) arena);
+}
+
+static void q_arena_key_create(void)
+{
+    pthread_key_create(&q_arena_key, q_arena_thread_exit);
+}
+
+/**
+ * @brief Allocates a block of the arena on the heap
+ *
+ * @param size The usable bytes of the block
+ * @return struct arena_block_t* The empty block
+ */
+static struct arena_block_t* q_arena_block_alloc(size_t size)
+{
+    const size_t header = Q_ARENA_ROUND_UP(sizeof(struct arena_block_t));
+    void* memory = NULL;
+
+    if(posix_memalign(&memory, Q_ARENA_ALIGNMENT, header + size) != 0)
+    {
+        memory = NULL;
+    }
+    assert((memory != NULL) && "Memory allocation failed");
+
+    if(q_arena.head == NULL)
+    {
+        pthread_once(&q_arena_key_once, q_arena_key_create);
+        pthread_setspecific(q_arena_key, &q_arena);
+    }
+    q_arena_count_heap_allocation();
+
+    struct arena_block_t* block = (struct arena_block_t*) memory;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    block->data = (unsigned char*) memory + header;
+    return block;
+}
+
+// MARK: Arena
+
+/**
+ * @brief Returns the current position of the arena of the calling thread.
+ * @details The memory allocated from the arena after the mark is taken back by q_arena_release. Marks are released in the
+ * reverse order they were taken, so nested routines can use the arena as a stack.
+ *
+ * @example
+ * q_arena_mark_t mark = q_arena_mark();
+ * q_matrix_t tmp = q_arena_matrix_alloc(3, 3);
+ * // ... use tmp ...
+ * q_arena_release(mark); // tmp is no longer valid
+ *
+ * @return q_arena_mark_t The position of the arena
+ */
+q_arena_mark_t q_arena_mark(void)
+{
+    q_arena_mark_t mark;
+    mark.block = q_arena.current;
+    mark.used = (q_arena.current != NULL) ? q_arena.current->used : 0;
+    return mark;
+}
+
+/**
+ * @brief Takes back every allocation made from the arena of the calling thread since the mark. The blocks are kept for the
+ * next allocations.
+ *
+ * @param mark The position returned by q_arena_mark
+ */
+void q_arena_release(q_arena_mark_t mark)
+{
+    if(mark.block == NULL)
+    {
+        q_arena.current = q_arena.head;
+        if(q_arena.head != NULL)
+        {
+            q_arena.head->used = 0;
+        }
+        return;
+    }
+
+    assert((mark.used <= mark.block->size) && "Invalid arena mark");
+    q_arena.current = mark.block;
+    q_arena.current->used = mark.used;
+}
+
+/**
+ * @brief Allocates memory from the arena of the calling thread.
+ * @details The memory is aligned to Q_ARENA_ALIGNMENT bytes and is not initialized. A new block is taken from the heap only
+ * when the blocks already owned by the thread are too small, so repeated calls between the same mark and release reach a
+ * steady state without heap allocations.
+ *
+ * @param bytes The number of bytes
+ * @return void* The memory, valid until the release of an earlier mark
+ */
+void* q_arena_alloc(size_t bytes)
+{
+    bytes = Q_ARENA_ROUND_UP((bytes > 0) ? bytes : 1);
+
+    struct arena_block_t* block = q_arena.current;
+
+    if((block == NULL) || (block->size - block->used < bytes))
+    {
+        // The blocks after the current one are empty, the ones that are too small are replaced by a larger block
+        struct arena_block_t** link = (block != NULL) ? &block->next : &q_arena.head;
+        while((*link != NULL) && ((*link)->size < bytes))
+        {
+            struct arena_block_t* small = *link;
+            *link = small->next;
+            free(small);
+        }
+
+        if(*link == NULL)
+        {
+            size_t size = (block != NULL) ? 2 * block->size : Q_ARENA_BLOCK_BYTES;
+            size = (size < bytes) ? bytes : size;
+            *link = q_arena_block_alloc(size);
+        }
+
+        block = *link;
+        block->used = 0;
+        q_arena.current = block;
+    }
+
+    void* ptr = block->data + block->used;
+    block->used += bytes;
+    return ptr;
+}
+
+/**
+ * @brief Allocates a zero initialized matrix from the arena of the calling thread.
+ * @details The matrix is released with q_arena_release, it must not be passed to q_matrix_free.
+ *
+ * @param rows The number of rows in the matrix
+ * @param cols The number of columns in the matrix
+ * @return q_matrix_t The matrix of fixed point numbers
+ */
+q_matrix_t q_arena_matrix_alloc(size_t rows, size_t cols)
+{
+    assert((rows > 0) && "Number of rows must be greater than 0 when allocating a matrix");
+    assert((cols > 0) && "Number of columns must be greater than 0 when allocating a matrix");
+
+    q_matrix_t m;
+    m.rows     = rows;
+    m.cols     = cols;
+    m.stride   = cols;
+    m.elements = (q_t*) q_arena_alloc(rows * cols * sizeof(q_t));
+    memset(m.elements, 0, rows * cols * sizeof(q_t));
+    return m;
+}
+
+/**
+ * @brief Returns the blocks of the arena of the calling thread to the heap. No allocation of the arena may be in use. The
+ * blocks of the other threads are freed when they exit.
+ */
+void q_arena_free(void)
+{
+    q_arena_free_blocks(&q_arena);
+}
+
+// MARK: Allocation counter
+
+/**
+ * @brief Returns the number of heap allocations made by the library on the calling thread: matrices, arena blocks and GEMM
+ * buffers. The difference between two calls shows whether a routine reached its steady state.
+ *
+ * @return size_t The number of heap allocations
+ */
+size_t q_arena_heap_allocations(void)
+{
+    return q_arena_heap_count;
+}
+
+/**
+ * @brief Counts a heap allocation of the library on the calling thread (see q_arena_heap_allocations)
+ */
+void q_arena_count_heap_allocation(void)
+{
+    q_arena_heap_count++;
+}
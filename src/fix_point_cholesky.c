@@ -0,0 +1,524 @@
+#include "../include/fix_point_cholesky.h"
+#include "../include/fix_point_arena.h"
+#include "../include/fix_point_gemm.h"
+
+// MARK: Helpers
+
+/**
+ * @brief Copies the lower triangle and the diagonal of a square matrix, the upper triangle of the destination is not written
+ *
+ * @param src The reference to the source matrix
+ * @param dst The reference to the destination matrix, it may be the source matrix
+ */
+static void q_cholesky_copy_lower(const q_matrix_t* src, q_matrix_t* dst)
+{
+    if(src->elements == dst->elements)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i < src->rows; i++)
+    {
+        memcpy(&Q_MATRIX_AT(dst, i, 0), &Q_MATRIX_AT(src, i, 0), (i + 1) * sizeof(q_t));
+    }
+}
+
+/**
+ * @brief Overwrites a factor stored in the lower triangle with the inverse of the factorized matrix.
+ * @details The inverse is computed in two passes over the rows, both with a row of wide accumulators taken from the arena
+ * of the calling thread:
+ * 1. W = L^-1 in place, row by row from the top: W[i][j] = -sum(L[i][k] * W[k][j]) / L[i][i] for k = j to i - 1
+ * 2. A^-1 = W^T * S * W, only the lower triangle is computed and mirrored to the upper triangle:
+ *    A^-1[i][j] = sum(W[k][i] * S[k] * W[k][j]) for k = i to n - 1
+ * For the Cholesky factor S is the identity. For the LDL^T factor W is unit lower triangular and S = D^-1, D stays on the
+ * diagonal until the row is written.
+ *
+ * @param A The reference to the factor, overwritten with the inverse
+ * @param unit 1 for the LDL^T factor, 0 for the Cholesky factor
+ */
+static void q_cholesky_invert(q_matrix_t* A, int unit)
+{
+    const size_t n = A->rows;
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(n * sizeof(q_acc_t));
+
+    // 1. W = L^-1, the rows above i already hold W
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < i; j++)
+        {
+            acc[j] = 0;
+        }
+
+        for(size_t k = 0; k < i; k++)
+        {
+            const q_t l = Q_MATRIX_AT(A, i, k);
+            const q_t* w = &Q_MATRIX_AT(A, k, 0);
+
+            acc[k] -= unit ? Q_ACC_FROM_Q(l) : Q_ACC_TERM(l, w[k]); // W[k][k] is one for the unit factor
+            for(size_t j = 0; j < k; j++)
+            {
+                acc[j] -= Q_ACC_TERM(l, w[j]);
+            }
+        }
+
+        if(unit)
+        {
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(A, i, j) = Q_ACC_TO_Q(acc[j]);
+            }
+        }
+        else
+        {
+            const q_t diagonal = Q_MATRIX_AT(A, i, i);
+            assert((diagonal != Q_ZERO) && "Matrix is singular (Can not calculate the inverse)");
+
+            const q_divisor_t d = q_divisor_prepare(diagonal); // The whole row is divided by the diagonal
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(A, i, j) = q_division_prepared(Q_ACC_TO_Q(acc[j]), d);
+            }
+            Q_MATRIX_AT(A, i, i) = q_reciprocal(diagonal);
+        }
+    }
+
+    // 2. A^-1 = W^T * S * W, the row i only needs the rows i to n - 1 of W
+    for(size_t i = 0; i < n; i++)
+    {
+        const q_t w_ii = unit ? Q_ONE : Q_MATRIX_AT(A, i, i);
+
+        for(size_t j = 0; j <= i; j++)
+        {
+            acc[j] = 0;
+        }
+
+        for(size_t k = i; k < n; k++)
+        {
+            const q_t* w = &Q_MATRIX_AT(A, k, 0);
+            q_t s = (k == i) ? w_ii : w[i]; // W[k][i]
+
+            if(unit)
+            {
+                assert((w[k] != Q_ZERO) && "Matrix is singular (Can not calculate the inverse)");
+                s = q_division(s, w[k]); // W[k][i] / D[k]
+            }
+
+            const size_t j_end = (k == i) ? i : (i + 1);
+            for(size_t j = 0; j < j_end; j++)
+            {
+                acc[j] += Q_ACC_TERM(s, w[j]);
+            }
+            if(k == i)
+            {
+                acc[i] += Q_ACC_TERM(s, w_ii);
+            }
+        }
+
+        for(size_t j = 0; j <= i; j++)
+        {
+            const q_t value = Q_ACC_TO_Q(acc[j]);
+            Q_MATRIX_AT(A, i, j) = value;
+            Q_MATRIX_AT(A, j, i) = value; // The upper triangle is never read by the passes
+        }
+    }
+
+    q_arena_release(mark); // Release the accumulators
+}
+
+// MARK: Factorization
+
+/**
+ * @brief Factorizes the panel of the columns [k0, k0 + kb) of a matrix holding its lower triangle (unblocked elimination).
+ * @details The contributions of the previous panels were already subtracted by the trailing updates, so the sums only run
+ * over the columns of the panel. Every element is the inner product of two rows that are already known.
+ * For the Cholesky factorization (unit = 0):
+ * L[i][j] = (A[i][j] - sum(L[i][k] * L[j][k])) / L[j][j]
+ * L[i][i] = sqrt(A[i][i] - sum(L[i][k]^2))
+ * For the LDL^T factorization (unit = 1), w[j] = L[i][j] * D[j] is kept in a work vector:
+ * w[j]    = A[i][j] - sum(w[k] * L[j][k])
+ * L[i][j] = w[j] / D[j]
+ * D[i]    = A[i][i] - sum(w[k] * L[i][k])
+ *
+ * @param A The reference to the matrix, overwritten with the factors
+ * @param k0 The first column of the panel
+ * @param kb The number of columns of the panel
+ * @param w The work vector of kb elements (LDL^T factorization only)
+ * @param unit 1 for the LDL^T factorization, 0 for the Cholesky factorization
+ */
+static void q_cholesky_panel(q_matrix_t* A, size_t k0, size_t kb, q_t* w, int unit)
+{
+    const size_t n = A->rows;
+    const size_t k1 = k0 + kb;
+
+    for(size_t i = k0; i < n; i++)
+    {
+        q_t* l_i = &Q_MATRIX_AT(A, i, 0);
+        const size_t j_end = (i < k1) ? i : k1;
+
+        for(size_t j = k0; j < j_end; j++)
+        {
+            const q_t* l_j = &Q_MATRIX_AT(A, j, 0);
+
+            q_acc_t acc = Q_ACC_FROM_Q(l_i[j]);
+            for(size_t k = k0; k < j; k++)
+            {
+                acc -= Q_ACC_TERM(unit ? w[k - k0] : l_i[k], l_j[k]);
+            }
+
+            if(unit)
+            {
+                w[j - k0] = Q_ACC_TO_Q(acc);
+                l_i[j] = q_division(w[j - k0], l_j[j]);
+            }
+            else
+            {
+                l_i[j] = q_division(Q_ACC_TO_Q(acc), l_j[j]);
+            }
+        }
+
+        if(i >= k1)
+        {
+            continue; // The row is below the diagonal block of the panel
+        }
+
+        q_acc_t acc = Q_ACC_FROM_Q(l_i[i]);
+        for(size_t k = k0; k < i; k++)
+        {
+            acc -= Q_ACC_TERM(unit ? w[k - k0] : l_i[k], l_i[k]);
+        }
+
+        const q_t diagonal = Q_ACC_TO_Q(acc);
+        if(unit)
+        {
+            assert((diagonal != Q_ZERO) && "Matrix is singular (LDL^T decomposition is not possible)");
+            l_i[i] = diagonal;
+        }
+        else
+        {
+            assert((diagonal > Q_ZERO) && "Matrix is not positive definite (Cholesky decomposition is not possible)");
+            l_i[i] = q_sqrt(diagonal);
+        }
+    }
+}
+
+/**
+ * @brief Subtracts the contribution of the panel [k0, k1) from the lower triangle of the trailing submatrix.
+ * @details A22 = A22 - L21 * S * L21^T, S is the identity for the Cholesky factor and D11 for the LDL^T factor. The transpose
+ * of L21 (scaled by D11) is packed in the arena of the calling thread. The trailing submatrix is updated by block columns:
+ * the lower triangle of the diagonal block is updated directly and the block below it with the GEMM engine, so the upper
+ * triangle is never written.
+ *
+ * @param A The reference to the matrix being factorized
+ * @param k0 The first column of the panel
+ * @param k1 The first column after the panel
+ * @param nb The width of the block columns
+ * @param max_threads The maximum number of threads of the GEMM updates, 0 selects the default
+ * @param unit 1 for the LDL^T factorization, 0 for the Cholesky factorization
+ */
+static void q_cholesky_update(q_matrix_t* A, size_t k0, size_t k1, size_t nb, size_t max_threads, int unit)
+{
+    const size_t m = A->rows - k1;
+    const size_t kb = k1 - k0;
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t Wt = q_arena_matrix_alloc(kb, m);
+
+    for(size_t r = 0; r < m; r++)
+    {
+        const q_t* l = &Q_MATRIX_AT(A, k1 + r, k0);
+        for(size_t p = 0; p < kb; p++)
+        {
+            Q_MATRIX_AT(&Wt, p, r) = unit ? q_product(l[p], Q_MATRIX_AT(A, k0 + p, k0 + p)) : l[p];
+        }
+    }
+
+    for(size_t j0 = 0; j0 < m; j0 += nb)
+    {
+        const size_t jb = (m - j0 < nb) ? (m - j0) : nb;
+
+        // Lower triangle of the diagonal block
+        for(size_t i = j0; i < j0 + jb; i++)
+        {
+            const q_t* l = &Q_MATRIX_AT(A, k1 + i, k0);
+            for(size_t j = j0; j <= i; j++)
+            {
+                q_acc_t acc = Q_ACC_FROM_Q(Q_MATRIX_AT(A, k1 + i, k1 + j));
+                for(size_t p = 0; p < kb; p++)
+                {
+                    acc -= Q_ACC_TERM(l[p], Q_MATRIX_AT(&Wt, p, j));
+                }
+                Q_MATRIX_AT(A, k1 + i, k1 + j) = Q_ACC_TO_Q(acc);
+            }
+        }
+
+        if(j0 + jb < m)
+        {
+            q_matrix_t L = q_matrix_view(A, k1 + j0 + jb, k0, m - j0 - jb, kb);
+            q_matrix_t W = q_matrix_view(&Wt, 0, j0, kb, jb);
+            q_matrix_t C = q_matrix_view(A, k1 + j0 + jb, k1 + j0, m - j0 - jb, jb);
+            q_gemm_parallel(&L, &W, &C, Q_GEMM_SUBTRACT, max_threads);
+        }
+    }
+
+    q_arena_release(mark); // Release the packed panel
+}
+
+/**
+ * @brief Blocked right-looking factorization shared by the Cholesky and LDL^T factorizations
+ *
+ * @param m The reference to the symmetric matrix, it may be F
+ * @param F The reference to the factors
+ * @param block The panel width, 0 selects Q_CHOLESKY_BLOCK
+ * @param max_threads The maximum number of threads of the trailing updates, 0 selects the default
+ * @param unit 1 for the LDL^T factorization, 0 for the Cholesky factorization
+ */
+static void q_cholesky_factorize(const q_matrix_t* m, q_matrix_t* F, size_t block, size_t max_threads, int unit)
+{
+    const size_t n = m->rows;
+    const size_t nb = (block == 0) ? Q_CHOLESKY_BLOCK : block;
+
+    q_cholesky_copy_lower(m, F); // The factorization is performed in place
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_t* w = (q_t*) q_arena_alloc(nb * sizeof(q_t));
+
+    for(size_t k0 = 0; k0 < n; k0 += nb)
+    {
+        const size_t kb = (n - k0 < nb) ? (n - k0) : nb;
+
+        q_cholesky_panel(F, k0, kb, w, unit);
+
+        if(k0 + kb < n)
+        {
+            q_cholesky_update(F, k0, k0 + kb, nb, max_threads, unit);
+        }
+    }
+
+    q_arena_release(mark); // Release the work vector
+}
+
+// MARK: Cholesky
+
+/**
+ * @brief This function computes the Cholesky factorization of a symmetric positive definite matrix, A = L * L^T.
+ * @details The factorization is computed with q_matrix_cholesky_blocked, the panel width is Q_CHOLESKY_BLOCK and the
+ * trailing updates use the default number of threads. Only the lower triangle of A is read and only the lower triangle of
+ * L is written, it takes half the operations of the LU factorization and needs no pivoting. q_matrix_ldlt avoids the
+ * square roots.
+ *
+ * @example
+ * q_matrix_cholesky(&A, &L);
+ * q_matrix_cholesky_solve(&L, &b, &x);
+ *
+ * @param m The reference to the symmetric positive definite matrix, it may be L
+ * @param L The reference to the lower triangular factor, the upper triangle is not written
+ */
+void q_matrix_cholesky(const q_matrix_t* m, q_matrix_t* L)
+{
+    q_matrix_cholesky_blocked(m, L, 0, 0);
+}
+
+/**
+ * @brief This function computes the blocked right-looking Cholesky factorization, A = L * L^T.
+ * @details The matrix is processed in panels of block columns. For every panel:
+ * 1. The panel is factorized with the unblocked elimination, the rows of L are computed from the top
+ *    (Cholesky-Banachiewicz) so both operands of every inner product are read contiguously
+ * 2. The lower triangle of the trailing submatrix is updated, A22 = A22 - L21 * L21^T, with the GEMM engine
+ * The sums are accumulated in wide accumulators. When the matrix is not larger than the panel width the factorization is
+ * the unblocked elimination, the blocked factors differ in the last bits because the trailing updates round once per
+ * panel.
+ *
+ * @param m The reference to the symmetric positive definite matrix, it may be L
+ * @param L The reference to the lower triangular factor, the upper triangle is not written
+ * @param block The panel width, 0 selects Q_CHOLESKY_BLOCK
+ * @param max_threads The maximum number of threads of the trailing updates, 0 selects the default
+ */
+void q_matrix_cholesky_blocked(const q_matrix_t* m, q_matrix_t* L, size_t block, size_t max_threads)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(L);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when performing Cholesky decomposition");
+    assert((L->rows == m->rows) && (L->cols == m->cols) && "Cholesky factor has different dimensions than the input matrix");
+
+    q_cholesky_factorize(m, L, block, max_threads, 0);
+}
+
+/**
+ * @brief This function solves the system of linear equations A * x = b with the Cholesky factorization of A.
+ * @details L * y = b is solved by forward substitution and L^T * x = y by back substitution, both with
+ * q_matrix_triangular_solve on the lower triangle of L (the transpose is never formed). b may hold k right-hand sides
+ * (n x k).
+ *
+ * @param L The reference to the Cholesky factor of A
+ * @param b The reference to the right-hand sides (n x k)
+ * @param x The reference to the solutions (n x k), it may be b
+ */
+void q_matrix_cholesky_solve(const q_matrix_t* L, const q_matrix_t* b, q_matrix_t* x)
+{
+    Q_MATRIX_ASSERT(L);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(x);
+
+    q_matrix_triangular_solve(L, b, x, Q_TRIANGLE_LOWER); // L * y = b
+    q_matrix_triangular_solve(L, x, x, Q_TRIANGLE_LOWER_TRANSPOSE); // L^T * x = y
+}
+
+/**
+ * @brief This function returns the determinant of a matrix from its Cholesky factorization.
+ * @details det(A) = det(L) * det(L^T) = (L[0][0] * L[1][1] * ... * L[n-1][n-1])^2
+ *
+ * @param L The reference to the Cholesky factor of A
+ * @return q_t The determinant of A
+ */
+q_t q_matrix_cholesky_determinant(const q_matrix_t* L)
+{
+    Q_MATRIX_ASSERT(L);
+
+    q_t ret = Q_ONE;
+    for(size_t i = 0; i < L->rows; i++)
+    {
+        ret = q_product(ret, Q_MATRIX_AT(L, i, i));
+    }
+
+    return q_product(ret, ret);
+}
+
+/**
+ * @brief This function computes the inverse of a matrix from its Cholesky factorization, A^-1 = L^-T * L^-1.
+ * @details The factor is copied to the lower triangle of the destination, inverted in place and multiplied by its
+ * transpose. Only the lower triangle of the inverse is computed, the upper triangle is its mirror.
+ *
+ * @param L The reference to the Cholesky factor of A
+ * @param dst The reference to the inverse of A, it may be L
+ */
+void q_matrix_cholesky_inverse(const q_matrix_t* L, q_matrix_t* dst)
+{
+    Q_MATRIX_ASSERT(L);
+    Q_MATRIX_ASSERT(dst);
+
+    assert((L->rows == L->cols) && "Cholesky factor is not square shape (Can not calculate the inverse)");
+    assert((dst->rows == L->rows) && (dst->cols == L->cols) && "Destination matrix has a different shape than the factorized matrix when calculating the inverse");
+
+    q_cholesky_copy_lower(L, dst);
+    q_cholesky_invert(dst, 0);
+}
+
+// MARK: LDL^T
+
+/**
+ * @brief This function computes the LDL^T factorization of a symmetric matrix, A = L * D * L^T.
+ * @details L is unit lower triangular and D is diagonal, they are packed in a single matrix: L below the diagonal and D on
+ * the diagonal. It has the cost and the memory traffic of the Cholesky factorization without the square roots. The
+ * factorization is computed with q_matrix_ldlt_blocked, the panel width is Q_CHOLESKY_BLOCK and the trailing updates use
+ * the default number of threads.
+ *
+ * @example
+ * q_matrix_ldlt(&A, &LD);
+ * q_matrix_ldlt_solve(&LD, &b, &x);
+ *
+ * @param m The reference to the symmetric matrix, it may be LD
+ * @param LD The reference to the packed factors, the upper triangle is not written
+ */
+void q_matrix_ldlt(const q_matrix_t* m, q_matrix_t* LD)
+{
+    q_matrix_ldlt_blocked(m, LD, 0, 0);
+}
+
+/**
+ * @brief This function computes the blocked right-looking LDL^T factorization, A = L * D * L^T.
+ * @details The panels are factorized with the unblocked elimination, w[j] = L[i][j] * D[j] is kept in a work vector taken
+ * from the arena of the calling thread:
+ * w[j]    = A[i][j] - sum(w[k] * L[j][k]) for k = 0 to j - 1
+ * L[i][j] = w[j] / D[j]
+ * D[i]    = A[i][i] - sum(w[k] * L[i][k]) for k = 0 to i - 1
+ * and the lower triangle of the trailing submatrix is updated with the GEMM engine, A22 = A22 - L21 * D11 * L21^T. The
+ * factorization has no pivoting, D is positive for a symmetric positive definite matrix and it must not have zeros.
+ *
+ * @param m The reference to the symmetric matrix, it may be LD
+ * @param LD The reference to the packed factors, the upper triangle is not written
+ * @param block The panel width, 0 selects Q_CHOLESKY_BLOCK
+ * @param max_threads The maximum number of threads of the trailing updates, 0 selects the default
+ */
+void q_matrix_ldlt_blocked(const q_matrix_t* m, q_matrix_t* LD, size_t block, size_t max_threads)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(LD);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when performing LDL^T decomposition");
+    assert((LD->rows == m->rows) && (LD->cols == m->cols) && "LDL^T factorization has different dimensions than the input matrix");
+
+    q_cholesky_factorize(m, LD, block, max_threads, 1);
+}
+
+/**
+ * @brief This function solves the system of linear equations A * x = b with the LDL^T factorization of A.
+ * @details L * y = b is solved by forward substitution, the rows are divided by D and L^T * x = D^-1 * y is solved by
+ * back substitution. Both substitutions use the unit lower triangle of the packed factors, b may hold k right-hand sides
+ * (n x k).
+ *
+ * @param LD The reference to the packed LDL^T factors of A
+ * @param b The reference to the right-hand sides (n x k)
+ * @param x The reference to the solutions (n x k), it may be b
+ */
+void q_matrix_ldlt_solve(const q_matrix_t* LD, const q_matrix_t* b, q_matrix_t* x)
+{
+    Q_MATRIX_ASSERT(LD);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(x);
+
+    q_matrix_triangular_solve(LD, b, x, Q_TRIANGLE_UNIT_LOWER); // L * y = b
+
+    for(size_t i = 0; i < x->rows; i++)
+    {
+        const q_t diagonal = Q_MATRIX_AT(LD, i, i);
+        for(size_t c = 0; c < x->cols; c++)
+        {
+            Q_MATRIX_AT(x, i, c) = q_division(Q_MATRIX_AT(x, i, c), diagonal);
+        }
+    }
+
+    q_matrix_triangular_solve(LD, x, x, Q_TRIANGLE_UNIT_LOWER_TRANSPOSE); // L^T * x = D^-1 * y
+}
+
+/**
+ * @brief This function returns the determinant of a matrix from its LDL^T factorization.
+ * @details det(A) = det(L) * det(D) * det(L^T) = D[0] * D[1] * ... * D[n-1]
+ *
+ * @param LD The reference to the packed LDL^T factors of A
+ * @return q_t The determinant of A
+ */
+q_t q_matrix_ldlt_determinant(const q_matrix_t* LD)
+{
+    Q_MATRIX_ASSERT(LD);
+
+    q_t ret = Q_ONE;
+    for(size_t i = 0; i < LD->rows; i++)
+    {
+        ret = q_product(ret, Q_MATRIX_AT(LD, i, i));
+    }
+
+    return ret;
+}
+
+/**
+ * @brief This function computes the inverse of a matrix from its LDL^T factorization, A^-1 = L^-T * D^-1 * L^-1.
+ * @details The factors are copied to the lower triangle of the destination and inverted in place, only the lower triangle
+ * of the inverse is computed and the upper triangle is its mirror.
+ *
+ * @param LD The reference to the packed LDL^T factors of A
+ * @param dst The reference to the inverse of A, it may be LD
+ */
+void q_matrix_ldlt_inverse(const q_matrix_t* LD, q_matrix_t* dst)
+{
+    Q_MATRIX_ASSERT(LD);
+    Q_MATRIX_ASSERT(dst);
+
+    assert((LD->rows == LD->cols) && "LDL^T factorization is not square shape (Can not calculate the inverse)");
+    assert((dst->rows == LD->rows) && (dst->cols == LD->cols) && "Destination matrix has a different shape than the factorized matrix when calculating the inverse");
+
+    q_cholesky_copy_lower(LD, dst);
+    q_cholesky_invert(dst, 1);
+}
@@ -0,0 +1,1750 @@
+#include "../include/fix_point_eigen.h"
+#include "../include/fix_point_arena.h"
+#include "../include/fix_point_simd.h"
+
+// Largest element of the scaled matrix is in [Q_EIGEN_LOW, 2 * Q_EIGEN_LOW) raw units
+#define Q_EIGEN_LOW ((q_acc_t) 1 << (Q_FORM_INT_BITS - 2 - Q_EIGEN_HEADROOM))
+
+// Fractional bits of the reflector and rotation coefficients, kept in q_acc_t. With FRACTIONAL_BITS only the transformations
+// are orthogonal to 2^-FRACTIONAL_BITS and the thousands of them applied by the iterations drift the eigenvalues.
+#define Q_EIGEN_COEF_BITS (Q_FORM_INT_BITS - 2)
+#define Q_EIGEN_COEF_ONE ((q_acc_t) 1 << Q_EIGEN_COEF_BITS)
+
+// Largest element of an eigenvector during the back substitution, the computed elements are scaled down above it
+#define Q_EIGEN_VECTOR_LIMIT ((q_acc_t) 1 << (Q_FORM_INT_BITS - 6))
+
+// Real or complex eigenvalue of the real Schur form: the diagonal block at index of size 1 or 2
+struct eigen_block_t {
+    size_t index;
+    size_t size;
+    q_t re;
+    q_t im; // Positive for a complex pair, the conjugate follows
+};
+typedef struct eigen_block_t q_eigen_block_t;
+
+// MARK: Helpers
+
+/**
+ * @brief Returns the full product of two fixed point numbers (scale 2^(2 * FRACTIONAL_BITS)) in a wide accumulator
+ */
+static inline q_acc_t q_eigen_full(q_t a, q_t b)
+{
+    return (q_acc_t) ((q_long_t) a * b);
+}
+
+/**
+ * @brief Returns (c * x + s * y) / 2^shift rounded to the nearest, for coefficients with shift fractional bits
+ */
+static inline q_acc_t q_eigen_round(q_acc_t c, q_acc_t x, q_acc_t s, q_acc_t y, int shift)
+{
+    return (c * x + s * y + ((q_acc_t) 1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief Copies a square matrix scaled by a power of two so its largest element is in [Q_EIGEN_LOW, 2 * Q_EIGEN_LOW).
+ *
+ * @param m The reference to the matrix
+ * @param A The reference to the scaled copy
+ * @return int The exponent of the scale factor, A = m * 2^exponent
+ */
+static int q_eigen_scale(const q_matrix_t* m, q_matrix_t* A)
+{
+    const size_t n = m->rows;
+
+    q_acc_t max = 0;
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            const q_acc_t a = Q_MATRIX_AT(m, i, j);
+            max = (a < 0) ? ((-a > max) ? -a : max) : ((a > max) ? a : max);
+        }
+    }
+
+    int exponent = 0;
+    if(max != 0)
+    {
+        while(max >= 2 * Q_EIGEN_LOW)
+        {
+            max >>= 1;
+            exponent--;
+        }
+        while(max < Q_EIGEN_LOW)
+        {
+            max <<= 1;
+            exponent++;
+        }
+    }
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            const q_t a = Q_MATRIX_AT(m, i, j);
+            Q_MATRIX_AT(A, i, j) = (exponent >= 0) ? (q_t) (a * ((q_long_t) 1 << exponent)) :
+                                                     (q_t) ((a + ((q_long_t) 1 << (-exponent - 1))) >> -exponent);
+        }
+    }
+
+    return exponent;
+}
+
+/**
+ * @brief Undoes the scaling of q_eigen_scale on a value, rounded to the nearest and saturated
+ */
+static q_t q_eigen_unscale(q_t a, int exponent)
+{
+    if(exponent > 0)
+    {
+        return (q_t) (((q_long_t) a + ((q_long_t) 1 << (exponent - 1))) >> exponent);
+    }
+
+    return q_saturate((q_acc_t) a * ((q_acc_t) 1 << -exponent));
+}
+
+/**
+ * @brief Scales wide values by a common power of two so the largest magnitude is in [low, 2 * low). Only the direction of
+ * the vector is kept, so the transformations built from tiny or huge values keep the full resolution.
+ *
+ * @param w The wide values
+ * @param len The number of values
+ * @param low The lower bound of the largest magnitude
+ * @param x The scaled values, it may be w
+ */
+static void q_eigen_normalize(const q_acc_t* w, size_t len, q_acc_t low, q_acc_t* x)
+{
+    q_acc_t max = 0;
+    for(size_t i = 0; i < len; i++)
+    {
+        const q_acc_t a = (w[i] < 0) ? -w[i] : w[i];
+        max = (a > max) ? a : max;
+    }
+
+    int shift = 0;
+    if(max != 0)
+    {
+        while(max >= 2 * low)
+        {
+            max >>= 1;
+            shift++;
+        }
+        while(max < low)
+        {
+            max <<= 1;
+            shift--;
+        }
+    }
+
+    for(size_t i = 0; i < len; i++)
+    {
+        x[i] = (shift >= 0) ? (w[i] >> shift) : (w[i] * ((q_acc_t) 1 << -shift));
+    }
+}
+
+/**
+ * @brief Returns the magnitude below which the subdiagonal elements are treated as zero by the QR iterations, the
+ * Frobenius norm of the matrix scaled by 2^-Q_EIGEN_PRECISION and not smaller than Q_EIGEN_TOLERANCE
+ */
+static q_t q_eigen_tolerance(const q_matrix_t* A)
+{
+    q_acc_t sum = 0;
+    for(size_t i = 0; i < A->rows; i++)
+    {
+        for(size_t j = 0; j < A->cols; j++)
+        {
+            sum += q_eigen_full(Q_MATRIX_AT(A, i, j), Q_MATRIX_AT(A, i, j));
+        }
+    }
+
+    const q_t tol = q_sqrt_acc(sum) >> Q_EIGEN_PRECISION;
+    return (tol > Q_EIGEN_TOLERANCE) ? tol : Q_EIGEN_TOLERANCE;
+}
+
+/**
+ * @brief Checks that a square matrix is exactly symmetric
+ */
+static int q_eigen_is_symmetric(const q_matrix_t* m)
+{
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = 0; j < i; j++)
+        {
+            if(Q_MATRIX_AT(m, i, j) != Q_MATRIX_AT(m, j, i))
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Sorts the eigenvalues by decreasing real part, the blocks with the same real part keep their order
+ */
+static void q_eigen_sort(q_eigen_block_t* blocks, size_t count)
+{
+    for(size_t i = 1; i < count; i++)
+    {
+        const q_eigen_block_t b = blocks[i];
+        size_t j = i;
+        while((j > 0) && (blocks[j - 1].re < b.re))
+        {
+            blocks[j] = blocks[j - 1];
+            j--;
+        }
+        blocks[j] = b;
+    }
+}
+
+// MARK: Householder reflectors and rotations
+
+/**
+ * @brief Computes the Householder reflector of a vector, H * x = (beta, 0, ..., 0) with H = I - tau * v * v^T.
+ * @details Same construction as the QR factorization: beta = -sign(x0) * ||x||, tau = (beta - x0) / beta and
+ * v = (1, x[1:] / (x0 - beta)), on the vector normalized to Q_FORM_INT_BITS - 3 bits. v and tau have Q_EIGEN_COEF_BITS
+ * fractional bits. A vector that is already zero below its first element gets tau = 0 (H = I).
+ *
+ * @param x The vector, any common scale
+ * @param len The number of elements
+ * @param v The Householder vector
+ * @return q_acc_t The scalar factor tau
+ */
+static q_acc_t q_eigen_house(const q_acc_t* x, size_t len, q_acc_t* v)
+{
+    q_eigen_normalize(x, len, (q_acc_t) 1 << (Q_FORM_INT_BITS - 3), v);
+
+    const q_acc_t alpha = v[0];
+    q_acc_t sum = 0;
+    for(size_t i = 1; i < len; i++)
+    {
+        sum += v[i] * v[i];
+    }
+
+    if(sum == 0)
+    {
+        return 0;
+    }
+
+    const q_acc_t norm = q_isqrt(sum + alpha * alpha);
+    const q_acc_t beta = (alpha >= 0) ? -norm : norm;
+    const q_acc_t scale = alpha - beta;
+
+    v[0] = Q_EIGEN_COEF_ONE;
+    for(size_t i = 1; i < len; i++)
+    {
+        v[i] = (v[i] * Q_EIGEN_COEF_ONE) / scale;
+    }
+
+    return ((beta - alpha) * Q_EIGEN_COEF_ONE) / beta;
+}
+
+/**
+ * @brief Applies a reflector to the rows [r0, r0 + len) and the columns [c0, c1) of a matrix, A = H * A.
+ * @details The rows are traversed in order with the columns as the innermost loop, the inner products are accumulated in
+ * a row of wide accumulators.
+ *
+ * @param A The reference to the matrix
+ * @param v The Householder vector, its first element is one
+ * @param len The number of elements of v
+ * @param tau The scalar factor of the reflector
+ * @param r0 The first row
+ * @param c0 The first column
+ * @param c1 The column after the last one
+ * @param acc The accumulators, at least c1 - c0 elements
+ */
+static void q_eigen_reflect_left(q_matrix_t* A, const q_acc_t* v, size_t len, q_acc_t tau, size_t r0, size_t c0, size_t c1,
+                                 q_acc_t* acc)
+{
+    if((tau == 0) || (c0 >= c1))
+    {
+        return;
+    }
+
+    const size_t nc = c1 - c0;
+
+    q_t* row = &Q_MATRIX_AT(A, r0, c0);
+    for(size_t c = 0; c < nc; c++)
+    {
+        acc[c] = (q_acc_t) row[c] * Q_EIGEN_COEF_ONE;
+    }
+
+    for(size_t i = 1; i < len; i++)
+    {
+        row = &Q_MATRIX_AT(A, r0 + i, c0);
+        for(size_t c = 0; c < nc; c++)
+        {
+            acc[c] += v[i] * row[c];
+        }
+    }
+
+    // acc = tau * v^T * A, with Q_EIGEN_COEF_BITS fractional bits more than A
+    for(size_t c = 0; c < nc; c++)
+    {
+        acc[c] = tau * (acc[c] >> Q_EIGEN_COEF_BITS);
+    }
+
+    for(size_t i = 0; i < len; i++)
+    {
+        row = &Q_MATRIX_AT(A, r0 + i, c0);
+        for(size_t c = 0; c < nc; c++)
+        {
+            row[c] = q_saturate(row[c] - q_eigen_round(v[i], acc[c], 0, 0, 2 * Q_EIGEN_COEF_BITS));
+        }
+    }
+}
+
+/**
+ * @brief Applies a reflector to the columns [c0, c0 + len) and the rows [r0, r1) of a matrix, A = A * H.
+ * @details Every row is updated on its own with a contiguous inner product.
+ *
+ * @param A The reference to the matrix
+ * @param v The Householder vector, its first element is one
+ * @param len The number of elements of v
+ * @param tau The scalar factor of the reflector
+ * @param c0 The first column
+ * @param r0 The first row
+ * @param r1 The row after the last one
+ */
+static void q_eigen_reflect_right(q_matrix_t* A, const q_acc_t* v, size_t len, q_acc_t tau, size_t c0, size_t r0, size_t r1)
+{
+    if(tau == 0)
+    {
+        return;
+    }
+
+    for(size_t r = r0; r < r1; r++)
+    {
+        q_t* row = &Q_MATRIX_AT(A, r, c0);
+
+        q_acc_t acc = 0;
+        for(size_t i = 0; i < len; i++)
+        {
+            acc += v[i] * row[i];
+        }
+
+        const q_acc_t t = tau * (acc >> Q_EIGEN_COEF_BITS);
+        for(size_t i = 0; i < len; i++)
+        {
+            row[i] = q_saturate(row[i] - q_eigen_round(v[i], t, 0, 0, 2 * Q_EIGEN_COEF_BITS));
+        }
+    }
+}
+
+/**
+ * @brief Computes the plane rotation [c s; -s c] * (a, b) = (r, 0), c and s have Q_EIGEN_COEF_BITS fractional bits
+ */
+static void q_eigen_givens(q_t a, q_t b, q_acc_t* c, q_acc_t* s)
+{
+    q_acc_t x[2] = {a, b};
+    q_eigen_normalize(x, 2, (q_acc_t) 1 << (Q_FORM_INT_BITS - 3), x);
+
+    const q_acc_t h = q_isqrt(x[0] * x[0] + x[1] * x[1]);
+    *c = (x[0] * Q_EIGEN_COEF_ONE) / h;
+    *s = (x[1] * Q_EIGEN_COEF_ONE) / h;
+}
+
+/**
+ * @brief Applies a plane rotation to the rows k and k + 1 of the columns [c0, c1) and to the columns k and k + 1 of the
+ * rows [r0, r1), A = G^T * A * G with G = [c -s; s c]. The columns k and k + 1 of Z are rotated too when Z is not NULL.
+ */
+static void q_eigen_rotate(q_matrix_t* A, q_matrix_t* Z, size_t k, q_acc_t c, q_acc_t s, size_t c0, size_t c1, size_t r0,
+                           size_t r1)
+{
+    for(size_t j = c0; j < c1; j++)
+    {
+        const q_t x = Q_MATRIX_AT(A, k, j);
+        const q_t y = Q_MATRIX_AT(A, k + 1, j);
+        Q_MATRIX_AT(A, k, j) = q_saturate(q_eigen_round(c, x, s, y, Q_EIGEN_COEF_BITS));
+        Q_MATRIX_AT(A, k + 1, j) = q_saturate(q_eigen_round(c, y, -s, x, Q_EIGEN_COEF_BITS));
+    }
+
+    for(size_t i = r0; i < r1; i++)
+    {
+        const q_t x = Q_MATRIX_AT(A, i, k);
+        const q_t y = Q_MATRIX_AT(A, i, k + 1);
+        Q_MATRIX_AT(A, i, k) = q_saturate(q_eigen_round(c, x, s, y, Q_EIGEN_COEF_BITS));
+        Q_MATRIX_AT(A, i, k + 1) = q_saturate(q_eigen_round(c, y, -s, x, Q_EIGEN_COEF_BITS));
+    }
+
+    if(Z != NULL)
+    {
+        for(size_t i = 0; i < Z->rows; i++)
+        {
+            const q_t x = Q_MATRIX_AT(Z, i, k);
+            const q_t y = Q_MATRIX_AT(Z, i, k + 1);
+            Q_MATRIX_AT(Z, i, k) = q_saturate(q_eigen_round(c, x, s, y, Q_EIGEN_COEF_BITS));
+            Q_MATRIX_AT(Z, i, k + 1) = q_saturate(q_eigen_round(c, y, -s, x, Q_EIGEN_COEF_BITS));
+        }
+    }
+}
+
+// MARK: Hessenberg reduction
+
+/**
+ * @brief Reduces a square matrix in place to upper Hessenberg form, A = Q * H * Q^T.
+ * @details The reflector j zeroes the column j below the subdiagonal and is applied from both sides. The elements below
+ * the subdiagonal are written as zeros.
+ *
+ * @param A The reference to the matrix, overwritten with H
+ * @param Q The reference to the orthogonal matrix, it may be NULL
+ */
+static void q_eigen_hessenberg(q_matrix_t* A, q_matrix_t* Q)
+{
+    const size_t n = A->rows;
+
+    if(Q != NULL)
+    {
+        q_matrix_identity(Q);
+    }
+
+    if(n < 3)
+    {
+        return;
+    }
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* v = (q_acc_t*) q_arena_alloc(n * sizeof(q_acc_t));
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(n * sizeof(q_acc_t));
+
+    for(size_t j = 0; j + 2 < n; j++)
+    {
+        const size_t len = n - j - 1;
+        for(size_t i = 0; i < len; i++)
+        {
+            v[i] = Q_MATRIX_AT(A, j + 1 + i, j);
+        }
+
+        const q_acc_t tau = q_eigen_house(v, len, v);
+        if(tau == 0)
+        {
+            continue;
+        }
+
+        q_eigen_reflect_left(A, v, len, tau, j + 1, j, n, acc);
+        for(size_t i = j + 2; i < n; i++)
+        {
+            Q_MATRIX_AT(A, i, j) = Q_ZERO;
+        }
+        q_eigen_reflect_right(A, v, len, tau, j + 1, 0, n);
+        if(Q != NULL)
+        {
+            q_eigen_reflect_right(Q, v, len, tau, j + 1, 0, n);
+        }
+    }
+
+    q_arena_release(mark); // Release the reflector and the accumulators
+}
+
+// MARK: Francis QR iterations
+
+/**
+ * @brief Checks whether the subdiagonal element H[k][k-1] is negligible and zeroes it
+ */
+static int q_eigen_negligible(q_matrix_t* H, size_t k, q_t tol)
+{
+    if(q_absolute(Q_MATRIX_AT(H, k, k - 1)) <= tol)
+    {
+        Q_MATRIX_AT(H, k, k - 1) = Q_ZERO;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Splits a converged 2x2 diagonal block with real eigenvalues into two 1x1 blocks.
+ * @details For the block [a b; c d] with p = (a - d) / 2 and p^2 + b * c >= 0, the rotation whose first column is
+ * (lambda - d, c) (the eigenvector of the eigenvalue lambda further from d) makes the block upper triangular. A block with
+ * complex eigenvalues is left unchanged.
+ *
+ * @param H The reference to the quasi triangular matrix
+ * @param Z The reference to the accumulated transformations, it may be NULL
+ * @param k The first row of the block
+ * @param c1 The column after the last one updated by the rotation of the rows
+ * @param r0 The first row updated by the rotation of the columns
+ */
+static void q_eigen_split(q_matrix_t* H, q_matrix_t* Z, size_t k, size_t c1, size_t r0)
+{
+    const q_t a = Q_MATRIX_AT(H, k, k);
+    const q_t b = Q_MATRIX_AT(H, k, k + 1);
+    const q_t c = Q_MATRIX_AT(H, k + 1, k);
+    const q_t d = Q_MATRIX_AT(H, k + 1, k + 1);
+
+    if(c == Q_ZERO)
+    {
+        return;
+    }
+
+    const q_t p = (a - d) / 2;
+    const q_acc_t disc = q_eigen_full(p, p) + q_eigen_full(b, c);
+    if(disc < 0)
+    {
+        return;
+    }
+
+    const q_t root = q_sqrt_acc(disc);
+    const q_t w = (p >= 0) ? (p + root) : (p - root);
+
+    q_acc_t cs, sn;
+    q_eigen_givens(w, c, &cs, &sn);
+    q_eigen_rotate(H, Z, k, cs, sn, k, c1, r0, k + 2);
+    Q_MATRIX_AT(H, k + 1, k) = Q_ZERO;
+}
+
+/**
+ * @brief Performs a Francis implicit double-shift QR step on the active block [l, hi] of a Hessenberg matrix.
+ * @details The shifts are the eigenvalues of the trailing 2x2 block, only their sum s and product p are needed: the first
+ * column of (H - s1 * I) * (H - s2 * I) = H^2 - s * H + p * I has three nonzero elements, computed with full products. Its
+ * reflector creates a bulge that is chased down the subdiagonal by 3x3 reflectors and a final 2x2 one. Every tenth
+ * iteration uses an exceptional shift built from the last subdiagonal elements to break the cycles.
+ *
+ * @param H The reference to the Hessenberg matrix
+ * @param Z The reference to the accumulated transformations, it may be NULL
+ * @param l The first row of the active block
+ * @param hi The last row of the active block, hi >= l + 2
+ * @param iteration The number of iterations on the current active block
+ * @param full Update the whole matrix (Schur form) instead of the active block only (eigenvalues only)
+ * @param acc The accumulators, n elements
+ */
+static void q_eigen_francis_step(q_matrix_t* H, q_matrix_t* Z, size_t l, size_t hi, size_t iteration, int full, q_acc_t* acc)
+{
+    const size_t n = H->rows;
+    const size_t c1 = full ? n : hi + 1;
+    const size_t r0 = full ? 0 : l;
+
+    q_t s;
+    q_acc_t p;
+    if((iteration % 10) == 0)
+    {
+        const q_t w = q_absolute(Q_MATRIX_AT(H, hi, hi - 1)) + q_absolute(Q_MATRIX_AT(H, hi - 1, hi - 2));
+        s = w + w / 2;
+        p = q_eigen_full(w, w);
+    }
+    else
+    {
+        const q_t a = Q_MATRIX_AT(H, hi - 1, hi - 1);
+        const q_t b = Q_MATRIX_AT(H, hi - 1, hi);
+        const q_t c = Q_MATRIX_AT(H, hi, hi - 1);
+        const q_t d = Q_MATRIX_AT(H, hi, hi);
+        s = a + d;
+        p = q_eigen_full(a, d) - q_eigen_full(b, c);
+    }
+
+    const q_t h00 = Q_MATRIX_AT(H, l, l);
+    const q_t h10 = Q_MATRIX_AT(H, l + 1, l);
+    q_acc_t w[3];
+    w[0] = q_eigen_full(h00, h00) + q_eigen_full(Q_MATRIX_AT(H, l, l + 1), h10) - q_eigen_full(s, h00) + p;
+    w[1] = q_eigen_full(h10, h00 + Q_MATRIX_AT(H, l + 1, l + 1) - s);
+    w[2] = q_eigen_full(h10, Q_MATRIX_AT(H, l + 2, l + 1));
+
+    q_acc_t v[3];
+    for(size_t k = l; k + 1 < hi; k++)
+    {
+        if(k > l)
+        {
+            w[0] = Q_MATRIX_AT(H, k, k - 1);
+            w[1] = Q_MATRIX_AT(H, k + 1, k - 1);
+            w[2] = Q_MATRIX_AT(H, k + 2, k - 1);
+        }
+
+        const q_acc_t tau = q_eigen_house(w, 3, v);
+        if(tau == 0)
+        {
+            continue;
+        }
+
+        q_eigen_reflect_left(H, v, 3, tau, k, (k > l) ? k - 1 : l, c1, acc);
+        if(k > l)
+        {
+            Q_MATRIX_AT(H, k + 1, k - 1) = Q_ZERO;
+            Q_MATRIX_AT(H, k + 2, k - 1) = Q_ZERO;
+        }
+        q_eigen_reflect_right(H, v, 3, tau, k, r0, (k + 4 < hi + 1) ? k + 4 : hi + 1);
+        if(Z != NULL)
+        {
+            q_eigen_reflect_right(Z, v, 3, tau, k, 0, n);
+        }
+    }
+
+    w[0] = Q_MATRIX_AT(H, hi - 1, hi - 2);
+    w[1] = Q_MATRIX_AT(H, hi, hi - 2);
+    const q_acc_t tau = q_eigen_house(w, 2, v);
+    if(tau != 0)
+    {
+        q_eigen_reflect_left(H, v, 2, tau, hi - 1, hi - 2, c1, acc);
+        Q_MATRIX_AT(H, hi, hi - 2) = Q_ZERO;
+        q_eigen_reflect_right(H, v, 2, tau, hi - 1, r0, hi + 1);
+        if(Z != NULL)
+        {
+            q_eigen_reflect_right(Z, v, 2, tau, hi - 1, 0, n);
+        }
+    }
+}
+
+/**
+ * @brief Reduces a Hessenberg matrix to real Schur form with Francis double-shift QR iterations.
+ * @details The active block is the bottom block whose subdiagonal has no negligible element. A negligible element at the
+ * bottom deflates a 1x1 block, a 2x2 block at the bottom is split when its eigenvalues are real and kept otherwise. The
+ * iterations stop after Q_EIGEN_MAX_ITERATIONS * n QR steps.
+ *
+ * @param H The reference to the Hessenberg matrix, overwritten with T
+ * @param Z The reference to the accumulated transformations, it may be NULL
+ * @param full Compute the whole Schur form T, otherwise only the diagonal blocks are valid
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge
+ */
+static q_status_t q_eigen_francis(q_matrix_t* H, q_matrix_t* Z, int full)
+{
+    const size_t n = H->rows;
+    const size_t max_steps = Q_EIGEN_MAX_ITERATIONS * n;
+    const q_t tol = q_eigen_tolerance(H);
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(n * sizeof(q_acc_t));
+
+    q_status_t status = Q_MATRIX_OK;
+    size_t steps = 0;
+    size_t iteration = 0;
+    size_t end = n; // The rows [end, n) have converged
+    while(end > 0)
+    {
+        const size_t hi = end - 1;
+
+        size_t l = hi;
+        while((l > 0) && !q_eigen_negligible(H, l, tol))
+        {
+            l--;
+        }
+
+        if(l == hi)
+        {
+            end -= 1;
+            iteration = 0;
+            continue;
+        }
+
+        if(l + 1 == hi)
+        {
+            q_eigen_split(H, Z, l, full ? n : hi + 1, full ? 0 : l);
+            end -= 2;
+            iteration = 0;
+            continue;
+        }
+
+        if(steps++ >= max_steps)
+        {
+            status = Q_MATRIX_ERROR;
+            break;
+        }
+
+        iteration++;
+        q_eigen_francis_step(H, Z, l, hi, iteration, full, acc);
+    }
+
+    q_arena_release(mark); // Release the accumulators
+    return status;
+}
+
+/**
+ * @brief Lists the eigenvalues of a quasi triangular matrix in the order of its diagonal blocks
+ *
+ * @param T The reference to the quasi triangular matrix, the 2x2 blocks have complex eigenvalues
+ * @param blocks The diagonal blocks, at least n elements
+ * @return size_t The number of blocks
+ */
+static size_t q_eigen_blocks(const q_matrix_t* T, q_eigen_block_t* blocks)
+{
+    const size_t n = T->rows;
+
+    size_t count = 0;
+    for(size_t i = 0; i < n; )
+    {
+        q_eigen_block_t* b = &blocks[count++];
+        b->index = i;
+
+        if((i + 1 < n) && (Q_MATRIX_AT(T, i + 1, i) != Q_ZERO))
+        {
+            const q_t a = Q_MATRIX_AT(T, i, i);
+            const q_t d = Q_MATRIX_AT(T, i + 1, i + 1);
+            const q_t p = (a - d) / 2;
+            const q_acc_t disc = q_eigen_full(p, p) + q_eigen_full(Q_MATRIX_AT(T, i, i + 1), Q_MATRIX_AT(T, i + 1, i));
+
+            b->size = 2;
+            b->re = d + p;
+            b->im = (disc < 0) ? q_sqrt_acc(-disc) : Q_ZERO;
+            i += 2;
+        }
+        else
+        {
+            b->size = 1;
+            b->re = Q_MATRIX_AT(T, i, i);
+            b->im = Q_ZERO;
+            i += 1;
+        }
+    }
+
+    return count;
+}
+
+// MARK: Eigenvectors
+
+/**
+ * @brief Divides two complex numbers, x = num / den.
+ * @details The numerator has the scale of the full products and the denominator the fixed point scale, so the quotient has
+ * the fixed point scale. A denominator smaller than Q_EIGEN_TOLERANCE (an eigenvalue repeated in T) is replaced by
+ * Q_EIGEN_TOLERANCE, the solution then grows and is scaled down by the caller.
+ */
+static void q_eigen_divide(q_acc_t nr, q_acc_t ni, q_acc_t dr, q_acc_t di, q_acc_t* xr, q_acc_t* xi)
+{
+    const q_acc_t ar = (dr < 0) ? -dr : dr;
+    const q_acc_t ai = (di < 0) ? -di : di;
+    if(ar + ai < Q_EIGEN_TOLERANCE)
+    {
+        dr = (dr < 0) ? -Q_EIGEN_TOLERANCE : Q_EIGEN_TOLERANCE;
+        di = 0;
+    }
+
+    const q_acc_t den = dr * dr + di * di;
+    *xr = (nr * dr + ni * di) / den;
+    *xi = (ni * dr - nr * di) / den;
+}
+
+/**
+ * @brief Stores new elements of an eigenvector of T. When an element exceeds Q_EIGEN_VECTOR_LIMIT the elements
+ * [i, top] computed so far and the new ones are scaled down by the same power of two.
+ *
+ * @param values The new elements, real and imaginary parts of count elements
+ * @param count The number of new elements, 1 or 2
+ * @param xr The real parts of the eigenvector
+ * @param xi The imaginary parts of the eigenvector
+ * @param i The row of the first new element
+ * @param top The last row of the eigenvector
+ */
+static void q_eigen_store(q_acc_t* values, size_t count, q_t* xr, q_t* xi, size_t i, size_t top)
+{
+    q_acc_t max = 0;
+    for(size_t k = 0; k < 2 * count; k++)
+    {
+        const q_acc_t a = (values[k] < 0) ? -values[k] : values[k];
+        max = (a > max) ? a : max;
+    }
+
+    int shift = 0;
+    while((max >> shift) > Q_EIGEN_VECTOR_LIMIT)
+    {
+        shift++;
+    }
+
+    if(shift > 0)
+    {
+        for(size_t k = i + count; k <= top; k++)
+        {
+            xr[k] >>= shift;
+            xi[k] >>= shift;
+        }
+    }
+
+    for(size_t k = 0; k < count; k++)
+    {
+        xr[i + k] = (q_t) (values[2 * k] >> shift);
+        xi[i + k] = (q_t) (values[2 * k + 1] >> shift);
+    }
+}
+
+/**
+ * @brief Computes the eigenvector of a diagonal block of the real Schur form and writes it to the columns of dst.
+ * @details The eigenvector x of T is found by back substitution: x is (1) at the block of a real eigenvalue lambda, or
+ * the eigenvector of the 2x2 block for a complex pair, and zero below it. Above the block every 1x1 block i solves
+ * (T[i][i] - lambda) * x[i] = -sum(T[i][j] * x[j]) and every 2x2 block the complex 2x2 system of its rows (Cramer's rule).
+ * The eigenvector of A is Z * x, normalized to a unit 2-norm. A real eigenvector is written to the column col, a complex
+ * one to the columns col (real part) and col + 1 (imaginary part).
+ *
+ * @param T The reference to the real Schur form
+ * @param Z The reference to the Schur vectors
+ * @param b The diagonal block
+ * @param dst The reference to the eigenvectors
+ * @param col The first column of the eigenvector in dst
+ */
+static void q_eigen_vector(const q_matrix_t* T, const q_matrix_t* Z, const q_eigen_block_t* b, q_matrix_t* dst, size_t col)
+{
+    const size_t n = T->rows;
+    const size_t k = b->index;
+    const size_t top = k + b->size - 1;
+    const q_t lr = b->re;
+    const q_t li = b->im;
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_t* xr = (q_t*) q_arena_alloc(n * sizeof(q_t));
+    q_t* xi = (q_t*) q_arena_alloc(n * sizeof(q_t));
+    q_acc_t* w = (q_acc_t*) q_arena_alloc(2 * n * sizeof(q_acc_t));
+
+    if(b->size == 1)
+    {
+        xr[k] = Q_ONE;
+        xi[k] = Q_ZERO;
+    }
+    else
+    {
+        const q_t a = Q_MATRIX_AT(T, k, k);
+        const q_t bb = Q_MATRIX_AT(T, k, k + 1);
+        const q_t c = Q_MATRIX_AT(T, k + 1, k);
+        const q_t d = Q_MATRIX_AT(T, k + 1, k + 1);
+
+        if(q_absolute(bb) >= q_absolute(c))
+        {
+            // (a - lambda) * x0 + b * x1 = 0
+            xr[k] = bb;
+            xi[k] = Q_ZERO;
+            xr[k + 1] = lr - a;
+            xi[k + 1] = li;
+        }
+        else
+        {
+            // c * x0 + (d - lambda) * x1 = 0
+            xr[k] = lr - d;
+            xi[k] = li;
+            xr[k + 1] = c;
+            xi[k + 1] = Q_ZERO;
+        }
+    }
+
+    size_t i = k;
+    while(i > 0)
+    {
+        i--;
+
+        q_acc_t r[4] = {0, 0, 0, 0};
+        for(size_t j = i + 1; j <= top; j++)
+        {
+            r[0] += q_eigen_full(Q_MATRIX_AT(T, i, j), xr[j]);
+            r[1] += q_eigen_full(Q_MATRIX_AT(T, i, j), xi[j]);
+        }
+
+        q_acc_t x[4];
+        if((i > 0) && (Q_MATRIX_AT(T, i, i - 1) != Q_ZERO))
+        {
+            // The rows i - 1 and i form a 2x2 block: [alpha beta; gamma delta] * (x0, x1) = -(r0, r1)
+            i--;
+            r[2] = r[0];
+            r[3] = r[1];
+            r[0] = 0;
+            r[1] = 0;
+            for(size_t j = i + 2; j <= top; j++)
+            {
+                r[0] += q_eigen_full(Q_MATRIX_AT(T, i, j), xr[j]);
+                r[1] += q_eigen_full(Q_MATRIX_AT(T, i, j), xi[j]);
+            }
+
+            const q_acc_t ar = Q_MATRIX_AT(T, i, i) - lr;
+            const q_acc_t dr = Q_MATRIX_AT(T, i + 1, i + 1) - lr;
+            const q_acc_t im = -li;
+            const q_acc_t beta = Q_MATRIX_AT(T, i, i + 1);
+            const q_acc_t gamma = Q_MATRIX_AT(T, i + 1, i);
+
+            // Determinant alpha * delta - beta * gamma, brought back to the fixed point scale
+            const q_acc_t det_r = (ar * dr - im * im - beta * gamma) >> FRACTIONAL_BITS;
+            const q_acc_t det_i = (ar * im + im * dr) >> FRACTIONAL_BITS;
+
+            const q_acc_t r0r = r[0] >> FRACTIONAL_BITS;
+            const q_acc_t r0i = r[1] >> FRACTIONAL_BITS;
+            const q_acc_t r1r = r[2] >> FRACTIONAL_BITS;
+            const q_acc_t r1i = r[3] >> FRACTIONAL_BITS;
+
+            // x0 = (beta * r1 - delta * r0) / det, x1 = (gamma * r0 - alpha * r1) / det
+            q_eigen_divide(beta * r1r - (dr * r0r - im * r0i), beta * r1i - (dr * r0i + im * r0r), det_r, det_i, &x[0], &x[1]);
+            q_eigen_divide(gamma * r0r - (ar * r1r - im * r1i), gamma * r0i - (ar * r1i + im * r1r), det_r, det_i, &x[2], &x[3]);
+            q_eigen_store(x, 2, xr, xi, i, top);
+        }
+        else
+        {
+            q_eigen_divide(-r[0], -r[1], Q_MATRIX_AT(T, i, i) - lr, -li, &x[0], &x[1]);
+            q_eigen_store(x, 1, xr, xi, i, top);
+        }
+    }
+
+    // v = Z * x, normalized
+    for(size_t row = 0; row < n; row++)
+    {
+        q_acc_t sr = 0;
+        q_acc_t si = 0;
+        for(size_t j = 0; j <= top; j++)
+        {
+            const q_t z = Q_MATRIX_AT(Z, row, j);
+            sr += q_eigen_full(z, xr[j]);
+            si += q_eigen_full(z, xi[j]);
+        }
+        w[row] = sr;
+        w[n + row] = si;
+    }
+
+    q_eigen_normalize(w, 2 * n, Q_EIGEN_LOW, w);
+    q_acc_t sum = 0;
+    for(size_t j = 0; j < 2 * n; j++)
+    {
+        sum += w[j] * w[j];
+    }
+    const q_divisor_t norm = q_divisor_prepare(q_sqrt_acc(sum));
+
+    for(size_t row = 0; row < n; row++)
+    {
+        Q_MATRIX_AT(dst, row, col) = q_division_prepared((q_t) w[row], norm);
+        if(b->size == 2)
+        {
+            Q_MATRIX_AT(dst, row, col + 1) = q_division_prepared((q_t) w[n + row], norm);
+        }
+    }
+
+    q_arena_release(mark); // Release the eigenvector of T
+}
+
+// MARK: Jacobi rotations
+
+/**
+ * @brief Diagonalizes a symmetric matrix in place with cyclic Jacobi rotations, A = V * D * V^T.
+ * @details Every off-diagonal pair (p, q) larger than Q_EIGEN_TOLERANCE is zeroed by the rotation
+ * t = sign(d) * 2 * A[p][q] / (|d| + sqrt(d^2 + 4 * A[p][q]^2)) with d = A[q][q] - A[p][p], c = 1 / sqrt(1 + t^2),
+ * s = t * c, the form of the smaller rotation angle that does not overflow when A[p][q] is tiny. t, c and s have
+ * Q_EIGEN_COEF_BITS fractional bits. The sweeps stop when no pair was rotated.
+ *
+ * @param A The reference to the symmetric matrix, overwritten with D (and rounding residues off the diagonal)
+ * @param V The reference to the eigenvectors, it may be NULL
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR after Q_EIGEN_MAX_SWEEPS sweeps without convergence
+ */
+static q_status_t q_eigen_jacobi(q_matrix_t* A, q_matrix_t* V)
+{
+    const size_t n = A->rows;
+    const q_acc_t one = Q_EIGEN_COEF_ONE;
+
+    if(V != NULL)
+    {
+        q_matrix_identity(V);
+    }
+
+    for(size_t sweep = 0; sweep < Q_EIGEN_MAX_SWEEPS; sweep++)
+    {
+        int rotated = 0;
+
+        for(size_t p = 0; p < n; p++)
+        {
+            for(size_t q = p + 1; q < n; q++)
+            {
+                const q_t apq = Q_MATRIX_AT(A, p, q);
+                if(q_absolute(apq) <= Q_EIGEN_TOLERANCE)
+                {
+                    continue;
+                }
+                rotated = 1;
+
+                const q_t app = Q_MATRIX_AT(A, p, p);
+                const q_t aqq = Q_MATRIX_AT(A, q, q);
+                const q_t d = aqq - app;
+                const q_t root = q_sqrt_acc(q_eigen_full(d, d) + 4 * q_eigen_full(apq, apq));
+                const q_acc_t t = (((d >= 0) ? 2 * (q_acc_t) apq : -2 * (q_acc_t) apq) * one) / (q_absolute(d) + root);
+                const q_acc_t c = (one * one) / q_isqrt(one * one + t * t);
+                const q_acc_t s = q_eigen_round(t, c, 0, 0, Q_EIGEN_COEF_BITS);
+
+                const q_t shift = (q_t) q_eigen_round(t, apq, 0, 0, Q_EIGEN_COEF_BITS);
+                Q_MATRIX_AT(A, p, p) = app - shift;
+                Q_MATRIX_AT(A, q, q) = aqq + shift;
+                Q_MATRIX_AT(A, p, q) = Q_ZERO;
+                Q_MATRIX_AT(A, q, p) = Q_ZERO;
+
+                for(size_t r = 0; r < n; r++)
+                {
+                    if((r == p) || (r == q))
+                    {
+                        continue;
+                    }
+
+                    const q_t arp = Q_MATRIX_AT(A, r, p);
+                    const q_t arq = Q_MATRIX_AT(A, r, q);
+                    const q_t np = q_saturate(q_eigen_round(c, arp, -s, arq, Q_EIGEN_COEF_BITS));
+                    const q_t nq = q_saturate(q_eigen_round(s, arp, c, arq, Q_EIGEN_COEF_BITS));
+                    Q_MATRIX_AT(A, r, p) = np;
+                    Q_MATRIX_AT(A, p, r) = np;
+                    Q_MATRIX_AT(A, r, q) = nq;
+                    Q_MATRIX_AT(A, q, r) = nq;
+                }
+
+                if(V != NULL)
+                {
+                    for(size_t r = 0; r < n; r++)
+                    {
+                        const q_t vrp = Q_MATRIX_AT(V, r, p);
+                        const q_t vrq = Q_MATRIX_AT(V, r, q);
+                        Q_MATRIX_AT(V, r, p) = q_saturate(q_eigen_round(c, vrp, -s, vrq, Q_EIGEN_COEF_BITS));
+                        Q_MATRIX_AT(V, r, q) = q_saturate(q_eigen_round(s, vrp, c, vrq, Q_EIGEN_COEF_BITS));
+                    }
+                }
+            }
+        }
+
+        if(!rotated)
+        {
+            return Q_MATRIX_OK;
+        }
+    }
+
+    return Q_MATRIX_ERROR;
+}
+
+// MARK: Symmetric tridiagonal QR iterations
+
+/**
+ * @brief Reduces a symmetric matrix in place to symmetric tridiagonal form, A = Q * T * Q^T.
+ * @details The Hessenberg reduction of a symmetric matrix is tridiagonal up to the rounding of the reflectors, the residues
+ * above the superdiagonal are dropped and the superdiagonal is taken from the subdiagonal.
+ *
+ * @param A The reference to the symmetric matrix, overwritten with T
+ * @param Q The reference to the orthogonal matrix, it may be NULL
+ */
+static void q_eigen_tridiagonal(q_matrix_t* A, q_matrix_t* Q)
+{
+    const size_t n = A->rows;
+
+    q_eigen_hessenberg(A, Q);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = i + 2; j < n; j++)
+        {
+            Q_MATRIX_AT(A, i, j) = Q_ZERO;
+        }
+        if(i + 1 < n)
+        {
+            Q_MATRIX_AT(A, i, i + 1) = Q_MATRIX_AT(A, i + 1, i);
+        }
+    }
+}
+
+/**
+ * @brief Performs a symmetric QR step with the Wilkinson shift on the active block [l, hi] of a tridiagonal matrix.
+ * @details The shift is the eigenvalue of the trailing 2x2 block closer to T[hi][hi],
+ * mu = c - b^2 / (d + sign(d) * sqrt(d^2 + b^2)) with d = (a - c) / 2. The step is explicit, T - mu * I = Q * R and
+ * T = R * Q + mu * I: the implicit step chases a bulge of about the product of two subdiagonal elements over the distance
+ * to the shift, below one LSB it rounds to zero and the iterations stall. The shift is exact in fixed point and the
+ * elements of R are representable. The rows of R have three elements and only the diagonal and the subdiagonal of R * Q
+ * are computed, the superdiagonal is copied.
+ *
+ * @param T The reference to the tridiagonal matrix
+ * @param Z The reference to the accumulated transformations, it may be NULL
+ * @param l The first row of the active block
+ * @param hi The last row of the active block, hi >= l + 2
+ * @param rotations The cosines and sines of the rotations, 2 * n elements
+ */
+static void q_eigen_tridiagonal_step(q_matrix_t* T, q_matrix_t* Z, size_t l, size_t hi, q_acc_t* rotations)
+{
+    const q_t a = Q_MATRIX_AT(T, hi - 1, hi - 1);
+    const q_t b = Q_MATRIX_AT(T, hi, hi - 1);
+    const q_t c = Q_MATRIX_AT(T, hi, hi);
+    const q_t d = (a - c) / 2;
+    const q_t root = q_sqrt_acc(q_eigen_full(d, d) + q_eigen_full(b, b));
+    const q_t mu = c - (q_t) (q_eigen_full(b, b) / ((d >= 0) ? (d + root) : (d - root)));
+
+    for(size_t i = l; i <= hi; i++)
+    {
+        Q_MATRIX_AT(T, i, i) = q_saturate((q_long_t) Q_MATRIX_AT(T, i, i) - mu);
+    }
+
+    // R = Q^T * (T - mu * I), the row k of R has the elements k, k + 1 and k + 2
+    for(size_t k = l; k < hi; k++)
+    {
+        q_acc_t* cs = &rotations[2 * k];
+        q_eigen_givens(Q_MATRIX_AT(T, k, k), Q_MATRIX_AT(T, k + 1, k), &cs[0], &cs[1]);
+
+        const size_t c1 = (k + 3 < hi + 1) ? k + 3 : hi + 1;
+        q_eigen_rotate(T, NULL, k, cs[0], cs[1], k, c1, 0, 0);
+        Q_MATRIX_AT(T, k + 1, k) = Q_ZERO;
+    }
+
+    // R * Q, the rows above the superdiagonal are not needed
+    for(size_t k = l; k < hi; k++)
+    {
+        const q_acc_t* cs = &rotations[2 * k];
+        q_eigen_rotate(T, Z, k, cs[0], cs[1], 0, 0, (k > l) ? k - 1 : l, k + 2);
+    }
+
+    for(size_t i = l; i <= hi; i++)
+    {
+        Q_MATRIX_AT(T, i, i) = q_saturate((q_long_t) Q_MATRIX_AT(T, i, i) + mu);
+        if(i < hi)
+        {
+            Q_MATRIX_AT(T, i, i + 1) = Q_MATRIX_AT(T, i + 1, i);
+        }
+        if(i + 1 < hi)
+        {
+            Q_MATRIX_AT(T, i, i + 2) = Q_ZERO;
+        }
+    }
+}
+
+/**
+ * @brief Diagonalizes a symmetric tridiagonal matrix with shifted QR steps, T = Z * D * Z^T.
+ * @details The active block is the bottom block whose subdiagonal has no negligible element (see q_eigen_tolerance), a 1x1
+ * block at the bottom deflates and a 2x2 block is diagonalized by one rotation. The iterations stop after
+ * Q_EIGEN_MAX_ITERATIONS * n QR steps.
+ *
+ * @param T The reference to the tridiagonal matrix, overwritten with D (and rounding residues off the diagonal)
+ * @param Z The reference to the accumulated transformations, it may be NULL
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge
+ */
+static q_status_t q_eigen_tridiagonal_qr(q_matrix_t* T, q_matrix_t* Z)
+{
+    const size_t n = T->rows;
+    const size_t max_steps = Q_EIGEN_MAX_ITERATIONS * n;
+    const q_t tol = q_eigen_tolerance(T);
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* rotations = (q_acc_t*) q_arena_alloc(2 * n * sizeof(q_acc_t));
+
+    q_status_t status = Q_MATRIX_OK;
+    size_t steps = 0;
+    size_t end = n; // The rows [end, n) have converged
+    while(end > 0)
+    {
+        const size_t hi = end - 1;
+
+        size_t l = hi;
+        while((l > 0) && !q_eigen_negligible(T, l, tol))
+        {
+            l--;
+        }
+        if(l > 0)
+        {
+            Q_MATRIX_AT(T, l - 1, l) = Q_ZERO;
+        }
+
+        if(l == hi)
+        {
+            end -= 1;
+            continue;
+        }
+
+        if(l + 1 == hi)
+        {
+            q_eigen_split(T, Z, l, hi + 1, l);
+            end -= 2;
+            continue;
+        }
+
+        if(steps++ >= max_steps)
+        {
+            status = Q_MATRIX_ERROR;
+            break;
+        }
+
+        q_eigen_tridiagonal_step(T, Z, l, hi, rotations);
+    }
+
+    q_arena_release(mark); // Release the rotations
+    return status;
+}
+
+/**
+ * @brief Diagonalizes a scaled symmetric matrix in place, A = V * D * V^T, with the selected method.
+ * @details Q_EIGEN_AUTO takes the Jacobi rotations up to Q_EIGEN_JACOBI_MAX rows and the tridiagonal QR iterations above.
+ *
+ * @param A The reference to the symmetric matrix, overwritten with D (and rounding residues off the diagonal)
+ * @param V The reference to the eigenvectors, it may be NULL
+ * @param method The method
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge
+ */
+static q_status_t q_eigen_symmetric(q_matrix_t* A, q_matrix_t* V, q_eigen_method_t method)
+{
+    if(method == Q_EIGEN_AUTO)
+    {
+        method = (A->rows <= Q_EIGEN_JACOBI_MAX) ? Q_EIGEN_JACOBI : Q_EIGEN_TRIDIAGONAL_QR;
+    }
+
+    if(method == Q_EIGEN_JACOBI)
+    {
+        return q_eigen_jacobi(A, V);
+    }
+
+    q_eigen_tridiagonal(A, V);
+    return q_eigen_tridiagonal_qr(A, V);
+}
+
+// MARK: Batched 3x3 symmetric kernel
+
+// The kernel works on blocks of up to Q_EIGEN3_BLOCK matrices, every step is a loop over the matrices of the block without
+// branches, which the compiler turns into vector instructions. The scaled elements and the coefficients are int32_t and
+// the products int64_t: the widening 32 x 32 bits products exist on every vector instruction set, the 64 x 64 bits ones do
+// not. A product is narrowed with an unsigned shift, which gives the same bits as the arithmetic shift as long as the
+// result fits in 32 bits (AVX2 has no 64 bits arithmetic shift).
+
+// Largest element of the scaled matrices is in [2^(Q_EIGEN3_SCALE_BITS - 1), 2^Q_EIGEN3_SCALE_BITS): the Frobenius norm
+// and so the eigenvalues and the differences of diagonal elements stay below 2^30
+#define Q_EIGEN3_SCALE_BITS 27
+
+// Coefficients of the rotations (Q30, 1.0 = 2^30), the reciprocal square roots are Q29
+#define Q_EIGEN3_ONE ((int32_t) 1 << 30)
+
+// Row of the element (i, j) in the upper triangle rows (a00, a01, a02, a11, a12, a22)
+#define Q_EIGEN3_INDEX(__I__, __J__) (((__I__) <= (__J__)) ? ((__I__) * (5 - (__I__)) / 2 + (__J__)) : ((__J__) * (5 - (__J__)) / 2 + (__I__)))
+
+#define Q_EIGEN3_NARROW(__P__, __SHIFT__) ((int32_t) ((uint64_t) (__P__) >> (__SHIFT__)))
+
+/**
+ * @brief Computes 1 / sqrt(m) of every matrix of the block, m in Q30 in [1/4, 1], the result in Q29.
+ * @details Linear seed 2.13 - 1.2175 * m (relative error below 9 %) and four Newton steps y = y * (3 - m * y^2) / 2, the
+ * last one is limited by the rounding.
+ */
+static inline __attribute__((always_inline)) void q_eigen3_rsqrt(const int32_t* m, int32_t* y, size_t count)
+{
+    for(size_t l = 0; l < count; l++)
+    {
+        y[l] = 1143535043 - Q_EIGEN3_NARROW((int64_t) 653640335 * m[l], 30); // 2.13 and 1.2175 in Q29
+    }
+
+    for(size_t step = 0; step < 4; step++)
+    {
+        for(size_t l = 0; l < count; l++)
+        {
+            const int32_t y2 = Q_EIGEN3_NARROW((int64_t) y[l] * y[l], 30);              // Q28
+            const int32_t t = 3 * (1 << 29) - Q_EIGEN3_NARROW((int64_t) m[l] * y2, 29); // Q29
+            y[l] = Q_EIGEN3_NARROW((int64_t) y[l] * t, 30);
+        }
+    }
+}
+
+/**
+ * @brief Applies the Jacobi rotation that zeroes the element (p, q) of every matrix of the block, k is the third index.
+ * @details With x = A[q][q] - A[p][p] and y = 2 * A[p][q], the rotation angle of magnitude at most pi/4 has
+ * cos(2 theta) = |x| / r and sin(2 theta) = sign(x) * y / r, r = sqrt(x^2 + y^2). r^2 is shifted by an even amount 2 * e into
+ * [2^60, 2^62) for the reciprocal square root, |x| and |y| are shifted by e so the quotients need no variable shift.
+ * c = sqrt((1 + cos(2 theta)) / 2) and s = sin(2 theta) / (2 * c) come from 1 / c. The diagonal is updated with
+ * A[p][p] += s^2 * x - A[p][q] * sin(2 theta) and the opposite for A[q][q], which does not need tan(theta).
+ */
+static inline __attribute__((always_inline)) void q_eigen3_rotate(int32_t (*a)[Q_EIGEN3_BLOCK], int32_t (*v)[Q_EIGEN3_BLOCK],
+    size_t count, size_t p, size_t q, size_t k)
+{
+    const size_t pp = Q_EIGEN3_INDEX(p, p), qq = Q_EIGEN3_INDEX(q, q), pq = Q_EIGEN3_INDEX(p, q);
+    const size_t kp = Q_EIGEN3_INDEX(k, p), kq = Q_EIGEN3_INDEX(k, q);
+
+    int32_t m[Q_EIGEN3_BLOCK], inv[Q_EIGEN3_BLOCK], cos2[Q_EIGEN3_BLOCK], sin2[Q_EIGEN3_BLOCK], c2[Q_EIGEN3_BLOCK];
+
+    for(size_t l = 0; l < count; l++)
+    {
+        const int32_t x = a[qq][l] - a[pp][l];
+        const int32_t y = 2 * a[pq][l];
+        const int32_t ax = ((x < 0) ? -x : x) | ((x | y) == 0); // r = 1 when there is nothing to rotate
+        const int32_t ay = (y < 0) ? -y : y;
+
+        uint64_t r2 = (uint64_t) ((int64_t) ax * ax + (int64_t) ay * ay);
+        uint32_t e = 0, small;
+        small = r2 < ((uint64_t) 1 << 30); r2 = small ? (r2 << 32) : r2; e += small ? 16 : 0;
+        small = r2 < ((uint64_t) 1 << 46); r2 = small ? (r2 << 16) : r2; e += small ? 8 : 0;
+        small = r2 < ((uint64_t) 1 << 54); r2 = small ? (r2 << 8) : r2; e += small ? 4 : 0;
+        small = r2 < ((uint64_t) 1 << 58); r2 = small ? (r2 << 4) : r2; e += small ? 2 : 0;
+        small = r2 < ((uint64_t) 1 << 60); r2 = small ? (r2 << 2) : r2; e += small ? 1 : 0;
+
+        m[l] = (int32_t) (r2 >> 32);
+        cos2[l] = (int32_t) ((uint32_t) ax << e); // r * 2^e < 2^31
+        sin2[l] = (int32_t) ((uint32_t) ay << e);
+        sin2[l] = ((x < 0) != (y < 0)) ? -sin2[l] : sin2[l]; // sign(x) * y with sign(0) = 1
+    }
+
+    q_eigen3_rsqrt(m, inv, count);
+
+    for(size_t l = 0; l < count; l++)
+    {
+        cos2[l] = Q_EIGEN3_NARROW((int64_t) cos2[l] * inv[l] + (1 << 29), 30);
+        sin2[l] = Q_EIGEN3_NARROW((int64_t) sin2[l] * inv[l] + (1 << 29), 30);
+        c2[l] = (int32_t) (((uint32_t) Q_EIGEN3_ONE + (uint32_t) cos2[l]) >> 1); // c^2 in [1/2, 1], 2^31 does not fit int32_t
+    }
+
+    q_eigen3_rsqrt(c2, inv, count);
+
+    for(size_t l = 0; l < count; l++)
+    {
+        const int32_t c = Q_EIGEN3_NARROW((int64_t) c2[l] * inv[l] + (1 << 28), 29);
+        const int32_t s = Q_EIGEN3_NARROW((int64_t) sin2[l] * inv[l] + (1 << 29), 30);
+        const int32_t x = a[qq][l] - a[pp][l];
+        const int32_t delta = Q_EIGEN3_NARROW((int64_t) (Q_EIGEN3_ONE - c2[l]) * x - (int64_t) a[pq][l] * sin2[l] + (1 << 29), 30);
+
+        a[pp][l] += delta;
+        a[qq][l] -= delta;
+        a[pq][l] = 0;
+
+        const int32_t akp = a[kp][l], akq = a[kq][l];
+        a[kp][l] = Q_EIGEN3_NARROW((int64_t) c * akp - (int64_t) s * akq + (1 << 29), 30);
+        a[kq][l] = Q_EIGEN3_NARROW((int64_t) s * akp + (int64_t) c * akq + (1 << 29), 30);
+
+        for(size_t i = 0; i < 3; i++)
+        {
+            const int32_t vp = v[3 * i + p][l], vq = v[3 * i + q][l];
+            v[3 * i + p][l] = Q_EIGEN3_NARROW((int64_t) c * vp - (int64_t) s * vq + (1 << 29), 30);
+            v[3 * i + q][l] = Q_EIGEN3_NARROW((int64_t) s * vp + (int64_t) c * vq + (1 << 29), 30);
+        }
+    }
+}
+
+/**
+ * @brief Swaps the eigenvalues i and j and their eigenvectors in the matrices where the eigenvalue i is the smaller one.
+ */
+static inline __attribute__((always_inline)) void q_eigen3_order(int32_t (*a)[Q_EIGEN3_BLOCK], int32_t (*v)[Q_EIGEN3_BLOCK],
+    size_t count, size_t i, size_t j)
+{
+    const size_t ii = Q_EIGEN3_INDEX(i, i), jj = Q_EIGEN3_INDEX(j, j);
+
+    for(size_t l = 0; l < count; l++)
+    {
+        const int32_t ai = a[ii][l], aj = a[jj][l];
+        const int swap = ai < aj;
+        a[ii][l] = swap ? aj : ai;
+        a[jj][l] = swap ? ai : aj;
+
+        for(size_t r = 0; r < 3; r++)
+        {
+            const int32_t vi = v[3 * r + i][l], vj = v[3 * r + j][l];
+            v[3 * r + i][l] = swap ? vj : vi;
+            v[3 * r + j][l] = swap ? vi : vj;
+        }
+    }
+}
+
+/**
+ * @brief Diagonalizes a block of symmetric 3x3 matrices with Q_EIGEN3_SWEEPS sweeps of cyclic Jacobi rotations.
+ * @details Every matrix is scaled by a power of two so its largest element is in [2^26, 2^27), which keeps about 27
+ * significant bits whatever the Q format and the magnitude. The eigenvalues are sorted in decreasing order, scaled back and
+ * saturated, the eigenvectors (Q30 during the rotations) are rounded to the Q format.
+ *
+ * @param in The upper triangles of the matrices, one row per element
+ * @param values The eigenvalues, one row per eigenvalue
+ * @param vectors The eigenvectors, the row 3 * i + j holds the component i of the eigenvector j, it may be NULL
+ * @param count The number of matrices in the block
+ */
+static inline __attribute__((always_inline)) void q_eigen3_block(q_t (*in)[Q_EIGEN3_BLOCK], q_t (*values)[Q_EIGEN3_BLOCK],
+    q_t (*vectors)[Q_EIGEN3_BLOCK], size_t count)
+{
+    int32_t a[6][Q_EIGEN3_BLOCK], v[9][Q_EIGEN3_BLOCK], exponent[Q_EIGEN3_BLOCK];
+
+    for(size_t l = 0; l < count; l++)
+    {
+        uint32_t bits = 0; // Same bit length as the largest magnitude
+        for(size_t e = 0; e < 6; e++)
+        {
+            bits |= (in[e][l] < 0) ? (0u - (uint32_t) in[e][l]) : (uint32_t) in[e][l];
+        }
+
+        int32_t length = 0, high;
+        high = (bits >> 16) != 0; bits = high ? (bits >> 16) : bits; length += high ? 16 : 0;
+        high = (bits >> 8) != 0;  bits = high ? (bits >> 8) : bits;  length += high ? 8 : 0;
+        high = (bits >> 4) != 0;  bits = high ? (bits >> 4) : bits;  length += high ? 4 : 0;
+        high = (bits >> 2) != 0;  bits = high ? (bits >> 2) : bits;  length += high ? 2 : 0;
+        high = (bits >> 1) != 0;  bits = high ? (bits >> 1) : bits;  length += high ? 1 : 0;
+        exponent[l] = Q_EIGEN3_SCALE_BITS - length - (int32_t) bits;
+    }
+
+    for(size_t e = 0; e < 6; e++)
+    {
+        for(size_t l = 0; l < count; l++)
+        {
+            const int32_t x = in[e][l];
+            const int32_t up = (exponent[l] > 0) ? exponent[l] : 0;
+            const int32_t down = (exponent[l] < 0) ? -exponent[l] : 1;
+            const int32_t rounded = ((x >> (down - 1)) + 1) >> 1; // Rounded x / 2^down without overflow
+            a[e][l] = (exponent[l] >= 0) ? (int32_t) ((uint32_t) x << up) : rounded; // x * 2^up fits in 32 bits
+        }
+    }
+
+    for(size_t e = 0; e < 9; e++)
+    {
+        for(size_t l = 0; l < count; l++)
+        {
+            v[e][l] = ((e % 4) == 0) ? Q_EIGEN3_ONE : 0;
+        }
+    }
+
+    for(size_t sweep = 0; sweep < Q_EIGEN3_SWEEPS; sweep++)
+    {
+        q_eigen3_rotate(a, v, count, 0, 1, 2);
+        q_eigen3_rotate(a, v, count, 0, 2, 1);
+        q_eigen3_rotate(a, v, count, 1, 2, 0);
+    }
+
+    q_eigen3_order(a, v, count, 0, 1);
+    q_eigen3_order(a, v, count, 1, 2);
+    q_eigen3_order(a, v, count, 0, 1);
+
+    for(size_t i = 0; i < 3; i++)
+    {
+        for(size_t l = 0; l < count; l++)
+        {
+            const int32_t x = a[Q_EIGEN3_INDEX(i, i)][l];
+            const int32_t down = (exponent[l] > 0) ? exponent[l] : 1;
+            const int64_t up = (int64_t) ((uint64_t) (int64_t) x << ((exponent[l] < 0) ? -exponent[l] : 0));
+            const int64_t y = (exponent[l] > 0) ? (((x >> (down - 1)) + 1) >> 1) : up;
+            values[i][l] = (y > Q_RAW_MAX) ? Q_RAW_MAX : ((y < Q_RAW_MIN) ? Q_RAW_MIN : (q_t) y);
+        }
+    }
+
+    if(vectors != NULL)
+    {
+        for(size_t e = 0; e < 9; e++)
+        {
+            for(size_t l = 0; l < count; l++)
+            {
+#if FRACTIONAL_BITS <= 30
+                const int32_t y = (v[e][l] + ((1 << (30 - FRACTIONAL_BITS)) >> 1)) >> (30 - FRACTIONAL_BITS);
+#else
+                const int64_t y = (int64_t) v[e][l] << (FRACTIONAL_BITS - 30);
+#endif
+                vectors[e][l] = (y > Q_RAW_MAX) ? Q_RAW_MAX : ((y < Q_RAW_MIN) ? Q_RAW_MIN : (q_t) y);
+            }
+        }
+    }
+}
+
+static void q_eigen3_block_scalar(q_t (*in)[Q_EIGEN3_BLOCK], q_t (*values)[Q_EIGEN3_BLOCK], q_t (*vectors)[Q_EIGEN3_BLOCK],
+    size_t count)
+{
+    q_eigen3_block(in, values, vectors, count);
+}
+
+#if Q_SIMD_X86
+__attribute__((target("avx2")))
+static void q_eigen3_block_avx2(q_t (*in)[Q_EIGEN3_BLOCK], q_t (*values)[Q_EIGEN3_BLOCK], q_t (*vectors)[Q_EIGEN3_BLOCK],
+    size_t count)
+{
+    q_eigen3_block(in, values, vectors, count);
+}
+#endif // Q_SIMD_X86
+
+// MARK: Public functions
+
+/**
+ * @brief This function reduces a square matrix to upper Hessenberg form with Householder reflectors, A = Q * H * Q^T.
+ * @details H is zero below the subdiagonal. The eigenvalues of H are the eigenvalues of A.
+ *
+ * @param m The reference to the square matrix, it may be H
+ * @param H The reference to the Hessenberg matrix
+ * @param Q The reference to the orthogonal matrix, it may be NULL
+ */
+void q_matrix_hessenberg(const q_matrix_t* m, q_matrix_t* H, q_matrix_t* Q)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(H);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when performing Hessenberg reduction");
+    assert((H->rows == m->rows) && (H->cols == m->cols) && "Hessenberg matrix has not the shape of the matrix");
+    assert(((Q == NULL) || ((Q->rows == m->rows) && (Q->cols == m->cols))) && "Orthogonal matrix has not the shape of the matrix");
+
+    if(H->elements != m->elements)
+    {
+        q_matrix_cpy(m, H);
+    }
+
+    q_eigen_hessenberg(H, Q);
+}
+
+/**
+ * @brief This function computes the real Schur form of a square matrix, A = Z * T * Z^T.
+ * @details T is quasi upper triangular: the real eigenvalues are 1x1 blocks of the diagonal and every complex conjugate
+ * pair a 2x2 block (its subdiagonal element is not zero). The matrix is scaled by a power of two, reduced to Hessenberg
+ * form and iterated with Francis double-shift QR steps, T is scaled back.
+ *
+ * @param m The reference to the square matrix, it may be T
+ * @param T The reference to the quasi triangular matrix
+ * @param Z The reference to the orthogonal Schur vectors, it may be NULL
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge
+ */
+q_status_t q_matrix_schur(const q_matrix_t* m, q_matrix_t* T, q_matrix_t* Z)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(T);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when computing the Schur form");
+    assert((T->rows == m->rows) && (T->cols == m->cols) && "Schur form has not the shape of the matrix");
+    assert(((Z == NULL) || ((Z->rows == m->rows) && (Z->cols == m->cols))) && "Schur vectors have not the shape of the matrix");
+
+    const size_t n = m->rows;
+    const int exponent = q_eigen_scale(m, T);
+
+    q_eigen_hessenberg(T, Z);
+    const q_status_t status = q_eigen_francis(T, Z, 1);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            Q_MATRIX_AT(T, i, j) = q_eigen_unscale(Q_MATRIX_AT(T, i, j), exponent);
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief This function computes the eigenvalues and optionally the eigenvectors of a square matrix.
+ * @details An exactly symmetric matrix takes the path of q_matrix_eigen_symmetric, any other matrix goes through the real
+ * Schur form (see fix_point_eigen.h for the output formats). Without eigenvectors only the active block of the Schur
+ * iterations is updated.
+ *
+ * @example
+ * q_matrix_t m = q_matrix_alloc(3, 3);
+ * q_matrix_t values = q_matrix_alloc(3, 2);
+ * ...
+ * if(q_matrix_eigen(&m, &values, NULL) == Q_MATRIX_OK) { ... }
+ *
+ * @param m The reference to the square matrix
+ * @param values The reference to the n x 2 eigenvalues, (re, im) per row
+ * @param vectors The reference to the n x n eigenvectors, it may be NULL
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge (the outputs hold the last
+ * estimates)
+ */
+q_status_t q_matrix_eigen(const q_matrix_t* m, q_matrix_t* values, q_matrix_t* vectors)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(values);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when computing the eigenvalues");
+    assert((values->rows == m->rows) && (values->cols == 2) && "Eigenvalues are not a n x 2 matrix");
+    assert(((vectors == NULL) || ((vectors->rows == m->rows) && (vectors->cols == m->cols))) && "Eigenvectors have not the shape of the matrix");
+
+    const size_t n = m->rows;
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t A = q_arena_matrix_alloc(n, n);
+    q_matrix_t Z = {0};
+    if(vectors != NULL)
+    {
+        Z = q_arena_matrix_alloc(n, n);
+    }
+    q_eigen_block_t* blocks = (q_eigen_block_t*) q_arena_alloc(n * sizeof(q_eigen_block_t));
+
+    const int exponent = q_eigen_scale(m, &A);
+    const int symmetric = q_eigen_is_symmetric(m);
+
+    q_status_t status;
+    size_t count;
+    if(symmetric)
+    {
+        status = q_eigen_symmetric(&A, (vectors != NULL) ? &Z : NULL, Q_EIGEN_AUTO);
+        for(size_t i = 0; i < n; i++)
+        {
+            blocks[i] = (q_eigen_block_t) {i, 1, Q_MATRIX_AT(&A, i, i), Q_ZERO};
+        }
+        count = n;
+    }
+    else
+    {
+        q_eigen_hessenberg(&A, (vectors != NULL) ? &Z : NULL);
+        status = q_eigen_francis(&A, (vectors != NULL) ? &Z : NULL, vectors != NULL);
+        count = q_eigen_blocks(&A, blocks);
+    }
+
+    q_eigen_sort(blocks, count);
+
+    size_t row = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        const q_eigen_block_t* b = &blocks[i];
+
+        Q_MATRIX_AT(values, row, 0) = q_eigen_unscale(b->re, exponent);
+        Q_MATRIX_AT(values, row, 1) = q_eigen_unscale(b->im, exponent);
+        if(b->size == 2)
+        {
+            Q_MATRIX_AT(values, row + 1, 0) = Q_MATRIX_AT(values, row, 0);
+            Q_MATRIX_AT(values, row + 1, 1) = -Q_MATRIX_AT(values, row, 1);
+        }
+
+        if(vectors != NULL)
+        {
+            if(symmetric)
+            {
+                for(size_t r = 0; r < n; r++)
+                {
+                    Q_MATRIX_AT(vectors, r, row) = Q_MATRIX_AT(&Z, r, b->index);
+                }
+            }
+            else
+            {
+                q_eigen_vector(&A, &Z, b, vectors, row);
+            }
+        }
+
+        row += b->size;
+    }
+
+    q_arena_release(mark); // Release the scaled matrix, the Schur vectors and the blocks
+    return status;
+}
+
+/**
+ * @brief This function computes the eigenvalues and optionally the eigenvectors of a symmetric matrix.
+ * @details Same as q_matrix_eigen_symmetric_method with Q_EIGEN_AUTO: cyclic Jacobi rotations up to Q_EIGEN_JACOBI_MAX
+ * rows, Householder tridiagonalization and shifted symmetric QR steps above.
+ *
+ * @param m The reference to the symmetric matrix
+ * @param values The reference to the n x 1 eigenvalues
+ * @param vectors The reference to the n x n eigenvectors, it may be NULL
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge
+ */
+q_status_t q_matrix_eigen_symmetric(const q_matrix_t* m, q_matrix_t* values, q_matrix_t* vectors)
+{
+    return q_matrix_eigen_symmetric_method(m, values, vectors, Q_EIGEN_AUTO);
+}
+
+/**
+ * @brief This function computes the eigenvalues and optionally the eigenvectors of a symmetric matrix with the selected
+ * method.
+ * @details The matrix is assumed symmetric, only its lower triangle would be enough but the whole matrix is read. The
+ * eigenvalues are real and sorted in decreasing order, the eigenvectors are orthonormal and the column j belongs to the
+ * eigenvalue j. The cost of a Jacobi sweep grows as n^3 and several sweeps are needed, the tridiagonal QR iterations
+ * reduce the matrix once and then work on the band, they are faster from 5 or 6 rows.
+ *
+ * @example
+ * q_matrix_eigen_symmetric_method(&m, &values, &vectors, Q_EIGEN_TRIDIAGONAL_QR);
+ *
+ * @param m The reference to the symmetric matrix
+ * @param values The reference to the n x 1 eigenvalues
+ * @param vectors The reference to the n x n eigenvectors, it may be NULL
+ * @param method Q_EIGEN_AUTO, Q_EIGEN_JACOBI or Q_EIGEN_TRIDIAGONAL_QR
+ * @return q_status_t Q_MATRIX_OK, or Q_MATRIX_ERROR when the iterations did not converge (Q_EIGEN_MAX_SWEEPS Jacobi sweeps
+ * or Q_EIGEN_MAX_ITERATIONS * n QR steps)
+ */
+q_status_t q_matrix_eigen_symmetric_method(const q_matrix_t* m, q_matrix_t* values, q_matrix_t* vectors, q_eigen_method_t method)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(values);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when computing the eigenvalues");
+    assert((values->rows == m->rows) && (values->cols == 1) && "Eigenvalues are not a n x 1 matrix");
+    assert(((vectors == NULL) || ((vectors->rows == m->rows) && (vectors->cols == m->cols))) && "Eigenvectors have not the shape of the matrix");
+
+    const size_t n = m->rows;
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t A = q_arena_matrix_alloc(n, n);
+    q_matrix_t V = {0};
+    if(vectors != NULL)
+    {
+        V = q_arena_matrix_alloc(n, n);
+    }
+    q_eigen_block_t* blocks = (q_eigen_block_t*) q_arena_alloc(n * sizeof(q_eigen_block_t));
+
+    const int exponent = q_eigen_scale(m, &A);
+    const q_status_t status = q_eigen_symmetric(&A, (vectors != NULL) ? &V : NULL, method);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        blocks[i] = (q_eigen_block_t) {i, 1, Q_MATRIX_AT(&A, i, i), Q_ZERO};
+    }
+    q_eigen_sort(blocks, n);
+
+    for(size_t j = 0; j < n; j++)
+    {
+        Q_MATRIX_AT(values, j, 0) = q_eigen_unscale(blocks[j].re, exponent);
+        if(vectors != NULL)
+        {
+            for(size_t r = 0; r < n; r++)
+            {
+                Q_MATRIX_AT(vectors, r, j) = Q_MATRIX_AT(&V, r, blocks[j].index);
+            }
+        }
+    }
+
+    q_arena_release(mark); // Release the scaled matrix, the eigenvectors and the blocks
+    return status;
+}
+
+/**
+ * @brief This function computes the eigenvalues of a square matrix.
+ * @details See q_matrix_eigen, the iterations must converge.
+ *
+ * @param m The reference to the square matrix
+ * @param dst The reference to the n x 2 eigenvalues, (re, im) per row
+ */
+void q_matrix_eigenvalues(const q_matrix_t* m, q_matrix_t* dst)
+{
+    const q_status_t status = q_matrix_eigen(m, dst, NULL);
+    assert((status == Q_MATRIX_OK) && "Eigenvalue iterations did not converge");
+    (void) status;
+}
+
+/**
+ * @brief This function computes the eigenvectors of a square matrix.
+ * @details See q_matrix_eigen, the iterations must converge. The eigenvalues matching the columns are the ones of
+ * q_matrix_eigenvalues.
+ *
+ * @param m The reference to the square matrix
+ * @param dst The reference to the n x n eigenvectors
+ */
+void q_matrix_eigenvectors(const q_matrix_t* m, q_matrix_t* dst)
+{
+    Q_MATRIX_ASSERT(m);
+
+    const q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t values = q_arena_matrix_alloc(m->rows, 2);
+
+    const q_status_t status = q_matrix_eigen(m, &values, dst);
+    assert((status == Q_MATRIX_OK) && "Eigenvalue iterations did not converge");
+    (void) status;
+
+    q_arena_release(mark); // Release the eigenvalues
+}
+
+/**
+ * @brief This function computes the eigenvalues and the eigenvectors of a batch of symmetric 3x3 matrices.
+ * @details The matrices are stored as a structure of arrays, every column is one matrix: the rows of A hold the upper
+ * triangles (a00, a01, a02, a11, a12, a22). Every matrix gets the same fixed number of Jacobi sweeps (Q_EIGEN3_SWEEPS) and
+ * the matrices of a block of Q_EIGEN3_BLOCK columns are processed together with vector instructions (the AVX2 variant when
+ * q_simd_kernels selected it). The eigenvalues are sorted in decreasing order and the eigenvectors are orthonormal, the
+ * result of a matrix does not depend on the other matrices of the batch.
+ *
+ * @example
+ * q_matrix_t A = q_matrix_alloc_aligned(6, count); // Inertia tensors, one per column
+ * q_matrix_t values = q_matrix_alloc_aligned(3, count);
+ * q_matrix_t vectors = q_matrix_alloc_aligned(9, count);
+ * q_matrix_eigen_symmetric3_batch(&A, &values, &vectors); // Principal axis j of the matrix c: rows j, 3 + j, 6 + j of column c
+ *
+ * @param A The reference to the 6 x count upper triangles
+ * @param values The reference to the 3 x count eigenvalues
+ * @param vectors The reference to the 9 x count eigenvectors, the row 3 * i + j holds the component i of the eigenvector j,
+ * it may be NULL
+ */
+void q_matrix_eigen_symmetric3_batch(const q_matrix_t* A, q_matrix_t* values, q_matrix_t* vectors)
+{
+    Q_MATRIX_ASSERT(A);
+    Q_MATRIX_ASSERT(values);
+
+    assert((A->rows == 6) && "Batch of symmetric 3x3 matrices does not have 6 rows");
+    assert((values->rows == 3) && (values->cols == A->cols) && "Eigenvalues are not a 3 x count matrix");
+    assert(((vectors == NULL) || ((vectors->rows == 9) && (vectors->cols == A->cols))) && "Eigenvectors are not a 9 x count matrix");
+
+    void (*kernel)(q_t (*)[Q_EIGEN3_BLOCK], q_t (*)[Q_EIGEN3_BLOCK], q_t (*)[Q_EIGEN3_BLOCK], size_t) = q_eigen3_block_scalar;
+#if Q_SIMD_X86
+    if(q_simd_kernels()->level >= Q_SIMD_AVX2)
+    {
+        kernel = q_eigen3_block_avx2;
+    }
+#endif // Q_SIMD_X86
+
+    q_t in[6][Q_EIGEN3_BLOCK], out[3][Q_EIGEN3_BLOCK], vec[9][Q_EIGEN3_BLOCK];
+
+    for(size_t col = 0; col < A->cols; col += Q_EIGEN3_BLOCK)
+    {
+        const size_t count = (A->cols - col < Q_EIGEN3_BLOCK) ? (A->cols - col) : Q_EIGEN3_BLOCK;
+
+        for(size_t e = 0; e < 6; e++)
+        {
+            memcpy(in[e], &Q_MATRIX_AT(A, e, col), count * sizeof(q_t));
+        }
+
+        kernel(in, out, (vectors != NULL) ? vec : NULL, count);
+
+        for(size_t i = 0; i < 3; i++)
+        {
+            memcpy(&Q_MATRIX_AT(values, i, col), out[i], count * sizeof(q_t));
+        }
+        if(vectors != NULL)
+        {
+            for(size_t e = 0; e < 9; e++)
+            {
+                memcpy(&Q_MATRIX_AT(vectors, e, col), vec[e], count * sizeof(q_t));
+            }
+        }
+    }
+}
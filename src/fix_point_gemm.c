@@ -0,0 +1,478 @@
+#include "../include/fix_point_gemm.h"
+#include "../include/fix_point_arena.h"
+
+// MARK: Packing
+
+/**
+ * @brief Running maximum of the absolute values of the packed elements
+ * 
+ * @param max_abs The current maximum
+ * @param x The packed element
+ * @return uint64_t The updated maximum
+ */
+static inline uint64_t q_gemm_max_abs(uint64_t max_abs, q_t x)
+{
+    const uint64_t abs_x = (uint64_t) ((x < 0) ? -(int64_t) x : (int64_t) x);
+    return (abs_x > max_abs) ? abs_x : max_abs;
+}
+
+/**
+ * @brief Packs a block of rows of A into contiguous slivers of Q_GEMM_MR rows.
+ * @details Every sliver stores the k columns of its rows interleaved (column p of the sliver is stored in Q_GEMM_MR consecutive elements),
+ * so the micro-kernel reads A sequentially. Rows past the end of the matrix are padded with zeros.
+ *
+ * @param a The matrix A
+ * @param row The first row of the block
+ * @param mc The number of rows of the block
+ * @param k The depth of the product (columns of A)
+ * @param dst The packing buffer, at least ceil(mc / Q_GEMM_MR) * Q_GEMM_MR * k elements
+ * @return uint64_t The largest absolute value of the block
+ */
+static uint64_t q_gemm_pack_a(const q_matrix_t* a, size_t row, size_t mc, size_t k, q_t* dst)
+{
+    uint64_t max_abs = 0;
+
+    for(size_t ir = 0; ir < mc; ir += Q_GEMM_MR)
+    {
+        const size_t mr = (mc - ir < Q_GEMM_MR) ? (mc - ir) : Q_GEMM_MR;
+
+        for(size_t p = 0; p < k; p++)
+        {
+            size_t i = 0;
+            for(; i < mr; i++)
+            {
+                dst[i] = Q_MATRIX_AT(a, row + ir + i, p);
+                max_abs = q_gemm_max_abs(max_abs, dst[i]);
+            }
+            for(; i < Q_GEMM_MR; i++)
+            {
+                dst[i] = Q_ZERO;
+            }
+            dst += Q_GEMM_MR;
+        }
+    }
+
+    return max_abs;
+}
+
+/**
+ * @brief Packs a block of columns of B into contiguous slivers of Q_GEMM_NR columns.
+ * @details Every sliver stores the k rows of its columns one after the other (row p of the sliver is stored in Q_GEMM_NR consecutive elements),
+ * so the micro-kernel reads B sequentially instead of walking it column-wise. Columns past the end of the matrix are padded with zeros.
+ *
+ * @param b The matrix B
+ * @param col The first column of the block
+ * @param nc The number of columns of the block
+ * @param k The depth of the product (rows of B)
+ * @param dst The packing buffer, at least ceil(nc / Q_GEMM_NR) * Q_GEMM_NR * k elements
+ * @return uint64_t The largest absolute value of the block
+ */
+static uint64_t q_gemm_pack_b(const q_matrix_t* b, size_t col, size_t nc, size_t k, q_t* dst)
+{
+    uint64_t max_abs = 0;
+
+    for(size_t jr = 0; jr < nc; jr += Q_GEMM_NR)
+    {
+        const size_t nr = (nc - jr < Q_GEMM_NR) ? (nc - jr) : Q_GEMM_NR;
+
+        for(size_t p = 0; p < k; p++)
+        {
+            const q_t* src = &Q_MATRIX_AT(b, p, col + jr);
+            size_t j = 0;
+            for(; j < nr; j++)
+            {
+                dst[j] = src[j];
+                max_abs = q_gemm_max_abs(max_abs, dst[j]);
+            }
+            for(; j < Q_GEMM_NR; j++)
+            {
+                dst[j] = Q_ZERO;
+            }
+            dst += Q_GEMM_NR;
+        }
+    }
+
+    return max_abs;
+}
+
+// MARK: Micro-kernel
+
+/**
+ * @brief Stores an accumulated value into the destination element according to the GEMM mode.
+ *
+ * @param dst The destination element
+ * @param value The accumulated value (see Q_ACC_TERM)
+ * @param mode The GEMM mode
+ */
+static inline void q_gemm_store(q_t* dst, q_acc_t value, q_gemm_mode_t mode)
+{
+    switch(mode)
+    {
+        case Q_GEMM_ADD:
+            *dst = Q_ACC_TO_Q(Q_ACC_FROM_Q(*dst) + value);
+            break;
+        case Q_GEMM_SUBTRACT:
+            *dst = Q_ACC_TO_Q(Q_ACC_FROM_Q(*dst) - value);
+            break;
+        default:
+            *dst = Q_ACC_TO_Q(value);
+            break;
+    }
+}
+
+#if Q_ACCUMULATE_WIDE
+typedef q_acc_t q_gemm_acc_t;  // Exact sum of the full products
+#else
+typedef q_long_t q_gemm_acc_t; // Sum of the products truncated to the Q format
+#endif // Q_ACCUMULATE_WIDE
+
+/**
+ * @brief Accumulates the products of a depth slice of a packed sliver of A and a packed sliver of B into a
+ * Q_GEMM_MR x Q_GEMM_NR tile.
+ * @details The tile is copied to a local array the compiler maps to registers and written back once at the end of the slice.
+ * With Q_ACCUMULATE_WIDE the full products are summed in native q_long_t accumulators over chunks of the depth that are
+ * guaranteed not to overflow (from the largest absolute values of the packed panels) and every chunk is flushed into q_acc_t.
+ * The result is the exact wide sum without paying for q_acc_t arithmetic on every product.
+ *
+ * @param kc The depth of the slice
+ * @param chunk The number of products that can be summed in q_long_t without overflow
+ * @param ap The packed sliver of A (Q_GEMM_MR x kc)
+ * @param bp The packed sliver of B (kc x Q_GEMM_NR)
+ * @param tile The accumulators of the tile
+ */
+static inline __attribute__((always_inline)) void q_gemm_micro_kernel(size_t kc, size_t chunk, const q_t* restrict ap, const q_t* restrict bp, q_gemm_acc_t tile[restrict Q_GEMM_MR][Q_GEMM_NR])
+{
+    q_gemm_acc_t acc[Q_GEMM_MR][Q_GEMM_NR];
+    memcpy(acc, tile, sizeof(acc));
+
+#if Q_ACCUMULATE_WIDE
+    for(size_t p0 = 0; p0 < kc; p0 += chunk)
+    {
+        const size_t p1 = (kc - p0 < chunk) ? kc : (p0 + chunk);
+        q_long_t part[Q_GEMM_MR][Q_GEMM_NR] = {{0}};
+
+        for(size_t p = p0; p < p1; p++)
+        {
+            for(size_t i = 0; i < Q_GEMM_MR; i++)
+            {
+                const q_long_t a = ap[i];
+                for(size_t j = 0; j < Q_GEMM_NR; j++)
+                {
+                    part[i][j] += a * bp[j];
+                }
+            }
+            ap += Q_GEMM_MR;
+            bp += Q_GEMM_NR;
+        }
+
+        for(size_t i = 0; i < Q_GEMM_MR; i++)
+        {
+            for(size_t j = 0; j < Q_GEMM_NR; j++)
+            {
+                acc[i][j] += part[i][j];
+            }
+        }
+    }
+#else
+    (void) chunk;
+
+    for(size_t p = 0; p < kc; p++)
+    {
+        for(size_t i = 0; i < Q_GEMM_MR; i++)
+        {
+            const q_t a = ap[i];
+            for(size_t j = 0; j < Q_GEMM_NR; j++)
+            {
+                acc[i][j] += Q_ACC_TERM(a, bp[j]);
+            }
+        }
+        ap += Q_GEMM_MR;
+        bp += Q_GEMM_NR;
+    }
+#endif // Q_ACCUMULATE_WIDE
+
+    memcpy(tile, acc, sizeof(acc));
+}
+
+/**
+ * @brief Stores the valid part of an accumulated tile into C according to the GEMM mode.
+ *
+ * @param tile The accumulators of the tile
+ * @param c The reference to the top left element of the tile in C
+ * @param ldc The row stride of C
+ * @param mr The number of valid rows of the tile
+ * @param nr The number of valid columns of the tile
+ * @param mode The GEMM mode
+ */
+static void q_gemm_store_tile(q_gemm_acc_t tile[Q_GEMM_MR][Q_GEMM_NR], q_t* c, size_t ldc, size_t mr, size_t nr, q_gemm_mode_t mode)
+{
+    for(size_t i = 0; i < mr; i++)
+    {
+        for(size_t j = 0; j < nr; j++)
+        {
+            q_gemm_store(&c[i * ldc + j], tile[i][j], mode);
+        }
+    }
+}
+
+// MARK: GEMM
+
+/**
+ * @brief Direct product for small matrices where packing does not pay off.
+ *
+ * @param a The reference to matrix A
+ * @param b The reference to matrix B
+ * @param c The reference to matrix C
+ * @param mode The GEMM mode
+ */
+static void q_gemm_small(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* c, q_gemm_mode_t mode)
+{
+    for(size_t i = 0; i < c->rows; i++)
+    {
+        for(size_t j = 0; j < c->cols; j++)
+        {
+            q_acc_t acc = 0;
+            for(size_t p = 0; p < a->cols; p++)
+            {
+                acc += Q_ACC_TERM(Q_MATRIX_AT(a, i, p), Q_MATRIX_AT(b, p, j));
+            }
+            q_gemm_store(&Q_MATRIX_AT(c, i, j), acc, mode);
+        }
+    }
+}
+
+// Shared state of the tasks computing the product with one packed panel of B
+struct gemm_panel_t {
+    const q_matrix_t* a;
+    q_matrix_t* c;
+    q_gemm_mode_t mode;
+    size_t k;
+    size_t kc;            // Depth of a slice
+    size_t mc;            // Rows of a task (multiple of Q_GEMM_MR)
+    size_t nt;            // Columns of a task (multiple of Q_GEMM_NR)
+    size_t row_blocks;    // Number of row blocks of C
+    size_t jc;            // First column of the panel
+    size_t ncb;           // Columns of the panel
+    const q_t* b_pack;    // Packed panel of B
+    uint64_t b_max;       // Largest absolute value of the panel
+    q_t* a_packs;         // One packing buffer of A per worker
+    size_t a_pack_size;   // Elements of a packing buffer of A
+    q_gemm_acc_t* tiles;  // One column of tile accumulators per worker (mc x Q_GEMM_NR)
+    size_t tiles_size;    // Elements of a column of tile accumulators
+};
+typedef struct gemm_panel_t q_gemm_panel_t;
+
+/**
+ * @brief Computes the tile (row block, column tile) of C selected by task from the packed panel of B.
+ * @details Every column sliver of the tile is accumulated slice by slice over the depth: the kc x Q_GEMM_NR slice of B stays
+ * in the L1 cache while the slices of the slivers of A stream through it, and the accumulators of the column are kept in
+ * the buffer of the worker until the last slice. Every element of C is computed by exactly one task with exact integer
+ * accumulation and stored once, so the result does not depend on the tiling nor on which worker runs the task.
+ *
+ * @param ctx The panel state (q_gemm_panel_t)
+ * @param task The index of the tile, row blocks first
+ * @param worker The worker running the task (selects the packing buffer of A and the accumulators)
+ */
+static void q_gemm_panel_task(void* ctx, size_t task, size_t worker)
+{
+    const q_gemm_panel_t* panel = (const q_gemm_panel_t*) ctx;
+    const size_t k = panel->k;
+    const size_t kc = panel->kc;
+    const size_t ic = (task % panel->row_blocks) * panel->mc;
+    const size_t jt = (task / panel->row_blocks) * panel->nt;
+
+    const size_t mcb = (panel->c->rows - ic < panel->mc) ? (panel->c->rows - ic) : panel->mc;
+    const size_t jend = (panel->ncb - jt < panel->nt) ? panel->ncb : (jt + panel->nt);
+
+    q_t* a_pack = &panel->a_packs[worker * panel->a_pack_size];
+    const uint64_t a_max = q_gemm_pack_a(panel->a, ic, mcb, k, a_pack);
+    q_gemm_acc_t* tiles = &panel->tiles[worker * panel->tiles_size];
+
+    // Number of products that can be summed in q_long_t without overflow
+    const uint64_t term_max = a_max * panel->b_max;
+    const size_t chunk = (term_max == 0 || (uint64_t) Q_LONG_MAX / term_max >= k) ? k : (size_t) ((uint64_t) Q_LONG_MAX / term_max);
+
+    for(size_t jr = jt; jr < jend; jr += Q_GEMM_NR)
+    {
+        const size_t nr = (jend - jr < Q_GEMM_NR) ? (jend - jr) : Q_GEMM_NR;
+
+        if(k <= kc) // Single slice, the tiles are stored as soon as they are computed
+        {
+            for(size_t ir = 0; ir < mcb; ir += Q_GEMM_MR)
+            {
+                const size_t mr = (mcb - ir < Q_GEMM_MR) ? (mcb - ir) : Q_GEMM_MR;
+                q_gemm_acc_t tile[Q_GEMM_MR][Q_GEMM_NR] = {{0}};
+                q_gemm_micro_kernel(k, chunk, &a_pack[ir * k], &panel->b_pack[jr * k], tile);
+                q_gemm_store_tile(tile, &Q_MATRIX_AT(panel->c, ic + ir, panel->jc + jr), panel->c->stride, mr, nr, panel->mode);
+            }
+            continue;
+        }
+
+        memset(tiles, 0, panel->tiles_size * sizeof(q_gemm_acc_t));
+
+        // The slices of a sliver are contiguous in the packed panels (Q_GEMM_MR or Q_GEMM_NR elements per step of the depth)
+        for(size_t pc = 0; pc < k; pc += kc)
+        {
+            const size_t kcb = (k - pc < kc) ? (k - pc) : kc;
+            const q_t* b_slice = &panel->b_pack[jr * k + pc * Q_GEMM_NR];
+
+            for(size_t ir = 0; ir < mcb; ir += Q_GEMM_MR)
+            {
+                q_gemm_micro_kernel(kcb, chunk, &a_pack[ir * k + pc * Q_GEMM_MR], b_slice, (q_gemm_acc_t (*)[Q_GEMM_NR]) &tiles[ir * Q_GEMM_NR]);
+            }
+        }
+
+        for(size_t ir = 0; ir < mcb; ir += Q_GEMM_MR)
+        {
+            const size_t mr = (mcb - ir < Q_GEMM_MR) ? (mcb - ir) : Q_GEMM_MR;
+            q_gemm_store_tile((q_gemm_acc_t (*)[Q_GEMM_NR]) &tiles[ir * Q_GEMM_NR], &Q_MATRIX_AT(panel->c, ic + ir, panel->jc + jr), panel->c->stride, mr, nr, panel->mode);
+        }
+    }
+}
+
+/**
+ * @brief General matrix multiplication of fixed point matrices. C = A * B, C = C + A * B or C = C - A * B depending on the mode.
+ * @details Same as q_gemm_parallel with the default number of threads (see q_thread_set_max_threads).
+ *
+ * @example
+ * q_matrix_t a = q_matrix_alloc(2, 3);
+ * q_matrix_t b = q_matrix_alloc(3, 2);
+ * q_matrix_t c = q_matrix_alloc(2, 2);
+ * q_ones(&a);
+ * q_ones(&b);
+ * q_ones(&c);
+ * q_gemm(&a, &b, &c, Q_GEMM_SUBTRACT);
+ * Q_MATRIX_PRINT(c);
+ *
+ * Output:
+ * c: [
+ * -2.000000, -2.000000,
+ * -2.000000, -2.000000,
+ * ]
+ *
+ * @param a The reference to matrix A of fixed point numbers (m x k)
+ * @param b The reference to matrix B of fixed point numbers (k x n)
+ * @param c The reference to matrix C of fixed point numbers (m x n)
+ * @param mode The GEMM mode
+ */
+void q_gemm(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* c, q_gemm_mode_t mode)
+{
+    q_gemm_parallel(a, b, c, mode, 0);
+}
+
+/**
+ * @brief General matrix multiplication on up to max_threads threads of the persistent pool (see q_thread_parallel_for).
+ * @details The product is computed by blocks:
+ * 1. The columns of B are split in panels of nc columns which are packed into contiguous slivers of Q_GEMM_NR columns (sized for the L3 cache).
+ * 2. The rows of A are split in blocks of mc rows which are packed into contiguous slivers of Q_GEMM_MR rows (sized for the L2 cache).
+ * 3. The depth is split in slices of kc, so the slice of a sliver of B stays in the L1 cache while it is reused by the slivers of A.
+ * 4. Every Q_GEMM_MR x Q_GEMM_NR tile of C is accumulated by the register-blocked micro-kernel from the slices of one sliver of A and one sliver of B.
+ *
+ * The accumulators of a tile are carried from one slice to the next, every tile of C is stored once after the whole inner product.
+ * With Q_ACCUMULATE_WIDE the full products are summed in q_acc_t and every element of C is rescaled and saturated once,
+ * otherwise each product term is truncated to the Q format as in q_product (bit-exact with the naive triple loop).
+ *
+ * Products with at least Q_GEMM_PARALLEL_OPS multiply-accumulate operations are split in tiles of C (row blocks times column
+ * tiles of every panel) that are distributed over the threads with work stealing. Every element is accumulated by a single
+ * task with integer arithmetic, so the result is bit-exact for any number of threads.
+ * C must not share its elements with A or B.
+ *
+ * @param a The reference to matrix A of fixed point numbers (m x k)
+ * @param b The reference to matrix B of fixed point numbers (k x n)
+ * @param c The reference to matrix C of fixed point numbers (m x n)
+ * @param mode The GEMM mode
+ * @param max_threads The maximum number of threads (the calling thread included), 0 selects the default
+ */
+void q_gemm_parallel(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* c, q_gemm_mode_t mode, size_t max_threads)
+{
+    Q_MATRIX_ASSERT(a);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(c);
+
+    assert((a->cols == b->rows) && "The number of columns of A must be equal to the number of rows of B (Can not perform GEMM)");
+    assert((a->rows == c->rows) && "Matrices A and C have different number of rows (Can not perform GEMM)");
+    assert((b->cols == c->cols) && "Matrices B and C have different number of columns (Can not perform GEMM)");
+
+    const size_t m = c->rows;
+    const size_t n = c->cols;
+    const size_t k = a->cols;
+
+    if(m * n * k <= Q_GEMM_SMALL_OPS)
+    {
+        q_gemm_small(a, b, c, mode);
+        return;
+    }
+
+    const size_t threads = (m * n * k < Q_GEMM_PARALLEL_OPS) ? 1 : q_thread_resolve(max_threads);
+
+    // Block sizes from the cache targets, rounded to the register blocking
+    size_t mc = Q_GEMM_L2_BYTES / (k * sizeof(q_t));
+    mc = (mc < Q_GEMM_MR) ? Q_GEMM_MR : (mc - mc % Q_GEMM_MR);
+    mc = (mc > m) ? m : mc;
+
+    size_t nc = Q_GEMM_L3_BYTES / (k * sizeof(q_t));
+    nc = (nc < Q_GEMM_NR) ? Q_GEMM_NR : (nc - nc % Q_GEMM_NR);
+    nc = (nc > n) ? n : nc;
+
+    // The slice of a sliver of B fills half of the L1 cache, the other half is left to the streamed slices of A
+    size_t kc = Q_GEMM_L1_BYTES / (2 * Q_GEMM_NR * sizeof(q_t));
+    kc = (kc < 1) ? 1 : kc;
+
+    // With several threads the tiles are made smaller so every thread gets Q_GEMM_TASKS_PER_THREAD tasks to balance the load
+    size_t nt = nc;
+    if(threads > 1)
+    {
+        const size_t tasks = threads * Q_GEMM_TASKS_PER_THREAD;
+        const size_t rows_per_task = (m + tasks - 1) / tasks;
+        const size_t mc_min = 8 * Q_GEMM_MR;
+        size_t mc_task = (rows_per_task + Q_GEMM_MR - 1) / Q_GEMM_MR * Q_GEMM_MR;
+        mc_task = (mc_task < mc_min) ? mc_min : mc_task;
+        mc = (mc_task < mc) ? mc_task : mc;
+
+        const size_t row_blocks = (m + mc - 1) / mc;
+        if(row_blocks < tasks)
+        {
+            const size_t col_tiles = (tasks + row_blocks - 1) / row_blocks;
+            nt = (nc + col_tiles - 1) / col_tiles;
+            nt = (nt + Q_GEMM_NR - 1) / Q_GEMM_NR * Q_GEMM_NR;
+            nt = (nt < Q_GEMM_PARALLEL_MIN_NC) ? Q_GEMM_PARALLEL_MIN_NC : nt;
+            nt = (nt > nc) ? nc : nt;
+        }
+    }
+
+    const size_t mc_padded = (mc + Q_GEMM_MR - 1) / Q_GEMM_MR * Q_GEMM_MR;
+    const size_t nc_padded = (nc + Q_GEMM_NR - 1) / Q_GEMM_NR * Q_GEMM_NR;
+
+    q_gemm_panel_t panel;
+    panel.a = a;
+    panel.c = c;
+    panel.mode = mode;
+    panel.k = k;
+    panel.kc = kc;
+    panel.mc = mc;
+    panel.nt = nt;
+    panel.row_blocks = (m + mc - 1) / mc;
+    panel.a_pack_size = mc_padded * k;
+    panel.tiles_size = mc_padded * Q_GEMM_NR;
+
+    // The packed panels are taken from the workspace of the calling thread, the workers only write to their own A panel
+    q_arena_mark_t mark = q_arena_mark();
+    panel.a_packs = (q_t*) q_arena_alloc(threads * panel.a_pack_size * sizeof(q_t));
+    panel.tiles = (q_gemm_acc_t*) q_arena_alloc(threads * panel.tiles_size * sizeof(q_gemm_acc_t));
+
+    q_t* b_pack = (q_t*) q_arena_alloc(nc_padded * k * sizeof(q_t));
+    panel.b_pack = b_pack;
+
+    for(size_t jc = 0; jc < n; jc += nc)
+    {
+        const size_t ncb = (n - jc < nc) ? (n - jc) : nc;
+        panel.jc = jc;
+        panel.ncb = ncb;
+        panel.b_max = q_gemm_pack_b(b, jc, ncb, k, b_pack);
+
+        const size_t tasks = panel.row_blocks * ((ncb + nt - 1) / nt);
+        q_thread_parallel_for(tasks, threads, q_gemm_panel_task, &panel);
+    }
+
+    q_arena_release(mark);
+}
@@ -0,0 +1,398 @@
+#include "../include/fix_point_lu.h"
+#include "../include/fix_point_arena.h"
+#include "../include/fix_point_gemm.h"
+
+// MARK: Allocation
+
+/**
+ * @brief This function allocates a LU factorization of a n x n matrix.
+ *
+ * @param n The number of rows and columns of the factorized matrices
+ * @return q_lu_t The LU factorization, released with q_lu_free
+ */
+q_lu_t q_lu_alloc(size_t n)
+{
+    q_lu_t lu;
+    lu.LU = q_matrix_square_alloc(n);
+    lu.perm = (size_t*) malloc(n * sizeof(size_t));
+    assert((lu.perm != NULL) && "Memory allocation failed");
+    q_arena_count_heap_allocation();
+    lu.parity = 1;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        lu.perm[i] = i;
+    }
+    return lu;
+}
+
+/**
+ * @brief This function allocates a LU factorization of a n x n matrix from the arena of the calling thread.
+ * @details The factorization is released with q_arena_release, it must not be passed to q_lu_free.
+ *
+ * @param n The number of rows and columns of the factorized matrices
+ * @return q_lu_t The LU factorization
+ */
+q_lu_t q_lu_arena_alloc(size_t n)
+{
+    q_lu_t lu;
+    lu.LU = q_arena_matrix_alloc(n, n);
+    lu.perm = (size_t*) q_arena_alloc(n * sizeof(size_t));
+    lu.parity = 1;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        lu.perm[i] = i;
+    }
+    return lu;
+}
+
+/**
+ * @brief This function frees the memory allocated for the LU factorization.
+ *
+ * @param lu The LU factorization
+ */
+void q_lu_free(q_lu_t* lu)
+{
+    Q_LU_ASSERT(lu);
+
+    q_matrix_free(&lu->LU);
+    free(lu->perm);
+    lu->perm = NULL;
+    lu->parity = 1;
+}
+
+// MARK: Factorization
+
+/**
+ * @brief Factorizes the panel of the columns [k0, k0 + kb) with partial pivoting (unblocked Doolittle elimination).
+ * @details The pivot is searched on and below the diagonal, the whole rows are switched so the multipliers of the previous
+ * panels and the trailing columns follow the permutation. The elimination only updates the columns of the panel.
+ *
+ * @param lu The LU factorization in progress
+ * @param k0 The first column of the panel
+ * @param kb The number of columns of the panel
+ */
+static void q_lu_panel(q_lu_t* lu, size_t k0, size_t kb)
+{
+    q_matrix_t* LU = &lu->LU;
+    const size_t n = LU->rows;
+    const size_t k1 = k0 + kb;
+
+    for(size_t i = k0; i < k1; i++)
+    {
+        // Find the pivot element (largest absolute value of the column i on and below the diagonal)
+        size_t max_idx = i;
+        q_t max_val = q_absolute(Q_MATRIX_AT(LU, i, i));
+
+        for(size_t j = i + 1; j < n; j++)
+        {
+            q_t val = q_absolute(Q_MATRIX_AT(LU, j, i));
+            if(val > max_val)
+            {
+                max_val = val;
+                max_idx = j;
+            }
+        }
+
+        // If the whole column is zero, the matrix is singular
+        assert((max_val != Q_ZERO) && "Matrix is singular (LU decomposition is not possible)");
+
+        if(max_idx != i)
+        {
+            for(size_t k = 0; k < n; k++)
+            {
+                q_t temp = Q_MATRIX_AT(LU, i, k);
+                Q_MATRIX_AT(LU, i, k) = Q_MATRIX_AT(LU, max_idx, k);
+                Q_MATRIX_AT(LU, max_idx, k) = temp;
+            }
+
+            size_t temp = lu->perm[i];
+            lu->perm[i] = lu->perm[max_idx];
+            lu->perm[max_idx] = temp;
+            lu->parity = -lu->parity;
+        }
+
+        const q_divisor_t pivot = q_divisor_prepare(Q_MATRIX_AT(LU, i, i)); // Multiplications instead of divisions in the column
+
+        for(size_t j = i + 1; j < n; j++)
+        {
+            /*
+            L[j][i] = U[j][i] / U[i][i]
+            U[j][k] = U[j][k] - L[j][i] * U[i][k]
+            */
+            const q_t l = q_division_prepared(Q_MATRIX_AT(LU, j, i), pivot);
+            Q_MATRIX_AT(LU, j, i) = l;
+
+            if(l == Q_ZERO)
+            {
+                continue; // Nothing to eliminate in this row
+            }
+
+            for(size_t k = i + 1; k < k1; k++)
+            {
+                Q_MATRIX_AT(LU, j, k) -= q_product(l, Q_MATRIX_AT(LU, i, k));
+            }
+        }
+    }
+}
+
+/**
+ * @brief This function computes the LU factorization with partial pivoting of a square matrix, A = P * L * U.
+ * @details The factorization is computed with q_lu_decompose_blocked, the panel width is Q_LU_BLOCK and everything runs on
+ * the calling thread, so it can be used from the tasks of the thread pool. Use q_lu_decompose_blocked with max_threads to
+ * split the trailing updates of a large matrix over the pool.
+ *
+ * @example
+ * q_lu_t lu = q_lu_alloc(3);
+ * q_lu_decompose(&m, &lu);
+ * q_lu_solve(&lu, &b, &x);
+ * q_lu_free(&lu);
+ *
+ * @param m The reference to the square matrix, it may be the LU matrix of the factorization
+ * @param lu The LU factorization of the matrix
+ */
+void q_lu_decompose(const q_matrix_t* m, q_lu_t* lu)
+{
+    q_lu_decompose_blocked(m, lu, 0, 1);
+}
+
+/**
+ * @brief This function computes the blocked right-looking LU factorization with partial pivoting, A = P * L * U.
+ * @details The matrix is processed in panels of block columns. For every panel:
+ * 1. The panel is factorized with the unblocked elimination (the row switches are applied to the whole rows)
+ * 2. The block row on the right of the panel is solved with the unit lower triangle of the panel, U12 = L11^-1 * A12
+ * 3. The trailing submatrix is updated with the GEMM engine, A22 = A22 - L21 * U12
+ * Most of the operations are done by the trailing updates, which run at GEMM speed and are split over up to max_threads
+ * threads. The steps work on views of the packed matrix, no temporary is allocated. When the matrix is not larger than
+ * the panel width the factorization is the unblocked Doolittle elimination, bit identical to
+ * q_matrix_PLU_decomposition. The blocked factors differ in the last bits because the trailing updates round once per
+ * element instead of once per product.
+ *
+ * @example
+ * q_lu_decompose_blocked(&m, &lu, 64, 4); // Panels of 64 columns, trailing updates on up to 4 threads
+ *
+ * @param m The reference to the square matrix, it may be the LU matrix of the factorization
+ * @param lu The LU factorization of the matrix
+ * @param block The panel width, 0 selects Q_LU_BLOCK
+ * @param max_threads The maximum number of threads of the trailing updates, 0 selects the default
+ */
+void q_lu_decompose_blocked(const q_matrix_t* m, q_lu_t* lu, size_t block, size_t max_threads)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_LU_ASSERT(lu);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when performing LU decomposition");
+    assert((lu->LU.rows == m->rows) && (lu->LU.cols == m->cols) && "LU factorization has different dimensions than the input matrix");
+
+    const size_t n = m->rows;
+    const size_t nb = (block == 0) ? Q_LU_BLOCK : block;
+    q_matrix_t* LU = &lu->LU;
+
+    q_matrix_cpy(m, LU); // The elimination is performed in place
+    lu->parity = 1;
+    for(size_t i = 0; i < n; i++)
+    {
+        lu->perm[i] = i;
+    }
+
+    for(size_t k0 = 0; k0 < n; k0 += nb)
+    {
+        const size_t kb = (n - k0 < nb) ? (n - k0) : nb;
+        const size_t k1 = k0 + kb;
+
+        q_lu_panel(lu, k0, kb);
+
+        if(k1 == n)
+        {
+            break; // The last panel has no trailing submatrix
+        }
+
+        q_matrix_t L11 = q_matrix_view(LU, k0, k0, kb, kb);
+        q_matrix_t A12 = q_matrix_view(LU, k0, k1, kb, n - k1);
+        q_matrix_t L21 = q_matrix_view(LU, k1, k0, n - k1, kb);
+        q_matrix_t A22 = q_matrix_view(LU, k1, k1, n - k1, n - k1);
+
+        q_matrix_triangular_solve(&L11, &A12, &A12, Q_TRIANGLE_UNIT_LOWER); // U12 = L11^-1 * A12
+        q_gemm_parallel(&L21, &A12, &A22, Q_GEMM_SUBTRACT, max_threads); // A22 = A22 - L21 * U12
+    }
+}
+
+// MARK: Solvers
+
+/**
+ * @brief This function solves the system of linear equations A * x = b with the LU factorization of A.
+ * @details The permutation is applied while copying the rows of b (O(n) rows), then the forward substitution with the
+ * unit lower triangle and the back substitution with the upper triangle are performed in place with
+ * q_matrix_triangular_solve. b may hold k right-hand sides (n x k), for instance many load cases against the same
+ * factorization, and they are all solved in one call. The permuted copy is taken from the arena of the calling thread.
+ *
+ * @param lu The LU factorization of A
+ * @param b The reference to the right-hand sides (n x k)
+ * @param x The reference to the solutions (n x k), it may be b
+ */
+void q_lu_solve(const q_lu_t* lu, const q_matrix_t* b, q_matrix_t* x)
+{
+    Q_LU_ASSERT(lu);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(x);
+
+    const q_matrix_t* LU = &lu->LU;
+    const size_t n = LU->rows;
+
+    assert((b->rows == n) && "Matrix LU and b have different number of rows when solving the system of linear equations");
+    assert((x->rows == n) && "Destination matrix and b have different number of rows when solving the system of linear equations");
+    assert((x->cols == b->cols) && "Destination matrix and b have different number of columns when solving the system of linear equations");
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t y = q_arena_matrix_alloc(n, b->cols); // Allocate the y matrix in the workspace of the thread
+
+    // y = P^T * b, the i-th row of y is the row perm[i] of b
+    for(size_t i = 0; i < n; i++)
+    {
+        q_matrix_t src = q_matrix_view_row(b, lu->perm[i]);
+        q_matrix_t dst = q_matrix_view_row(&y, i);
+        q_matrix_cpy(&src, &dst);
+    }
+
+    q_matrix_triangular_solve(LU, &y, &y, Q_TRIANGLE_UNIT_LOWER); // L * y = P^T * b (the diagonal of L is one)
+    q_matrix_triangular_solve(LU, &y, x, Q_TRIANGLE_UPPER); // U * x = y
+
+    q_arena_release(mark); // Release the y matrix
+}
+
+/**
+ * @brief This function returns the determinant of a matrix from its LU factorization.
+ * @details det(A) = det(P) * det(L) * det(U) = parity * U[0][0] * U[1][1] * ... * U[n-1][n-1]
+ *
+ * @param lu The LU factorization of A
+ * @return q_t The determinant of A
+ */
+q_t q_lu_determinant(const q_lu_t* lu)
+{
+    Q_LU_ASSERT(lu);
+
+    q_t ret = Q_ONE;
+    for(size_t i = 0; i < lu->LU.rows; i++)
+    {
+        ret = q_product(ret, Q_MATRIX_AT(&lu->LU, i, i));
+    }
+
+    return (lu->parity < 0) ? -ret : ret;
+}
+
+/**
+ * @brief This function overwrites a LU factorization with the inverse of the factorized matrix (getri).
+ * @details A = P * L * U, therefore A^-1 = U^-1 * L^-1 * P^T. The inverse is computed in the packed buffer in three steps:
+ * 1. U is inverted in place, every column of U^-1 is the back substitution of a unit vector
+ * 2. X * L = U^-1 is solved from the last column to the first, the multipliers of the column j of L are saved in a
+ *    work vector before the column is overwritten: X[:][j] = X[:][j] - X[:][j+1:n] * L[j+1:n][j]
+ * 3. The columns are permuted, the column i of X is the column perm[i] of A^-1
+ * The sums are accumulated in wide accumulators and every element of U^-1 is divided by the diagonal of U, so the
+ * rounding matches the column by column solves. The divisors are prepared once per row (see q_divisor_prepare). The only
+ * memory used besides the buffer is the work vector and the n prepared divisors, taken from the arena of the calling
+ * thread. After the call lu->LU holds the inverse and lu is no longer a factorization.
+ *
+ * @example
+ * q_lu_decompose(&m, &lu);
+ * q_lu_inverse_in_place(&lu); // lu.LU = m^-1
+ *
+ * @param lu The LU factorization of A, overwritten with A^-1
+ */
+void q_lu_inverse_in_place(q_lu_t* lu)
+{
+    Q_LU_ASSERT(lu);
+
+    q_matrix_t* A = &lu->LU;
+    const size_t n = A->rows;
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_t* work = (q_t*) q_arena_alloc(n * sizeof(q_t));
+    q_divisor_t* diagonal = (q_divisor_t*) q_arena_alloc(n * sizeof(q_divisor_t));
+
+    // Every row of U^-1 is divided by the same diagonal element of U, the divisors are prepared once
+    for(size_t i = 0; i < n; i++)
+    {
+        assert((Q_MATRIX_AT(A, i, i) != Q_ZERO) && "Matrix is singular (Can not calculate the inverse)");
+        diagonal[i] = q_divisor_prepare(Q_MATRIX_AT(A, i, i));
+    }
+
+    // 1. U^-1 in place, the columns are solved from the last to the first (U * U^-1[:][j] = e_j by back substitution) so the
+    // columns on the left still hold U when they are read
+    for(size_t j = n; j-- > 0;)
+    {
+        Q_MATRIX_AT(A, j, j) = q_reciprocal(Q_MATRIX_AT(A, j, j));
+
+        for(size_t i = j; i-- > 0;)
+        {
+            q_acc_t acc = 0;
+            for(size_t k = i + 1; k <= j; k++)
+            {
+                acc -= Q_ACC_TERM(Q_MATRIX_AT(A, i, k), Q_MATRIX_AT(A, k, j));
+            }
+            Q_MATRIX_AT(A, i, j) = q_division_prepared(Q_ACC_TO_Q(acc), diagonal[i]);
+        }
+    }
+
+    // 2. X * L = U^-1, from the last column to the first
+    for(size_t j = n; j-- > 0;)
+    {
+        for(size_t i = j + 1; i < n; i++)
+        {
+            work[i] = Q_MATRIX_AT(A, i, j);
+            Q_MATRIX_AT(A, i, j) = Q_ZERO;
+        }
+
+        if(j + 1 == n)
+        {
+            continue; // The last column of L is the unit vector
+        }
+
+        for(size_t r = 0; r < n; r++)
+        {
+            q_acc_t acc = Q_ACC_FROM_Q(Q_MATRIX_AT(A, r, j));
+            for(size_t i = j + 1; i < n; i++)
+            {
+                acc -= Q_ACC_TERM(Q_MATRIX_AT(A, r, i), work[i]);
+            }
+            Q_MATRIX_AT(A, r, j) = Q_ACC_TO_Q(acc);
+        }
+    }
+
+    // 3. A^-1 = X * P^T, the column i of X is moved to the column perm[i]
+    for(size_t r = 0; r < n; r++)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            work[lu->perm[i]] = Q_MATRIX_AT(A, r, i);
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+            Q_MATRIX_AT(A, r, i) = work[i];
+        }
+    }
+
+    q_arena_release(mark); // Release the work vector
+}
+
+/**
+ * @brief This function computes the inverse of a matrix from its LU factorization.
+ * @details The factors are copied to the destination, which is then inverted in place (see q_lu_inverse_in_place). The
+ * factorization is left untouched.
+ *
+ * @param lu The LU factorization of A
+ * @param dst The reference to the inverse of A
+ */
+void q_lu_inverse(const q_lu_t* lu, q_matrix_t* dst)
+{
+    Q_LU_ASSERT(lu);
+    Q_MATRIX_ASSERT(dst);
+
+    const size_t n = lu->LU.rows;
+    assert((dst->rows == n) && (dst->cols == n) && "Destination matrix has a different shape than the factorized matrix when calculating the inverse");
+
+    q_lu_t inverse = *lu; // Shares the permutation, the factors are copied to the destination
+    inverse.LU = *dst;
+    q_matrix_cpy(&lu->LU, dst);
+    q_lu_inverse_in_place(&inverse);
+}
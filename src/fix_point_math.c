@@ -1,189 +1,459 @@
 #include "../include/fix_point_math.h"
+#include "../lib/table/fix_point_sin_table.h"
 
 /**
- * @brief This functions multiplies two fixed point numbers (a*b)
- * 
- * @param a The first fixed point number
- * @param b The second fixed point number
- * @return q_t The result of the multiplication
- */
-inline q_t q_product(q_t a, q_t b) {
-    /*
-        In order to perform the multiplication we need to upscale one of the fix point number in order to allow for the overflow
-        that may occur during the multiplication. Then downscale the result to the original format.
-    */
-    return ((q_long_t) a * b) >> FRACTIONAL_BITS;
-}
-
-/**
- * @brief This function divides two fixed point numbers (a/b)
- * 
- * @param a The numerator of the division
- * @param b The denominator of the division
- * @return q_t The result of the division
+ * @brief Product of two fixed point numbers rescaled with the given rounding and saturated
  */
-inline q_t q_division(q_t a, q_t b) {
-    /*
-        In order to perform the division we need to upscale the numerator in order to allow for the overflow that occurs when
-        performing the fractional bit shift.
-    */
-    return (((q_long_t) (a) << FRACTIONAL_BITS) / b);
+static inline q_t q_product_round(q_t a, q_t b, q_round_t round)
+{
+    const q_long_t half = (round == Q_ROUND_NEAREST) ? ((q_long_t) 1 << (FRACTIONAL_BITS - 1)) : 0;
+    return q_saturate((q_acc_t) (((q_long_t) a * b + half) >> FRACTIONAL_BITS));
 }
 
 /**
- * @brief This function returns the absolute value of a fixed point number
- * 
- * @param a The fixed point number to get the absolute value of
- * @return q_t The absolute value of the fixed point number
+ * @brief This function raises a fixed point number to an integer power (a^n), the products are rounded to the nearest
+ * @details See q_int_power_round.
+ *
+ * @param a The fixed point number to be raised to a power
+ * @param n The power to raise the fixed point number to
+ * @return q_t  The result of the fixed point number raised to the power
  */
-inline q_t q_absolute(q_t a){
-    q_t mask = a >> (Q_FORM_INT_BITS - 1); // mask = 0xFFFFFFFF if a is negative, 0x00000000 otherwise
-    // if a is negative, return -a, otherwise return a
-    return (a ^ mask) - mask; 
+q_t q_int_power(q_t a, int32_t n){
+    return q_int_power_round(a, n, Q_ROUND_NEAREST);
 }
 
 /**
- * @brief This function raises a fixed point number to an integer power (a^n)
- * 
+ * @brief This function raises a fixed point number to an integer power (a^n) with the given rounding of the products
+ * @details Exponentiation by squaring: the bits of |n| are read from the lowest, the factor a^(2^k) is squared once per
+ * bit and multiplied into the result when the bit is set, at most 2 * log2(|n|) products and no recursion. The last square
+ * is not computed, a factor that is not used can not saturate. Every product is rounded as requested and saturated. A
+ * negative power is the power of the reciprocal q_reciprocal(a) (truncated), which keeps the precision of a large 1/a.
+ *
+ * @example
+ * q_t decay = q_int_power_round(float_to_q(0.99f), 100, Q_ROUND_NEAREST); // 0.99^100, 7 squares and 3 products
+ *
  * @param a The fixed point number to be raised to a power
  * @param n The power to raise the fixed point number to
- * @return q_t  The result of the fixed point number raised to the power
+ * @param round The rounding of the products
+ * @return q_t The result of the fixed point number raised to the power, saturated
  */
-q_t q_int_power(q_t a, int32_t n){
+q_t q_int_power_round(q_t a, int32_t n, q_round_t round){
     if (n == 0) return Q_ONE; // a^0 = 1
     if (a == 0) return Q_ZERO; // 0^n = 0
 
+    uint32_t e = (uint32_t) n;
     if (n < 0) {
-        a = q_division(INT_TO_Q(1), a); // a^(-n) = 1/(a^n)
-        n = -n;
+        a = q_reciprocal(a); // a^(-n) = (1/a)^n
+        e = -(uint32_t) n;
     }
 
-    return q_product(a, q_int_power(a, n - 1));
+    q_t result = a; // The lowest set bit of e starts the result without a multiplication by one
+    while((e & 1) == 0)
+    {
+        result = q_product_round(result, result, round);
+        e >>= 1;
+    }
+
+    q_t factor = result;
+    for(e >>= 1; e != 0; e >>= 1)
+    {
+        factor = q_product_round(factor, factor, round);
+        if(e & 1)
+        {
+            result = q_product_round(result, factor, round);
+        }
+    }
+
+    return result;
 }
 
 //TODO: Add q_float_power
 
 /**
- * @brief The square root of a fixed point number using Newton's method (a^(1/2))
- * 
+ * @brief Returns the integer square root of a 64 bits value, rounded to the nearest.
+ * @details The root is computed digit by digit, two bits of the value per bit of the root, with shifts, additions and
+ * comparisons only. The first digit comes from the count of leading zeros, so the loop runs once per bit of the root.
+ *
+ * @param x The value
+ * @return uint64_t The square root of the value
+ */
+static inline uint64_t q_isqrt64(uint64_t x)
+{
+    if(x == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rem = x;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t) 1 << ((63 - __builtin_clzll(x)) & ~1); // Largest power of 4 not above x
+
+    while(bit != 0)
+    {
+        const uint64_t trial = root + bit;
+        const uint64_t take = (uint64_t) 0 - (rem >= trial); // All ones when the digit is 1, selects without a branch
+        rem -= trial & take;
+        root = (root >> 1) + (bit & take);
+        bit >>= 2;
+    }
+
+    return root + (rem > root); // Round to the nearest
+}
+
+/**
+ * @brief Returns 1 / sqrt(m) in Q29 for a mantissa m in Q30 in [1/4, 1).
+ * @details Seed 2.13 - 1.2175 * m (relative error below 9 %) and four Newton steps y = y * (3 - m * y^2) / 2 with 32 bits
+ * operands, products and shifts only. The relative error is about 2^-28.
+ */
+static inline uint64_t q_rsqrt_mantissa(uint64_t m)
+{
+    uint64_t y = 1143535043 - ((653640335 * m) >> 30); // 2.13 and 1.2175 in Q29
+
+    for(int step = 0; step < 4; step++)
+    {
+        const uint64_t y2 = (y * y) >> 30;                   // Q28
+        const uint64_t t = 3 * (1 << 29) - ((m * y2) >> 29); // Q29
+        y = (y * t) >> 30;
+    }
+
+    return y;
+}
+
+/**
+ * @brief The square root of a fixed point number (a^(1/2))
+ * @details sqrt(a) in the Q format is the integer square root r of x = a * 2^FRACTIONAL_BITS, which fits in 64 bits for
+ * every format. x is shifted by an even count of leading zeros into a mantissa m in [1/4, 1), r is m * (1 / sqrt(m))
+ * shifted back, then corrected by a unit until r^2 - r < x <= r^2 + r: the result is sqrt(x) rounded to the nearest, exact
+ * and without division.
+ *
  * @param a The fixed point number to get the square root of
  * @return q_t The square root of the fixed point number
  */
 q_t q_sqrt(q_t a){
     assert(a >= 0 && "The square root of a negative number is not a real number"); // The square root of a negative number is not a real number
 
-    if (a == 0) return Q_ZERO; // sqrt(0) = 0
+    const uint64_t x = (uint64_t) a << FRACTIONAL_BITS;
+    if(x == 0)
+    {
+        return Q_ZERO;
+    }
 
-    const q_t TWO     = INT_TO_Q(2);
-    const q_t EPSILON = float_to_q(0.001);
+    const int s = (__builtin_clzll(x) - 2) & ~1;
+    const uint64_t m = (x << s) >> 32;                     // Q30 in [1/4, 1)
+    const uint64_t root = (m * q_rsqrt_mantissa(m)) >> 29; // sqrt(m) in Q30
 
-    q_t Y = Q_ONE;
-    uint8_t n = 10; // max Number of iterations
-    // Newton's method for square root
-    while((q_absolute(q_division(a, Y) - Y) > EPSILON) && (n > 0)){
-        Y = q_division(q_division(a, Y) + Y, TWO);
-        n--;
+    uint64_t r = (root << 1) >> (s / 2); // x = m * 2^(62 - s)
+    while(r * r + r < x)
+    {
+        r++;
+    }
+    while(r * r - r >= x)
+    {
+        r--;
     }
 
-    return Y;
+    return (q_t) r;
 }
 
 /**
- * @brief This function returns the sine of a fixed point number (sin(a))
- * 
- * @param a The angle in radians
- * @return q_t Returns the sine of the angle
+ * @brief The reciprocal square root of a fixed point number (a^(-1/2)), to normalize vectors with products instead of
+ * divisions.
+ * @details a is shifted by a count of leading zeros s into a mantissa m in [1/4, 1), s having the parity of
+ * FRACTIONAL_BITS so the exponent halves exactly, and 1 / sqrt(m) is shifted back. The result is within one unit of the
+ * last place and saturated (a tiny a in a format with few integer bits).
+ *
+ * @example
+ * q_t inv = q_rsqrt(q_product(x, x) + q_product(y, y));
+ * x = q_product(x, inv); // (x, y) has a unit length
+ * y = q_product(y, inv);
+ *
+ * @param a The fixed point number, positive
+ * @return q_t The reciprocal square root of the fixed point number
  */
-q_t q_sin(q_t a)
+q_t q_rsqrt(q_t a){
+    assert(a > 0 && "The reciprocal square root is only defined for positive numbers");
+
+    const uint64_t x = (uint64_t) a;
+    int s = __builtin_clzll(x) - 2;
+    s -= (s - FRACTIONAL_BITS) & 1;
+
+    const uint64_t y = q_rsqrt_mantissa((x << s) >> 32); // Q29
+
+    // a = m * 2^(62 - s - FRACTIONAL_BITS), 1 / sqrt(a) = y * 2^(FRACTIONAL_BITS - 29 - (62 - s - FRACTIONAL_BITS) / 2) in Q format
+    const int shift = 29 + (62 - s - FRACTIONAL_BITS) / 2 - FRACTIONAL_BITS;
+    const uint64_t r = (shift > 0) ? ((y + ((uint64_t) 1 << (shift - 1))) >> shift) : (y << -shift);
+
+    return (r > (uint64_t) Q_RAW_MAX) ? Q_RAW_MAX : (q_t) r;
+}
+
+// 1 / m in Q15 for the mantissas m in [1/2, 1), the entry i is the reciprocal of the middle of [1/2 + i/512, 1/2 + (i+1)/512)
+static const uint16_t q_reciprocal_seed[256] = {
+    65408, 65154, 64902, 64652, 64404, 64158, 63913, 63671, 63430, 63191, 62954, 62719, 62485, 62253, 62023, 61795,
+    61568, 61343, 61119, 60897, 60677, 60458, 60241, 60026, 59812, 59599, 59388, 59179, 58971, 58764, 58559, 58356,
+    58153, 57952, 57753, 57555, 57358, 57163, 56968, 56776, 56584, 56394, 56205, 56017, 55831, 55646, 55462, 55279,
+    55098, 54917, 54738, 54560, 54383, 54207, 54033, 53859, 53687, 53516, 53346, 53177, 53009, 52842, 52676, 52511,
+    52347, 52184, 52022, 51862, 51702, 51543, 51385, 51228, 51072, 50917, 50763, 50610, 50458, 50306, 50156, 50007,
+    49858, 49710, 49563, 49417, 49272, 49128, 48985, 48842, 48700, 48559, 48419, 48280, 48141, 48003, 47867, 47730,
+    47595, 47460, 47326, 47193, 47061, 46929, 46798, 46668, 46539, 46410, 46282, 46155, 46028, 45902, 45777, 45652,
+    45528, 45405, 45283, 45161, 45040, 44919, 44799, 44680, 44561, 44443, 44326, 44209, 44093, 43977, 43862, 43748,
+    43634, 43521, 43408, 43296, 43185, 43074, 42963, 42854, 42744, 42636, 42528, 42420, 42313, 42207, 42101, 41996,
+    41891, 41786, 41683, 41579, 41476, 41374, 41272, 41171, 41070, 40970, 40870, 40771, 40672, 40574, 40476, 40378,
+    40281, 40185, 40089, 39993, 39898, 39804, 39709, 39616, 39522, 39429, 39337, 39245, 39153, 39062, 38971, 38881,
+    38791, 38702, 38613, 38524, 38436, 38348, 38260, 38173, 38087, 38000, 37915, 37829, 37744, 37659, 37575, 37491,
+    37407, 37324, 37241, 37159, 37077, 36995, 36914, 36833, 36752, 36672, 36592, 36512, 36433, 36354, 36275, 36197,
+    36119, 36041, 35964, 35887, 35810, 35734, 35658, 35583, 35507, 35432, 35358, 35283, 35209, 35136, 35062, 34989,
+    34916, 34844, 34771, 34700, 34628, 34557, 34486, 34415, 34344, 34274, 34204, 34135, 34065, 33996, 33928, 33859,
+    33791, 33723, 33655, 33588, 33521, 33454, 33387, 33321, 33255, 33189, 33124, 33059, 32994, 32929, 32864, 32800,
+};
+
+/**
+ * @brief The reciprocal of a fixed point number (1/a) without division
+ * @details |a| is shifted by its count of leading zeros into a mantissa m in [1/2, 1) (Q32). The 8 bits below the leading
+ * one select a seed of 1 / m (relative error below 2^-9), a Newton step y = y * (2 - m * y) in Q30 brings it to about 2^-18
+ * and a second one in Q62 to about 2^-36. Newton steps approach 1 / m from below, so the shifted result is the truncated
+ * quotient or one unit under it and a single comparison corrects it: the result is the same as q_division(Q_ONE, a),
+ * truncated toward zero, but saturated when 1/a is out of the Q range.
+ *
+ * @example
+ * const q_t inv = q_reciprocal(norm);
+ * x = q_product(x, inv); // Cheaper than two divisions when the same norm divides several values
+ * y = q_product(y, inv);
+ *
+ * @param a The fixed point number, not zero
+ * @return q_t The reciprocal of the fixed point number
+ */
+q_t q_reciprocal(q_t a){
+    assert((a != Q_ZERO) && "Division by zero (Can not calculate the reciprocal)");
+
+    const uint64_t u = (a < 0) ? -(uint64_t) a : (uint64_t) a; // |a| <= 2^31, also for Q_RAW_MIN
+    const int s = __builtin_clzll(u) - 32;
+    const uint64_t m = u << s; // Q32 in [1/2, 1)
+
+    uint64_t y = (uint64_t) q_reciprocal_seed[(m >> 23) & 255] << 15; // Q30
+    const uint64_t t = (((uint64_t) 1 << 63) - m * y) >> 32;           // 2 - m * y in Q30
+    y = (y * t) >> 30;
+
+    // Second step in Q62: y * (2 - m * y) = y + y * (1 - m * y), 1 - m * y is below 2^-17 and not negative
+    const uint64_t delta = ((uint64_t) 1 << 62) - m * y; // Q62
+    y = (y << 32) + ((y * (delta >> 14)) >> 16);
+
+    // |a| = m * 2^(-s) raw units, 1/a = y * 2^(2 * FRACTIONAL_BITS + s - 94) raw units
+    uint64_t r = y >> (94 - 2 * FRACTIONAL_BITS - s);
+    r += ((r + 1) * u <= ((uint64_t) 1 << (2 * FRACTIONAL_BITS)));
+
+    // Saturation and sign without a branch, the magnitude of a negative result goes up to |Q_RAW_MIN|
+    const uint64_t negative = (a < 0);
+    const uint64_t limit = (uint64_t) Q_RAW_MAX + negative;
+    r = (r > limit) ? limit : r;
+    return (q_t) ((r ^ -negative) + negative);
+}
+
+/**
+ * @brief Prepares a divisor for q_division_prepared
+ * @details The magic number ceil(2^(shift + FRACTIONAL_BITS) / |d|) with shift = Q_FORM_INT_BITS - 1 + ceil(log2(|d|))
+ * (the round-up method of Granlund and Montgomery) costs one wide division, every quotient by d is then a multiplication
+ * and a shift.
+ *
+ * @example
+ * const q_divisor_t d = q_divisor_prepare(diagonal);
+ * for(size_t c = 0; c < k; c++)
+ * {
+ *     x[c] = q_division_prepared(x[c], d); // Same as q_division(x[c], diagonal)
+ * }
+ *
+ * @param d The divisor, not zero
+ * @return q_divisor_t The prepared divisor
+ */
+q_divisor_t q_divisor_prepare(q_t d)
 {
-    // Pythagorean trigonometric identity Sin^2(a) + Cos^2(a) = 1 
-    // Sin(a) = sqrt(1 - cos(a)^2)
-    q_t ret = Q_ZERO;
+    assert((d != Q_ZERO) && "Division by zero (Can not prepare the divisor)");
+
+    const uint64_t magnitude = (d < 0) ? -(uint64_t) d : (uint64_t) d;
+    const int l = (magnitude == 1) ? 0 : (64 - __builtin_clzll(magnitude - 1)); // 2^(l - 1) < |d| <= 2^l
 
-    q_t x = a % Q_TWO_PI;
-    q_t sign = Q_ONE;
+    q_divisor_t divisor;
+    divisor.shift = Q_FORM_INT_BITS - 1 + l;
+    const q_acc_t numerator = (q_acc_t) 1 << (divisor.shift + FRACTIONAL_BITS);
+    divisor.magic = (q_long_t) ((numerator + (q_acc_t) magnitude - 1) / (q_acc_t) magnitude);
+    divisor.negative = (d < 0);
+    return divisor;
+}
 
-    if (x > Q_PI) {
-        x -= Q_TWO_PI;
+/**
+ * @brief Returns the integer square root of a wide value, rounded to the nearest.
+ * @details The root is computed digit by digit (two bits of the value per bit of the root) with shifts, additions and
+ * comparisons only. Values that fit in 64 bits take the 64 bits path.
+ *
+ * @param x The value, not negative
+ * @return q_acc_t The square root of the value
+ */
+q_acc_t q_isqrt(q_acc_t x)
+{
+    if((q_acc_t) (uint64_t) x == x)
+    {
+        return (q_acc_t) q_isqrt64((uint64_t) x);
     }
 
-    if (x < Q_NEG_PI) {
-        x += Q_TWO_PI;
+    q_acc_t rem = x;
+    q_acc_t root = 0;
+    q_acc_t bit = (q_acc_t) 1 << (sizeof(q_acc_t) * 8 - 2);
+
+    while(bit > rem)
+    {
+        bit >>= 2;
     }
 
-    // Adjust the sign based on the quadrant
-    if (x > 0) {
-        sign = Q_ONE;
-    } 
-    if (x < 0) {
-        sign = Q_MINUS_ONE;
+    while(bit != 0)
+    {
+        if(rem >= root + bit)
+        {
+            rem -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
     }
 
-    q_t _cos = q_cos(a);
-    q_t cos2 = q_product(_cos, _cos);
+    if(rem > root)
+    {
+        root++; // Round to the nearest
+    }
+
+    return root;
+}
+
+/**
+ * @brief Returns the square root of a sum of full products (scale 2^(2 * FRACTIONAL_BITS)) as a fixed point number.
+ * @details The integer square root is computed on the wide value, so the norms do not overflow q_t before the square root
+ * is taken and keep the full resolution. The sum must come from full products (q_long_t) even when Q_ACCUMULATE_WIDE is
+ * disabled. The result is rounded to the nearest and saturated.
+ *
+ * @param sum The sum of the squares, not negative
+ * @return q_t The square root of the sum
+ */
+q_t q_sqrt_acc(q_acc_t sum)
+{
+    return q_saturate(q_isqrt(sum));
+}
+
+/**
+ * @brief Reduces an angle to a phase: 2^32 units per turn, the full turns overflow out of the 32 bits
+ * @details a * 2^32 / (2 * pi) with the constant 2^34 / (2 * pi) rounded to 32 bits, the error is below 2^(28 - FRACTIONAL_BITS)
+ * phase units for every q_t (6e-6 rad for 16 fractional bits, under the resolution of the angle).
+ */
+static inline uint32_t q_trig_phase(q_t a)
+{
+    const int64_t turn = 2734261102; // 2^34 / (2 * pi)
+    return (uint32_t) (((int64_t) a * turn + ((int64_t) 1 << (FRACTIONAL_BITS + 1))) >> (FRACTIONAL_BITS + 2));
+}
+
+#define Q_TRIG_QUARTER       ((uint32_t) 1 << 30)      // Phase of pi / 2
+#define Q_TRIG_FRACTION_BITS (30 - Q_TRIG_TABLE_BITS) // Phase bits between two entries of the table
+
+/**
+ * @brief sin(p * pi / 2^31) in Q2.30 for a phase p in [0, 2^30], interpolated in the quarter-wave table
+ */
+static inline int64_t q_trig_quarter(uint32_t p)
+{
+    const int32_t* y = &q_sin_table[p >> Q_TRIG_FRACTION_BITS];
+    const int64_t t = p & ((1 << Q_TRIG_FRACTION_BITS) - 1); // Position between y[0] and y[1], 2^Q_TRIG_FRACTION_BITS is one
+
+    int64_t r = y[0] + ((((int64_t) y[1] - y[0]) * t + (1 << (Q_TRIG_FRACTION_BITS - 1))) >> Q_TRIG_FRACTION_BITS);
+#if Q_TRIG_INTERPOLATION == Q_TRIG_QUADRATIC
+    const int64_t curvature = (int64_t) y[2] - 2 * (int64_t) y[1] + y[0];
+    r += (curvature * ((t * (t - (1 << Q_TRIG_FRACTION_BITS))) >> Q_TRIG_FRACTION_BITS)) >> (Q_TRIG_FRACTION_BITS + 1);
+#endif
+    return r;
+}
 
-    ret = Q_ONE - cos2;
-    ret = q_sqrt(ret);
+/**
+ * @brief sin(phase * 2 * pi / 2^32) in Q2.30: the second and fourth quarters read the table backwards, the lower half
+ * circle is negative. The quadrant is applied without a branch.
+ */
+static inline int64_t q_trig_sin_phase(uint32_t phase)
+{
+    const uint32_t p = phase & (Q_TRIG_QUARTER - 1);
+    const uint32_t mirror = -((phase >> 30) & 1);       // All ones in the second and fourth quarters
+    const int64_t negative = -(int64_t) (phase >> 31); // All ones in the lower half circle
+    const int64_t r = q_trig_quarter((p & ~mirror) | ((Q_TRIG_QUARTER - p) & mirror));
+    return (r ^ negative) - negative;
+}
 
-    ret = q_product(ret, sign);
+/**
+ * @brief Rounds a Q2.30 value of the table engine to the Q format, saturated (1 is out of range of the Q0.n formats)
+ */
+static inline q_t q_trig_to_q(int64_t r)
+{
+#if FRACTIONAL_BITS <= 30
+    return q_saturate((q_acc_t) ((r + ((1LL << (30 - FRACTIONAL_BITS)) >> 1)) >> (30 - FRACTIONAL_BITS)));
+#else
+    return q_saturate((q_acc_t) r << (FRACTIONAL_BITS - 30));
+#endif
+}
 
-    return ret;
+/**
+ * @brief This function returns the sine of a fixed point number (sin(a))
+ * @details The angle is reduced to a phase of 2^32 units per turn and the sine is interpolated in the quarter-wave table
+ * (see Q_TRIG_INTERPOLATION), no division and no branch.
+ * 
+ * @param a The angle in radians
+ * @return q_t Returns the sine of the angle
+ */
+q_t q_sin(q_t a)
+{
+    return q_trig_to_q(q_trig_sin_phase(q_trig_phase(a)));
 }
 
 /**
  * @brief This function returns the cosine of a fixed point number (cos(a))
+ * @details cos(a) = sin(a + pi / 2), a quarter turn added to the phase (see q_sin).
  * 
  * @param a The angle in radians
  * @return q_t The cosine of the angle
  */
 q_t q_cos(q_t a){
-    // Bhaskara II's cosine approximation
-    // cos(y) \approx = \frac{pi^{2} - 4y^{2}}}{pi^{2} + y^{2}} 
-    q_t ret = Q_ZERO;
-    q_t sign = Q_ONE;
-
-    q_t x = a % Q_TWO_PI;
-    
-    if (x > Q_PI) {
-        x -= Q_TWO_PI;
-    } 
-    if (x < Q_NEG_PI) {
-        x += Q_TWO_PI;
-    }
-
-    // Adjust the sign based on the quadrant
-    if (x > Q_HALF_PI) {
-        x = Q_PI - x;
-        sign = Q_MINUS_ONE;
-    } else if (x < Q_NEG_HALF_PI) {
-        x = Q_NEG_PI - x;
-        sign = Q_MINUS_ONE;
-    }
-
-    q_t pi2 = q_product(Q_PI, Q_PI);
-    q_t x2 = q_product(x, x);
-    q_t x2_4 = x2 + x2 + x2 + x2;
-
-    q_t num = pi2 - x2_4;
-    q_t den = pi2 + x2;
-
-    ret = q_division(num, den);
+    return q_trig_to_q(q_trig_sin_phase(q_trig_phase(a) + Q_TRIG_QUARTER));
+}
 
-    return q_product(ret, sign);
+/**
+ * @brief The sine and the cosine of a fixed point number from a single range reduction
+ * @details The results are the same as q_sin(a) and q_cos(a).
+ *
+ * @example
+ * q_t s, c;
+ * q_sincos(theta, &s, &c);
+ * const q_t x = q_product(c, px) - q_product(s, py); // Rotation of (px, py) by theta
+ * const q_t y = q_product(s, px) + q_product(c, py);
+ *
+ * @param a The angle in radians
+ * @param sin The sine of the angle
+ * @param cos The cosine of the angle
+ */
+void q_sincos(q_t a, q_t* sin, q_t* cos){
+    const uint32_t phase = q_trig_phase(a);
+    *sin = q_trig_to_q(q_trig_sin_phase(phase));
+    *cos = q_trig_to_q(q_trig_sin_phase(phase + Q_TRIG_QUARTER));
 }
 
 /**
  * @brief The tangent of a fixed point number (tan(a))
+ * @details sin(a) / cos(a) from q_sincos, saturated near the asymptotes (infinity is not possible in fixed point because of
+ * the limited range of the data type).
  * 
  * @param a The angle in radians
  * @return q_t The tangent of the angle
  */
 q_t q_tan(q_t a){
-    // tan(a) = sin(a)/cos(a)
-    if (q_cos(a) <= (2*Q_RESOLUTION) && q_cos(a) >= (-2*Q_RESOLUTION)){
-        return INT_TO_Q(Q_MAX_INT); // Infinity is not possible in fixed point because of the limited range of the data type
+    q_t s, c;
+    q_sincos(a, &s, &c);
+
+    if (c == Q_ZERO){
+        return (s >= 0) ? Q_RAW_MAX : Q_RAW_MIN;
     }
-    return q_division(q_sin(a), q_cos(a)); 
+    return q_saturate((q_acc_t) (((q_long_t) s * ((q_long_t) 1 << FRACTIONAL_BITS)) / c));
 }
 
 /**
@@ -1,4 +1,8 @@
 #include "../include/fix_point_matrix.h"
+#include "../include/fix_point_gemm.h"
+#include "../include/fix_point_simd.h"
+#include "../include/fix_point_arena.h"
+#include "../include/fix_point_lu.h"
 
 // MARK: Matrix allocation
 
@@ -20,9 +24,145 @@ q_matrix_t q_matrix_alloc(size_t rows, size_t cols)
     m.stride   = cols;
     m.elements = (q_t*) calloc(rows * cols, sizeof(q_t)); // Allocate memory for the matrix elements with 0 initialization
     assert((m.elements != NULL) && "Memory allocation failed"); // Check if the memory allocation was successful
+    q_arena_count_heap_allocation();
     return m;
 }
 
+/**
+ * @brief This function allocates a matrix whose rows start on a Q_MATRIX_ALIGNMENT byte boundary.
+ * @details The buffer is aligned to Q_MATRIX_ALIGNMENT bytes and the row stride is padded up to a multiple of
+ * Q_MATRIX_ALIGNMENT / sizeof(q_t) elements, so the vector loops never split a load across two cache lines at the start
+ * of a row whatever the number of columns (e.g. 17 x 17 is stored with a stride of 32). The padding is zero and never read
+ * by the library. The matrix is freed with q_matrix_free and accepted by every function of the library.
+ * 
+ * @example
+ * q_matrix_t m = q_matrix_alloc_aligned(17, 17); // m.stride == 32 with the default Q16.16 format
+ * q_ones(&m);
+ * q_matrix_free(&m);
+ * 
+ * @param rows The number of rows in the matrix
+ * @param cols The number of columns in the matrix
+ * @return q_matrix_t The matrix of fixed point numbers
+ */
+q_matrix_t q_matrix_alloc_aligned(size_t rows, size_t cols)
+{
+    assert((rows > 0) && "Number of rows must be greater than 0 when allocating a matrix");
+    assert((cols > 0) && "Number of columns must be greater than 0 when allocating a matrix");
+
+    const size_t lanes = Q_MATRIX_ALIGNMENT / sizeof(q_t); // Elements per aligned block
+
+    q_matrix_t m;
+    m.rows     = rows;
+    m.cols     = cols;
+    m.stride   = (cols + lanes - 1) / lanes * lanes;
+    m.elements = NULL;
+
+    const size_t size = rows * m.stride * sizeof(q_t);
+    if(posix_memalign((void**) &m.elements, Q_MATRIX_ALIGNMENT, size) != 0)
+    {
+        m.elements = NULL;
+    }
+    assert((m.elements != NULL) && "Memory allocation failed"); // Check if the memory allocation was successful
+    q_arena_count_heap_allocation();
+    memset(m.elements, 0, size);
+    return m;
+}
+
+// MARK: Matrix views
+
+/**
+ * @brief The function returns a view of a block of the matrix.
+ * @details A view shares the buffer of the parent matrix: no memory is allocated and the writes through the view modify
+ * the parent. The view keeps the stride of the parent, so it can be passed to every function of the library (a view of
+ * a view is valid as well). A view does not own its elements and must not be freed, it is valid while the parent is.
+ * 
+ * @example
+ * q_matrix_t m = q_matrix_alloc(4, 4);
+ * q_matrix_t block = q_matrix_view(&m, 1, 1, 2, 2);
+ * q_ones(&block);
+ * Q_MATRIX_PRINT(m);
+ * 
+ * Output:
+ * m: [
+ * 0.000000, 0.000000, 0.000000, 0.000000,
+ * 0.000000, 1.000000, 1.000000, 0.000000,
+ * 0.000000, 1.000000, 1.000000, 0.000000,
+ * 0.000000, 0.000000, 0.000000, 0.000000,
+ * ]
+ * 
+ * @param m The reference to the parent matrix
+ * @param row The first row of the block
+ * @param col The first column of the block
+ * @param rows The number of rows of the block
+ * @param cols The number of columns of the block
+ * @return q_matrix_t The view of the block
+ */
+q_matrix_t q_matrix_view(const q_matrix_t* m, size_t row, size_t col, size_t rows, size_t cols)
+{
+    return q_matrix_view_strided(m, row, col, rows, cols, 1);
+}
+
+/**
+ * @brief The function returns a view of every row_step-th row of a block of the matrix.
+ * @details The view starts at (row, col) and its i-th row is the row (row + i * row_step) of the parent, the columns stay
+ * contiguous. See q_matrix_view for the ownership rules.
+ * 
+ * @example
+ * q_matrix_t m = q_matrix_alloc(4, 2);
+ * q_matrix_t even = q_matrix_view_strided(&m, 0, 0, 2, 2, 2); // Rows 0 and 2
+ * 
+ * @param m The reference to the parent matrix
+ * @param row The first row of the view
+ * @param col The first column of the view
+ * @param rows The number of rows of the view
+ * @param cols The number of columns of the view
+ * @param row_step The distance between two consecutive rows of the view in rows of the parent
+ * @return q_matrix_t The strided view
+ */
+q_matrix_t q_matrix_view_strided(const q_matrix_t* m, size_t row, size_t col, size_t rows, size_t cols, size_t row_step)
+{
+    Q_MATRIX_ASSERT(m);
+
+    assert((rows > 0) && "Number of rows must be greater than 0 for a matrix view");
+    assert((cols > 0) && "Number of columns must be greater than 0 for a matrix view");
+    assert((row_step > 0) && "Row step must be greater than 0 for a matrix view");
+    assert((row + (rows - 1) * row_step < m->rows) && "Selected rows out of bounds for the matrix view");
+    assert((col + cols <= m->cols) && "Selected columns out of bounds for the matrix view");
+
+    q_matrix_t view;
+    view.rows     = rows;
+    view.cols     = cols;
+    view.stride   = m->stride * row_step;
+    view.elements = &Q_MATRIX_AT(m, row, col);
+    return view;
+}
+
+/**
+ * @brief The function returns a 1 x N view of a row of the matrix (see q_matrix_view).
+ * 
+ * @param m The reference to the parent matrix
+ * @param row The row number, zero-based
+ * @return q_matrix_t The view of the row
+ */
+q_matrix_t q_matrix_view_row(const q_matrix_t* m, size_t row)
+{
+    Q_MATRIX_ASSERT(m);
+    return q_matrix_view(m, row, 0, 1, m->cols);
+}
+
+/**
+ * @brief The function returns a N x 1 view of a column of the matrix (see q_matrix_view).
+ * 
+ * @param m The reference to the parent matrix
+ * @param col The column number, zero-based
+ * @return q_matrix_t The view of the column
+ */
+q_matrix_t q_matrix_view_col(const q_matrix_t* m, size_t col)
+{
+    Q_MATRIX_ASSERT(m);
+    return q_matrix_view(m, 0, col, m->rows, 1);
+}
+
 // MARK: Matrix manipulation
 
 /**
@@ -63,9 +203,8 @@ void q_matrix_slice_row(const q_matrix_t* m, q_matrix_t* dst, size_t row)
     // Assert that the destination matrix has the same number of columns as the source matrix
     assert((dst->cols == m->cols) && "Destination matrix has different number of columns for the row slice");
 
-    for(size_t j = 0; j < m->cols; j++){
-        Q_MATRIX_AT(dst, 0, j) = Q_MATRIX_AT(m, row, j);
-    }
+    q_matrix_t view = q_matrix_view_row(m, row);
+    q_matrix_cpy(&view, dst);
 }
 
 /**
@@ -108,9 +247,8 @@ void q_matrix_slice_col(const q_matrix_t* m, q_matrix_t* dst, size_t col)
     // Assert that the destination matrix has the same number of rows as the source matrix
     assert((dst->rows == m->rows) && "Destination matrix has different number of rows for the column slice");
 
-    for(size_t i = 0; i < m->rows; i++){
-        Q_MATRIX_AT(dst, i, 0) = Q_MATRIX_AT(m, i, col);
-    }
+    q_matrix_t view = q_matrix_view_col(m, col);
+    q_matrix_cpy(&view, dst);
 }
 
 /** @brief The function returns a submatrix of the matrix with the specified row and column
@@ -271,7 +409,10 @@ void q_matrix_switch_rows(const q_matrix_t* m, q_matrix_t* dst, size_t row1, siz
     assert((m->cols == dst->cols) && "Source and destination matrices have different number of columns (Can not switch rows)");
     assert((m->rows == dst->rows) && "Source and destination matrices have different number of rows (Can not switch rows)");
 
-    q_matrix_cpy(m, dst); // Copy the source matrix to the destination matrix
+    if(m != dst)
+    {
+        q_matrix_cpy(m, dst); // Copy the source matrix to the destination matrix (in-place switches skip the copy)
+    }
 
     for(size_t j = 0; j < m->cols; j++)
     {
@@ -327,7 +468,10 @@ void q_matrix_switch_cols(const q_matrix_t* m, q_matrix_t* dst, size_t col1, siz
     assert((m->cols == dst->cols) && "Source and destination matrices have different number of columns (Can not switch columns)");
     assert((m->rows == dst->rows) && "Source and destination matrices have different number of rows (Can not switch columns)");
 
-    q_matrix_cpy(m, dst); // Copy the source matrix to the destination matrix
+    if(m != dst)
+    {
+        q_matrix_cpy(m, dst); // Copy the source matrix to the destination matrix (in-place switches skip the copy)
+    }
 
     for(size_t i = 0; i < m->rows; i++)
     {
@@ -361,10 +505,16 @@ void q_matrix_fill(const q_matrix_t* m, q_t value)
 {
     Q_MATRIX_ASSERT(m);
 
+    const q_simd_kernels_t* kernels = q_simd_kernels();
+
+    if(m->stride == m->cols)
+    {
+        kernels->fill(m->elements, value, m->rows * m->cols); // The rows are contiguous, fill them all at once
+        return;
+    }
+
     for(size_t i = 0; i < m->rows; i++){
-        for(size_t j = 0; j < m->cols; j++){
-            Q_MATRIX_AT(m, i, j) = value;
-        }
+        kernels->fill(&Q_MATRIX_AT(m, i, 0), value, m->cols);
     }
 }
 
@@ -519,19 +669,22 @@ void q_matrix_LU_decomposition(const q_matrix_t* m, q_matrix_t* L, q_matrix_t* U
     q_matrix_cpy(m, U); // Copy the input matrix to the upper triangular matrix
     q_matrix_identity(L); // Fill the lower triangular matrix with the identity matrix
 
-    for(size_t i = 0; i < m->rows; i++)
+    for(size_t i = 0; i + 1 < m->rows; i++)
     {
+        // If the diagonal element is zero, the matrix is singular
+            // In this case, the LU decomposition is not possible
+        assert((Q_MATRIX_AT(U, i, i) != Q_ZERO) && "Matrix is singular (LU decomposition is not possible)");
+
+        // The whole column is divided by the same pivot, multiplications replace the divisions
+        const q_divisor_t pivot = q_divisor_prepare(Q_MATRIX_AT(U, i, i));
+
         for(size_t j = i + 1; j < m->rows; j++)
         {
             // Calculate the elements of the lower triangular matrix
             /*
             L[i][j] = U[i][j] / U[i][i]
             */
-            // If the diagonal element is zero, the matrix is singular
-                // In this case, the LU decomposition is not possible
-            assert((Q_MATRIX_AT(U, i, i) != Q_ZERO) && "Matrix is singular (LU decomposition is not possible)");
-
-            Q_MATRIX_AT(L, j, i) = q_division(Q_MATRIX_AT(U, j, i), Q_MATRIX_AT(U, i, i));
+            Q_MATRIX_AT(L, j, i) = q_division_prepared(Q_MATRIX_AT(U, j, i), pivot);
             for(size_t k = i; k < m->rows; k++)
             {
                 // Calculate the elements of the upper triangular matrix
@@ -559,7 +712,9 @@ void q_matrix_LU_decomposition(const q_matrix_t* m, q_matrix_t* L, q_matrix_t* U
  * L is the lower triangular matrix
  * U is the upper triangular matrix
  * 
- * The PLU decomposition is calculated using the Doolittle algorithm.
+ * The PLU decomposition is calculated in a single pass of the Doolittle algorithm with partial pivoting. At every step the row
+ * with the largest absolute value in the current column is swapped in place into the pivot position and the rows below are eliminated,
+ * which makes the decomposition O(n^3) without any temporary matrix.
  *
  * @example:
  * q_matrix_t m = q_matrix_alloc(3, 3);
@@ -624,19 +779,24 @@ void q_matrix_PLU_decomposition(const q_matrix_t* m , q_matrix_t* P, q_matrix_t*
     Q_MATRIX_ASSERT(L);
     Q_MATRIX_ASSERT(U);
 
-    q_matrix_t temp = q_matrix_alloc(m->rows, m->cols);
+    assert((m->rows == m->cols) && "Matrix is not square shape when performing PLU decomposition");
+    assert((P->rows == m->rows) && (P->cols == m->cols) && "Matrix P has different dimensions than the input matrix");
+    assert((L->rows == m->rows) && (L->cols == m->cols) && "Matrix L has different dimensions than the input matrix");
+    assert((U->rows == m->rows) && (U->cols == m->cols) && "Matrix U has different dimensions than the input matrix");
+
+    const size_t n = m->rows;
+
     q_matrix_identity(P); // Fill the permutation matrix with the identity matrix
     q_matrix_identity(L); // Fill the lower triangular matrix with the identity matrix    
-    q_matrix_cpy(m, U); // Copy the input matrix to the upper triangular matrix
-    q_matrix_cpy(m, &temp); // Copy the input matrix to the temporary matrix
+    q_matrix_cpy(m, U); // Copy the input matrix to the upper triangular matrix, the elimination is performed in place
 
-    for(size_t i = 0; i < m->rows; i++)
+    for(size_t i = 0; i < n; i++)
     {
-        // Find the pivot element
+        // Find the pivot element (largest absolute value of the column i on and below the diagonal)
         size_t max_idx = i;
-        q_t max_val = q_absolute(Q_MATRIX_AT(U, max_idx, i));
+        q_t max_val = q_absolute(Q_MATRIX_AT(U, i, i));
 
-        for(size_t j = i; j < m->cols; j++)
+        for(size_t j = i + 1; j < n; j++)
         {
             q_t val = q_absolute(Q_MATRIX_AT(U, j, i));
             if(val > max_val)
@@ -646,19 +806,152 @@ void q_matrix_PLU_decomposition(const q_matrix_t* m , q_matrix_t* P, q_matrix_t*
             }
         }
 
-        // Swap the rows of the permutation matrix
-        q_matrix_switch_rows(P, P, i, max_idx);
-        q_matrix_switch_rows(U, U, i, max_idx);
-        q_matrix_switch_rows(&temp, &temp, i, max_idx);
+        // If the whole column is zero, the matrix is singular
+        assert((max_val != Q_ZERO) && "Matrix is singular (PLU decomposition is not possible)");
 
-        q_matrix_LU_decomposition(&temp, L, U);
+        if(max_idx != i)
+        {
+            /*
+            Swap the rows of U and the already computed multipliers of L (columns 0 to i-1).
+            The permutation is tracked in the columns of P so that A = P * L * U holds at the end,
+            P[perm[i]][i] = 1 where perm[i] is the original row that ended up in the i-th row of U.
+            */
+            q_matrix_switch_rows(U, U, i, max_idx);
+            q_matrix_switch_cols(P, P, i, max_idx);
 
+            for(size_t k = 0; k < i; k++)
+            {
+                q_t temp = Q_MATRIX_AT(L, i, k);
+                Q_MATRIX_AT(L, i, k) = Q_MATRIX_AT(L, max_idx, k);
+                Q_MATRIX_AT(L, max_idx, k) = temp;
+            }
+        }
+
+        const q_divisor_t pivot = q_divisor_prepare(Q_MATRIX_AT(U, i, i));
+
+        for(size_t j = i + 1; j < n; j++)
+        {
+            /*
+            L[j][i] = U[j][i] / U[i][i]
+            U[j][k] = U[j][k] - L[j][i] * U[i][k]
+            */
+            const q_t l = q_division_prepared(Q_MATRIX_AT(U, j, i), pivot);
+            Q_MATRIX_AT(L, j, i) = l;
+            Q_MATRIX_AT(U, j, i) = Q_ZERO;
+
+            if(l == Q_ZERO)
+            {
+                continue; // Nothing to eliminate in this row
+            }
+
+            for(size_t k = i + 1; k < n; k++)
+            {
+                Q_MATRIX_AT(U, j, k) -= q_product(l, Q_MATRIX_AT(U, i, k));
+            }
+        }
     }
-    
-    q_matrix_free(&temp);
 
 }
 
+/**
+ * @brief The function solves a triangular system of linear equations with several right-hand sides, T * X = b.
+ * @details b and X are n x k matrices, every column of X is the solution for the same column of b. The rows of X are
+ * solved one after the other (top down for a lower triangle, bottom up for an upper triangle) and the columns are the
+ * innermost loop, so each element of T is loaded once for a whole row of right-hand sides and the rows of X are read
+ * contiguously. The columns are processed in blocks of Q_TRSM_BLOCK wide accumulators kept on the stack.
+ * 
+ * For a lower triangle:
+ * X[i][c] = (b[i][c] - sum(T[i][j] * X[j][c])) / T[i][i] for j = 0 to i - 1
+ * 
+ * For an upper triangle:
+ * X[i][c] = (b[i][c] - sum(T[i][j] * X[j][c])) / T[i][i] for j = i + 1 to n - 1
+ * 
+ * The unit variants skip the division and never read the diagonal, so the packed factors of q_lu_decompose can be used
+ * directly. The transpose variants solve T^T * X = b with the lower triangle of T (T^T[i][j] = T[j][i]), so the symmetric
+ * factorizations L * L^T only store L. Every column gets exactly the arithmetic of a single right-hand side solve. X may
+ * be b (in place solve).
+ * 
+ * @example
+ * q_matrix_forward_substitution(&L, &B, &Y); // Same as q_matrix_triangular_solve(&L, &B, &Y, Q_TRIANGLE_LOWER)
+ * 
+ * @param T The reference to the triangular matrix (n x n), the other triangle is not read
+ * @param b The reference to the right-hand sides (n x k)
+ * @param X The reference to the solutions (n x k)
+ * @param triangle The triangle of T that is used
+ */
+void q_matrix_triangular_solve(const q_matrix_t* T, const q_matrix_t* b, const q_matrix_t* X, q_triangle_t triangle)
+{
+    Q_MATRIX_ASSERT(T);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(X);
+
+    assert((T->rows == T->cols) && "Triangular matrix is not square shape (Can not perform triangular solve)");
+    assert((T->rows == b->rows) && "Triangular matrix and b have different number of rows (Can not perform triangular solve)");
+    assert((X->rows == b->rows) && (X->cols == b->cols) && "Destination matrix and b have different dimensions (Can not perform triangular solve)");
+
+    const size_t n = T->rows;
+    const size_t k = b->cols;
+    const int transpose = (triangle == Q_TRIANGLE_LOWER_TRANSPOSE) || (triangle == Q_TRIANGLE_UNIT_LOWER_TRANSPOSE);
+    const int upper = transpose || (triangle == Q_TRIANGLE_UPPER) || (triangle == Q_TRIANGLE_UNIT_UPPER);
+    const int unit = (triangle == Q_TRIANGLE_UNIT_LOWER) || (triangle == Q_TRIANGLE_UNIT_UPPER) || (triangle == Q_TRIANGLE_UNIT_LOWER_TRANSPOSE);
+
+    q_acc_t acc[Q_TRSM_BLOCK];
+
+    for(size_t c0 = 0; c0 < k; c0 += Q_TRSM_BLOCK)
+    {
+        const size_t kb = (k - c0 < Q_TRSM_BLOCK) ? (k - c0) : Q_TRSM_BLOCK;
+
+        for(size_t step = 0; step < n; step++)
+        {
+            const size_t i = upper ? (n - 1 - step) : step;
+            const size_t j_begin = upper ? (i + 1) : 0;
+            const size_t j_end = upper ? n : i;
+
+            // The products are accumulated in wide accumulators and rescaled once (see Q_ACCUMULATE_WIDE)
+            for(size_t c = 0; c < kb; c++)
+            {
+                acc[c] = Q_ACC_FROM_Q(Q_MATRIX_AT(b, i, c0 + c));
+            }
+
+            for(size_t j = j_begin; j < j_end; j++)
+            {
+                const q_t t = transpose ? Q_MATRIX_AT(T, j, i) : Q_MATRIX_AT(T, i, j);
+                const q_t* x = &Q_MATRIX_AT(X, j, c0);
+                for(size_t c = 0; c < kb; c++)
+                {
+                    acc[c] -= Q_ACC_TERM(t, x[c]);
+                }
+            }
+
+            q_t* x = &Q_MATRIX_AT(X, i, c0);
+            if(unit)
+            {
+                for(size_t c = 0; c < kb; c++)
+                {
+                    x[c] = Q_ACC_TO_Q(acc[c]);
+                }
+            }
+            else
+            {
+                const q_t diagonal = Q_MATRIX_AT(T, i, i);
+                if(kb == 1)
+                {
+                    x[0] = q_division(Q_ACC_TO_Q(acc[0]), diagonal);
+                }
+                else
+                {
+                    // The prepared divisor costs one division, it pays off from two right-hand sides
+                    const q_divisor_t d = q_divisor_prepare(diagonal);
+                    for(size_t c = 0; c < kb; c++)
+                    {
+                        x[c] = q_division_prepared(Q_ACC_TO_Q(acc[c]), d);
+                    }
+                }
+            }
+        }
+    }
+}
+
 /**
  * @brief The function computes the forward substitution of the matrix of fixed point numbers.
  * @details The forward substitution is a method to solve a system of linear equations using the LU decomposition.
@@ -671,16 +964,15 @@ void q_matrix_PLU_decomposition(const q_matrix_t* m , q_matrix_t* P, q_matrix_t*
  * Y is the intermediate vector
  * b is the output vector of the system of linear equations
  * 
- * The forward substitution is calculated using the following steps:
- * 1. Initialize the intermediate vector Y with zeros
- * 2. Calculate the elements of the intermediate vector Y
- * 3. The elements of the intermediate vector Y are calculated as follows:
+ * The elements of the intermediate vector Y are calculated as follows:
  *    Y[i] = b[i] - sum(L[i][j] * Y[j]) for j = 0 to i (where i is the row index)
  *    Y[i] = Y[i] / L[i][i]
  * 
+ * b may hold several right-hand sides (n x k), they are all solved in one pass (see q_matrix_triangular_solve).
+ * 
  * @param L The reference to the lower triangular matrix of fixed point numbers
- * @param b The reference to the output vector of fixed point numbers
- * @param Y The reference to the intermediate vector of fixed point numbers
+ * @param b The reference to the output vector (or matrix of right-hand sides) of fixed point numbers
+ * @param Y The reference to the intermediate vector (or matrix) of fixed point numbers, it may be b
  */
 void q_matrix_forward_substitution(const q_matrix_t* L, const q_matrix_t* b, const q_matrix_t* Y)
 {
@@ -691,26 +983,11 @@ void q_matrix_forward_substitution(const q_matrix_t* L, const q_matrix_t* b, con
     assert((L->rows == L->cols) && "Matrix L is not square shape when performing forward substitution");
 
     assert((L->rows == b->rows) && "Matrix L and b have different number of rows (Can not perform forward substitution)");
-    assert((b->cols == 1) && "Matrix b is not a column vector (Can not perform forward substitution)");
 
     assert((Y->rows == b->rows) && "Destination matrix and b have different number of rows (Can not perform forward substitution)");
-    assert((Y->cols == 1) && "Destination matrix is not a column vector (Can not perform forward substitution)");
-
-    q_zeros(Y); // Fill the X vector with zeros
-
-    for(int i = 0; i < L->rows; i++)
-    {
-        q_t temp = Q_ZERO;
-        for(int j = 0; j < i; j++)
-        {
-            temp += q_product(Q_MATRIX_AT(L, i, j), Q_MATRIX_AT(Y, j, 0));
-        }
-
-        temp = Q_MATRIX_AT(b, i, 0) - temp;
-        Q_MATRIX_AT(Y, i, 0) = q_division(temp, Q_MATRIX_AT(L, i, i));
-
-    }
+    assert((Y->cols == b->cols) && "Destination matrix and b have different number of columns (Can not perform forward substitution)");
 
+    q_matrix_triangular_solve(L, b, Y, Q_TRIANGLE_LOWER);
 }
 
 /**
@@ -725,16 +1002,15 @@ void q_matrix_forward_substitution(const q_matrix_t* L, const q_matrix_t* b, con
  * X is the solution vector
  * Y is the intermediate vector
  * 
- * The back substitution is calculated using the following steps:
- * 1. Initialize the solution vector X with zeros
- * 2. Calculate the elements of the solution vector X
- * 3. The elements of the solution vector X are calculated as follows:
+ * The elements of the solution vector X are calculated as follows:
  *   X[i] = Y[i] - sum(U[i][j] * X[j]) for j = i to n (where n is the number of columns)
  *   X[i] = X[i] / U[i][i]
  * 
+ * Y may hold several right-hand sides (n x k), they are all solved in one pass (see q_matrix_triangular_solve).
+ * 
  * @param U The reference to the upper triangular matrix of fixed point numbers
- * @param Y The reference to the intermediate vector of fixed point numbers
- * @param X The reference to the solution vector of fixed point numbers
+ * @param Y The reference to the intermediate vector (or matrix) of fixed point numbers
+ * @param X The reference to the solution vector (or matrix) of fixed point numbers, it may be Y
  */
 void q_matrix_back_substitution(const q_matrix_t* U, const q_matrix_t* Y, const q_matrix_t* X)
 {
@@ -745,25 +1021,11 @@ void q_matrix_back_substitution(const q_matrix_t* U, const q_matrix_t* Y, const
     assert((U->rows == U->cols) && "Matrix U is not square shape when performing back substitution");
 
     assert((U->rows == Y->rows) && "Matrix U and Y have different number of rows (Can not perform back substitution)");
-    assert((Y->cols == 1) && "Matrix Y is not a column vector (Can not perform back substitution)");
 
     assert((X->rows == Y->rows) && "Destination matrix and Y have different number of rows (Can not perform back substitution)");
-    assert((X->cols == 1) && "Destination matrix is not a column vector (Can not perform back substitution)");
-
-    q_zeros(X); // Fill the X vector with zeros
+    assert((X->cols == Y->cols) && "Destination matrix and Y have different number of columns (Can not perform back substitution)");
 
-    for(int i = U->rows - 1; i >= 0; i--)
-    {
-        q_t temp = Q_ZERO;
-        for(int j = i; j < U->cols; j++)
-        {
-            temp += q_product(Q_MATRIX_AT(U, i, j), Q_MATRIX_AT(X, j, 0));
-        }
-
-        temp = Q_MATRIX_AT(Y, i, 0) - temp;
-        Q_MATRIX_AT(X, i, 0) = q_division(temp, Q_MATRIX_AT(U, i, i));
-
-    }
+    q_matrix_triangular_solve(U, Y, X, Q_TRIANGLE_UPPER);
 }
 
 /**
@@ -795,11 +1057,13 @@ void q_matrix_back_substitution(const q_matrix_t* U, const q_matrix_t* Y, const
  * 
  * The solution vector X is obtained by solving the system of linear equations.
  * 
+ * b may hold k right-hand sides (n x k), for instance several load cases of the same system, and they are all solved in
+ * one call. The forward substitution is performed in place in X, no temporary is allocated.
  * 
  * @param L The lower triangular matrix of the LU decomposition
  * @param U The upper triangular matrix of the LU decomposition
- * @param b The output vector of the system of linear equations
- * @param X The solution vector of the system of linear equations
+ * @param b The output vector (or n x k matrix) of the system of linear equations
+ * @param X The solution vector (or n x k matrix) of the system of linear equations, it may be b
  */
 void q_matrix_LU_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix_t* b, const q_matrix_t* X)
 {
@@ -814,18 +1078,12 @@ void q_matrix_LU_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix_
     assert((L->rows == U->rows) && "Matrix L and U have different number of rows when solving the system of linear equations");
     
     assert((L->rows == b->rows) && "Matrix L and b have different number of rows when solving the system of linear equations");
-    assert((b->cols == 1) && "Matrix b is not a column vector when solving the system of linear equations");
 
     assert((X->rows == b->rows) && "The solution matrix and b have different number of rows when solving the system of linear equations");
-    assert((X->cols == 1) && "The solution matrix is not a column vector when solving the system of linear equations");
-
-    q_matrix_t Y = q_matrix_alloc(b->rows, b->cols); // Allocate the Y vector
-
-    q_matrix_forward_substitution(L, b, &Y); // Perform forward substitution
-    q_matrix_back_substitution(U, &Y, X); // Perform back substitution
+    assert((X->cols == b->cols) && "The solution matrix and b have different number of columns when solving the system of linear equations");
 
-    q_matrix_free(&Y); // Free the Y vector
-    
+    q_matrix_forward_substitution(L, b, X); // Perform forward substitution (Y is stored in X)
+    q_matrix_back_substitution(U, X, X); // Perform back substitution in place
 }
 
 /**
@@ -849,7 +1107,7 @@ void q_matrix_LU_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix_
  * The system of linear equations is solved using forward substitution and back substitution.
  * 
  * The forward substitution is calculated as follows:
- * L * Y = P * b
+ * L * Y = P^T * b
  * 
  * The back substitution is calculated as follows:
  * U * X = Y
@@ -859,8 +1117,8 @@ void q_matrix_LU_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix_
  * @param L The lower triangular matrix of the PLU decomposition
  * @param U The upper triangular matrix of the PLU decomposition
  * @param P The permutation matrix of the PLU decomposition
- * @param b The output vector of the system of linear equations
- * @param X The solution vector of the system of linear equations
+ * @param b The output vector (or n x k matrix) of the system of linear equations
+ * @param X The solution vector (or n x k matrix) of the system of linear equations
  */
 void q_matrix_LUP_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix_t* P, const q_matrix_t* b, const q_matrix_t* X)
 {
@@ -878,17 +1136,33 @@ void q_matrix_LUP_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix
     assert((L->rows == P->rows) && "Matrix L and P have different number of rows when solving the system of linear equations");
 
     assert((L->rows == b->rows) && "Matrix L and b have different number of rows when solving the system of linear equations");
-    assert((b->cols == 1) && "Matrix b is not a column vector when solving the system of linear equations");
 
     assert((X->rows == b->rows) && "Destination matrix and b have different number of rows when solving the system of linear equations");
-    assert((X->cols == 1) && "Destination matrix is not a column vector when solving the system of linear equations");
+    assert((X->cols == b->cols) && "Destination matrix and b have different number of columns when solving the system of linear equations");
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t z = q_arena_matrix_alloc(b->rows, b->cols); // Allocate the z matrix in the workspace of the thread
 
-    q_matrix_t z = q_matrix_alloc(b->rows, b->cols); // Allocate the z vector
-    q_matrix_dot_product(P, b, &z); // Perform the dot product between the permutation matrix and the b vector
+    // Apply the inverse permutation to the b vectors (z = P^T * b), P is orthogonal therefore P^-1 = P^T
+    for(size_t i = 0; i < P->cols; i++)
+    {
+        for(size_t k = 0; k < P->rows; k++)
+        {
+            const q_t p = Q_MATRIX_AT(P, k, i);
+            if(p == Q_ZERO)
+            {
+                continue; // Only the ones of the permutation contribute
+            }
+            for(size_t c = 0; c < b->cols; c++)
+            {
+                Q_MATRIX_AT(&z, i, c) += q_product(p, Q_MATRIX_AT(b, k, c));
+            }
+        }
+    }
 
     q_matrix_LU_solve(L, U, &z, X); // Solve the system of linear equations using the LU decomposition
 
-    q_matrix_free(&z); // Free the z vector
+    q_arena_release(mark); // Release the z matrix
 
 }
 
@@ -919,6 +1193,10 @@ void q_matrix_LUP_solve(const q_matrix_t* L, const q_matrix_t* U, const q_matrix
  * By solving the system of linear equations, the inverse of the matrix can be calculated.
  * X = U^-1 * L^-1 * P^-1 = U^-1 * L^-1 * P^T
  * 
+ * The factorization is computed in the destination with q_lu_decompose and overwritten with the inverse by
+ * q_lu_inverse_in_place (U is inverted and the system X * L = U^-1 is solved), so no identity matrix nor column vectors
+ * are allocated. The destination may be the source matrix.
+ * 
  * @param m The reference to the matrix of fixed point numbers
  * @param dst The resulting inverse matrix of the input matrix  
  */
@@ -928,46 +1206,27 @@ void q_matrix_inverse(const q_matrix_t* m, q_matrix_t* dst)
     Q_MATRIX_ASSERT(dst);
 
     assert((m->rows == m->cols) && "Matrix is not square shape when calculating the inverse");
+    assert((dst->rows == m->rows && dst->cols == m->cols) && "Destination matrix has a different shape than the source matrix when calculating the inverse");
 
-    q_matrix_t L = q_matrix_square_alloc(m->rows); // Allocate the lower triangular matrix
-    q_matrix_t U = q_matrix_square_alloc(m->rows); // Allocate the upper triangular matrix
-    q_matrix_t P = q_matrix_square_alloc(m->rows); // Allocate the permutation matrix
+    q_arena_mark_t mark = q_arena_mark();
 
-    q_matrix_PLU_decomposition(m, &P, &L, &U); // Compute the PLU decomposition of the matrix
+    // The matrix is factorized directly in the destination, only the permutation vector is taken from the workspace of the thread
+    q_lu_t lu;
+    lu.LU = *dst;
+    lu.perm = (size_t*) q_arena_alloc(m->rows * sizeof(size_t));
+    lu.parity = 1;
 
-    q_matrix_t I = q_matrix_square_alloc(m->rows); // Allocate the identity matrix
-    q_matrix_identity(&I); // Fill the identity matrix with the identity matrix
+    q_lu_decompose(m, &lu); // Compute the LU factorization of the matrix
+    q_lu_inverse_in_place(&lu); // Overwrite the factors with the inverse
 
-    q_matrix_t X = q_matrix_alloc(m->rows, 1); // Allocate the X vector
-    q_matrix_t b = q_matrix_alloc(m->rows, 1); // Allocate the b vector
-
-    for(size_t i = 0; i < m->cols; i++)
-    {
-        q_matrix_slice_col(&I, &b, i); // Slice the i-th column of the identity matrix
-        
-        q_matrix_LUP_solve(&L, &U, &P, &b, &X); // Solve the system of linear equations
-
-        for(size_t j = 0; j < m->rows; j++)
-        {
-            Q_MATRIX_AT(dst, j, i) = Q_MATRIX_AT(&X, j, 0);
-        }
-
-    }
-
-    q_matrix_freeDeep(&b); // Free the b vector
-    q_matrix_freeDeep(&X); // Free the X vector
-    q_matrix_freeDeep(&I); // Free the identity matrix
-    q_matrix_freeDeep(&P); // Free the permutation matrix
-    q_matrix_freeDeep(&U); // Free the upper triangular matrix
-    q_matrix_freeDeep(&L); // Free the lower triangular matrix
-
-    return;
+    q_arena_release(mark); // Release the permutation vector
 }
 
 // MARK: Basic Matrix Operations
 
 /**
  * @brief This function sums two matrices of fixed point numbers and stores the result in the destination matrix.
+ * @details The rows are processed by the vector kernels selected at runtime (see q_simd_kernels), the destination may be one of the sources.
  * @example 
  * q_matrix_t a = q_matrix_alloc(2, 2);
  * q_matrix_t b = q_matrix_alloc(2, 2);
@@ -998,11 +1257,16 @@ void q_matrix_sum(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* dst)
     assert((a->rows == b->rows) && "Matrices have different number of rows (Can not perform sum)");
     assert((a->cols == b->cols) && "Matrices have different number of columns (Can not perform sum)");
 
+    const q_simd_kernels_t* kernels = q_simd_kernels();
+
+    if(a->stride == a->cols && b->stride == b->cols && dst->stride == dst->cols)
+    {
+        kernels->add(a->elements, b->elements, dst->elements, a->rows * a->cols); // The rows are contiguous, sum them all at once
+        return;
+    }
+
     for(size_t i = 0; i < a->rows; i++){
-        for(size_t j = 0; j < a->cols; j++){
-            Q_MATRIX_AT(dst, i, j) = Q_ZERO;
-            Q_MATRIX_AT(dst, i, j) = Q_MATRIX_AT(a, i, j) + Q_MATRIX_AT(b, i, j);
-        }
+        kernels->add(&Q_MATRIX_AT(a, i, 0), &Q_MATRIX_AT(b, i, 0), &Q_MATRIX_AT(dst, i, 0), a->cols);
     }
 }
 
@@ -1028,16 +1292,22 @@ void q_matrix_scalar_mul(const q_matrix_t* m, q_t scalar)
 {
     Q_MATRIX_ASSERT(m);
 
+    const q_simd_kernels_t* kernels = q_simd_kernels();
+
+    if(m->stride == m->cols)
+    {
+        kernels->scale(m->elements, scalar, m->elements, m->rows * m->cols); // The rows are contiguous, scale them all at once
+        return;
+    }
+
     for(size_t i = 0; i < m->rows; i++){
-        for(size_t j = 0; j < m->cols; j++){
-            Q_MATRIX_AT(m, i, j) = q_product(Q_MATRIX_AT(m, i, j), scalar);
-        }
+        kernels->scale(&Q_MATRIX_AT(m, i, 0), scalar, &Q_MATRIX_AT(m, i, 0), m->cols);
     }
 }
 
 /**
  * @brief The function multiplies each element on their respective position. A .* B = dst
- * @details The matrices must have the same number of rows and columns.
+ * @details The matrices must have the same number of rows and columns. The rows are processed by the vector kernels selected at runtime (see q_simd_kernels).
  * 
  * @example
  * q_matrix_t a = q_matrix_alloc(2, 2);
@@ -1069,11 +1339,16 @@ void q_matrix_elementwise_mul(const q_matrix_t* a, const q_matrix_t* b, q_matrix
     assert((a->rows == dst->rows) && "Source and destination matrices have different number of rows (Can not perform element-wise multiplication)");
     assert((a->cols == dst->cols) && "Source and destination matrices have different number of columns (Can not perform element-wise multiplication)");
 
+    const q_simd_kernels_t* kernels = q_simd_kernels();
+
+    if(a->stride == a->cols && b->stride == b->cols && dst->stride == dst->cols)
+    {
+        kernels->mul(a->elements, b->elements, dst->elements, a->rows * a->cols); // The rows are contiguous, multiply them all at once
+        return;
+    }
+
     for(size_t i = 0; i < a->rows; i++){
-        for(size_t j = 0; j < a->cols; j++){
-            Q_MATRIX_AT(dst, i, j) = Q_ZERO;
-            Q_MATRIX_AT(dst, i, j) = q_product(Q_MATRIX_AT(a, i, j), Q_MATRIX_AT(b, i, j));
-        }
+        kernels->mul(&Q_MATRIX_AT(a, i, 0), &Q_MATRIX_AT(b, i, 0), &Q_MATRIX_AT(dst, i, 0), a->cols);
     }
 }
 
@@ -1081,12 +1356,13 @@ void q_matrix_elementwise_mul(const q_matrix_t* a, const q_matrix_t* b, q_matrix
 
 /**
  * @brief The function computes the determinant of the matrix of fixed point numbers. 
- * @details The matrix must be square shape to calculate the determinant. The determinant is calculated using the LU decomposition. 
+ * @details The matrix must be square shape to calculate the determinant. The determinant is calculated using the LU decomposition with partial pivoting. 
  * The determinant is calculated as follows: 
- * det(A) = det(L) * det(U) = det(U)
+ * det(A) = det(P) * det(L) * det(U) = (-1)^s * det(U)
  * 
  * where:
  * A is the input matrix
+ * P is the permutation matrix and s the number of row switches
  * L is the lower triangular matrix
  * U is the upper triangular matrix
  * 
@@ -1123,45 +1399,15 @@ q_t q_matrix_determinant(const q_matrix_t* m)
         return q_product(Q_MATRIX_AT(m, 0, 0), Q_MATRIX_AT(m, 1, 1)) - q_product(Q_MATRIX_AT(m, 0, 1), Q_MATRIX_AT(m, 1, 0));
     }
     
-    q_t ret = Q_ONE;
-
-    q_matrix_t P = q_matrix_square_alloc(m->rows); // Allocate the permutation matrix
-    q_matrix_t L = q_matrix_square_alloc(m->rows); // Allocate the lower triangular matrix
-    q_matrix_t U = q_matrix_square_alloc(m->rows); // Allocate the upper triangular matrix
+    q_arena_mark_t mark = q_arena_mark();
+    q_lu_t lu = q_lu_arena_alloc(m->rows); // The factorization is taken from the workspace of the thread
 
-    q_matrix_PLU_decomposition(m, &P, &L, &U); // Compute the PLU decomposition of the matrix
+    q_lu_decompose(m, &lu); // Compute the LU factorization of the matrix
+    q_t ret = q_lu_determinant(&lu); // The sign of the row switches is tracked by the parity of the factorization
 
-    q_t sign = Q_MINUS_ONE;
+    q_arena_release(mark); // Release the factorization
 
-    // Calculate the sign of the permutation matrix
-    for(size_t i = 0; i < m->rows; i++)
-    {
-        /*
-        The sign of the permutation matrix is calculated by counting the number of row swaps.
-        If the number of row swaps is even, the sign is positive.
-        If the number of row swaps is odd, the sign is negative.
-        */
-        if(Q_MATRIX_AT(&P, i, i) != INT_TO_Q(i))
-        {
-            sign = -sign;
-        }
-    }
-
-    for(size_t i = 0; i < m->rows; i++)
-    {
-        /*
-        The determinant of the upper triangular matrix is the product of the diagonal elements.
-        det(U) = U[0][0] * U[1][1] * ... * U[n][n]
-        */
-        ret = q_product(ret, Q_MATRIX_AT(&U, i, i));
-    }
-
-    q_matrix_free(&L); // Free the lower triangular matrix
-    q_matrix_free(&U); // Free the upper triangular matrix
-    q_matrix_free(&P); // Free the permutation matrix
-    
-    return q_product(ret, sign);
-    // return ret;
+    return ret;
 }
 
 
@@ -1358,6 +1604,7 @@ q_t q_matrix_infinity_norm(const q_matrix_t* m)
  * @brief The function computes the Euclidean norm of the matrix of fixed point numbers.
  * 
  * @details The Euclidean norm of a matrix is the square root of the sum of the squares of the elements of the matrix.
+ * The squares are accumulated exactly (q_acc_t) and the square root of the sum is rounded to the nearest and saturated.
  * The Euclidean norm is calculated as follows:
  * 
  * ||A||_2 = sqrt( sum( A[i][j]^2 ) )
@@ -1392,17 +1639,19 @@ q_t q_matrix_euclidean_norm(const q_matrix_t* m)
 {
     Q_MATRIX_ASSERT(m);
 
-    q_t ret = Q_ZERO;
+    // The full squares are summed in a wide accumulator, the sum does not overflow nor lose the small elements
+    q_acc_t sum = 0;
 
     for(size_t i = 0; i < m->rows; i++)
     {
         for(size_t j = 0; j < m->cols; j++)
         {
-            ret += q_int_power(Q_MATRIX_AT(m, i, j), 2);
+            const q_t x = Q_MATRIX_AT(m, i, j);
+            sum += (q_acc_t) ((q_long_t) x * x);
         }
     }
 
-    return q_sqrt(ret);
+    return q_sqrt_acc(sum);
 }
 
 // MARK: Matrix Operations
@@ -1410,6 +1659,7 @@ q_t q_matrix_euclidean_norm(const q_matrix_t* m)
 /**
  * @brief The function computes the dot product of two matrices of fixed point numbers.
  * @details The number of columns of the first matrix must be equal to the number of rows of the second matrix.
+ * The product is computed by the cache-blocked GEMM engine (see q_gemm), the destination matrix must not share its elements with the inputs.
  * 
  * @param a The reference to matrix A of fixed point numbers
  * @param b The reference to matrix B of fixed point numbers
@@ -1465,16 +1715,69 @@ void q_matrix_dot_product(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t*
     assert((a->rows == dst->rows) && "Source and destination matrices have different number of rows (Can not perform dot product)");
     assert((b->cols == dst->cols) && "Source and destination matrices have different number of columns (Can not perform dot product)");
 
-    size_t n = a->cols;
-    q_zeros(dst); // Fill destination matrix with 0
+    q_gemm(a, b, dst, Q_GEMM_OVERWRITE); // Blocked and packed matrix multiplication
+}
 
-    for(size_t i = 0; i < dst->rows; i++){
-        for(size_t j = 0; j < dst->cols; j++){
-            for(size_t k = 0; k < n; k++){
-                Q_MATRIX_AT(dst, i, j) += q_product(Q_MATRIX_AT(a, i, k), Q_MATRIX_AT(b, k, j));
-            }
+/**
+ * @brief The function raises a square matrix of fixed point numbers to a power (A^k)
+ * @details Exponentiation by squaring on the GEMM engine: the bits of k are read from the lowest, the factor A^(2^i) is
+ * squared once per bit and multiplied into the result when the bit is set, at most 2 * log2(k) matrix products instead of
+ * k - 1. The last square is not computed. A^0 is the identity. The products are rounded like q_matrix_dot_product (wide
+ * accumulation, see Q_ACCUMULATE_WIDE). The temporaries are taken from the arena of the calling thread, dst may be m.
+ *
+ * @example
+ * q_matrix_power(&F, 10, &F10); // State transition over 10 steps, x[t + 10] = F10 * x[t]
+ *
+ * @param m The reference to the square matrix
+ * @param k The power
+ * @param dst The reference to the result (n x n)
+ */
+void q_matrix_power(const q_matrix_t* m, uint32_t k, q_matrix_t* dst)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_MATRIX_ASSERT(dst);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape (Can not calculate the power)");
+    assert((dst->rows == m->rows) && (dst->cols == m->cols) && "Destination matrix has different dimensions (Can not calculate the power)");
+
+    if(k == 0)
+    {
+        q_matrix_identity(dst);
+        return;
+    }
+
+    const size_t n = m->rows;
+    q_arena_mark_t mark = q_arena_mark();
+
+    // The products can not be written in their sources, every value has a spare buffer to swap with
+    q_matrix_t buffers[3] = {q_arena_matrix_alloc(n, n), q_arena_matrix_alloc(n, n), q_arena_matrix_alloc(n, n)};
+    q_matrix_t* factor = &buffers[0];
+    q_matrix_t* spare = &buffers[1];
+    q_matrix_t* result = &buffers[2];
+    q_matrix_cpy(m, factor);
+
+    while((k & 1) == 0) // The lowest set bit of k starts the result without a product by the identity
+    {
+        q_matrix_dot_product(factor, factor, spare);
+        q_matrix_t* swap = factor; factor = spare; spare = swap;
+        k >>= 1;
+    }
+    q_matrix_cpy(factor, result);
+
+    for(k >>= 1; k != 0; k >>= 1)
+    {
+        q_matrix_dot_product(factor, factor, spare);
+        q_matrix_t* swap = factor; factor = spare; spare = swap;
+
+        if(k & 1)
+        {
+            q_matrix_dot_product(result, factor, spare);
+            swap = result; result = spare; spare = swap;
         }
     }
+
+    q_matrix_cpy(result, dst);
+    q_arena_release(mark);
 }
 
 // MARK: Matrix validation
@@ -1561,10 +1864,21 @@ void q_matrix_cpy(const q_matrix_t* src, q_matrix_t* dst)
     assert((src->rows == dst->rows) && "Source and destination matrices have different number of rows (Can not perform copy)");
     assert((src->cols == dst->cols) && "Source and destination matrices have different number of columns (Can not perform copy)");
 
+    if(src == dst)
+    {
+        return;
+    }
+
+    const q_simd_kernels_t* kernels = q_simd_kernels();
+
+    if(src->stride == src->cols && dst->stride == dst->cols)
+    {
+        kernels->copy(src->elements, dst->elements, src->rows * src->cols); // The rows are contiguous, copy them all at once
+        return;
+    }
+
     for(size_t i = 0; i < src->rows; i++){
-        for(size_t j = 0; j < src->cols; j++){
-            Q_MATRIX_AT(dst, i, j) = Q_MATRIX_AT(src, i, j);
-        }
+        kernels->copy(&Q_MATRIX_AT(src, i, 0), &Q_MATRIX_AT(dst, i, 0), src->cols);
     }
 }
 
@@ -0,0 +1,354 @@
+#include "../include/fix_point_matrix_q15.h"
+#include "../include/fix_point_arena.h"
+
+/**
+ * @brief Rescales a 64 bits accumulator with the given number of fractional bits to the active format, rounding to the
+ * nearest and saturating it
+ *
+ * @param acc The accumulated value
+ * @param frac The number of fractional bits of the accumulator
+ * @return q_t The rounded and saturated value in the active format
+ */
+static inline q_t q15_matrix_acc_to_q(int64_t acc, int32_t frac)
+{
+    if(frac > FRACTIONAL_BITS)
+    {
+        acc += (int64_t) 1 << (frac - FRACTIONAL_BITS - 1); // Half of the last kept bit
+    }
+    const int64_t r = q_format_rescale(acc, frac, FRACTIONAL_BITS);
+    return (r > Q_RAW_MAX) ? Q_RAW_MAX : ((r < Q_RAW_MIN) ? Q_RAW_MIN : (q_t) r);
+}
+
+// MARK: Matrix allocation
+
+/**
+ * @brief This function allocates memory for a Q15 matrix with the specified number of rows and columns.
+ *
+ * @param rows The number of rows in the matrix
+ * @param cols The number of columns in the matrix
+ * @return q15_matrix_t The Q15 matrix, initialized with zeros
+ */
+q15_matrix_t q15_matrix_alloc(size_t rows, size_t cols)
+{
+    assert((rows > 0) && "Number of rows must be greater than 0 when allocating a matrix");
+    assert((cols > 0) && "Number of columns must be greater than 0 when allocating a matrix");
+
+    q15_matrix_t m;
+    m.rows     = rows;
+    m.cols     = cols;
+    m.stride   = cols;
+    m.elements = (q15_t*) calloc(rows * cols, sizeof(q15_t));
+    assert((m.elements != NULL) && "Memory allocation failed");
+    q_arena_count_heap_allocation();
+    return m;
+}
+
+/**
+ * @brief This function frees the memory allocated for the Q15 matrix.
+ *
+ * @param m The Q15 matrix
+ */
+void q15_matrix_free(q15_matrix_t* m)
+{
+    Q15_MATRIX_ASSERT(m);
+
+    m->rows = 0;
+    m->cols = 0;
+    m->stride = 0;
+    free(m->elements);
+    m->elements = NULL;
+}
+
+// MARK: Conversion
+
+/**
+ * @brief Converts a matrix in the active format to Q15, the values outside of [-1, 1) are saturated.
+ *
+ * @param src The reference to the matrix in the active format
+ * @param dst The reference to the Q15 matrix
+ */
+void q15_matrix_from_q(const q_matrix_t* src, q15_matrix_t* dst)
+{
+    Q_MATRIX_ASSERT(src);
+    Q15_MATRIX_ASSERT(dst);
+
+    assert((src->rows == dst->rows) && (src->cols == dst->cols) && "Matrices have different shapes when converting to Q15");
+
+    for(size_t i = 0; i < src->rows; i++)
+    {
+        for(size_t j = 0; j < src->cols; j++)
+        {
+            Q15_MATRIX_AT(dst, i, j) = q15_from_q(Q_MATRIX_AT(src, i, j));
+        }
+    }
+}
+
+/**
+ * @brief Converts a Q15 matrix to the active format.
+ *
+ * @param src The reference to the Q15 matrix
+ * @param dst The reference to the matrix in the active format
+ */
+void q15_matrix_to_q(const q15_matrix_t* src, q_matrix_t* dst)
+{
+    Q15_MATRIX_ASSERT(src);
+    Q_MATRIX_ASSERT(dst);
+
+    assert((src->rows == dst->rows) && (src->cols == dst->cols) && "Matrices have different shapes when converting from Q15");
+
+    for(size_t i = 0; i < src->rows; i++)
+    {
+        for(size_t j = 0; j < src->cols; j++)
+        {
+            Q_MATRIX_AT(dst, i, j) = q15_to_q(Q15_MATRIX_AT(src, i, j));
+        }
+    }
+}
+
+// MARK: Linear algebra operations
+
+/**
+ * @brief The dot product of two Q15 matrices (dst = a * b)
+ * @details Every row of the result is accumulated in 64 bits Q30 (one accumulator per column, so the inner loop runs over
+ * contiguous elements of b) and is rounded to the nearest and saturated to Q15 once. The destination must not share its elements with
+ * the inputs.
+ *
+ * @param a The reference to the Q15 matrix A
+ * @param b The reference to the Q15 matrix B
+ * @param dst The reference to the resulting Q15 matrix
+ */
+void q15_matrix_dot_product(const q15_matrix_t* a, const q15_matrix_t* b, q15_matrix_t* dst)
+{
+    Q15_MATRIX_ASSERT(a);
+    Q15_MATRIX_ASSERT(b);
+    Q15_MATRIX_ASSERT(dst);
+
+    assert((a->cols == b->rows) && "Matrix A columns must be equal to matrix B rows (Can not perform dot product)");
+    assert((dst->rows == a->rows) && (dst->cols == b->cols) && "Destination matrix has the wrong shape (Can not perform dot product)");
+    assert((dst->elements != a->elements) && (dst->elements != b->elements) && "Destination matrix must not alias the inputs");
+
+    q_arena_mark_t mark = q_arena_mark();
+    int64_t* acc = (int64_t*) q_arena_alloc(b->cols * sizeof(int64_t));
+
+    for(size_t i = 0; i < a->rows; i++)
+    {
+        for(size_t j = 0; j < b->cols; j++)
+        {
+            acc[j] = 0;
+        }
+
+        for(size_t k = 0; k < a->cols; k++)
+        {
+            const int32_t a_ik = Q15_MATRIX_AT(a, i, k);
+            const q15_t* b_k = &Q15_MATRIX_AT(b, k, 0);
+
+            for(size_t j = 0; j < b->cols; j++)
+            {
+                acc[j] += a_ik * b_k[j];
+            }
+        }
+
+        for(size_t j = 0; j < b->cols; j++)
+        {
+            Q15_MATRIX_AT(dst, i, j) = q15_saturate((acc[j] + (1 << (q15_FRACTIONAL_BITS - 1))) >> q15_FRACTIONAL_BITS);
+        }
+    }
+
+    q_arena_release(mark); // Release the accumulators
+}
+
+/**
+ * @brief The product of a Q15 matrix by a column vector in the active format (dst = a * x)
+ * @details The products are accumulated in 64 bits with FRACTIONAL_BITS + 15 fractional bits and rounded once.
+ *
+ * @param a The reference to the Q15 matrix
+ * @param x The reference to the column vector in the active format
+ * @param dst The reference to the resulting column vector in the active format
+ */
+void q15_matrix_vector_product(const q15_matrix_t* a, const q_matrix_t* x, q_matrix_t* dst)
+{
+    Q15_MATRIX_ASSERT(a);
+    Q_MATRIX_ASSERT(x);
+    Q_MATRIX_ASSERT(dst);
+
+    assert((a->cols == x->rows) && (x->cols == 1) && "Vector x has the wrong shape (Can not perform matrix vector product)");
+    assert((dst->rows == a->rows) && (dst->cols == 1) && "Destination vector has the wrong shape (Can not perform matrix vector product)");
+    assert((dst->elements != x->elements) && "Destination vector must not alias the input vector");
+
+    for(size_t i = 0; i < a->rows; i++)
+    {
+        int64_t acc = 0;
+        for(size_t k = 0; k < a->cols; k++)
+        {
+            acc += (int64_t) Q15_MATRIX_AT(a, i, k) * Q_MATRIX_AT(x, k, 0);
+        }
+        Q_MATRIX_AT(dst, i, 0) = q15_matrix_acc_to_q(acc, FRACTIONAL_BITS + q15_FRACTIONAL_BITS);
+    }
+}
+
+/**
+ * @brief The forward substitution (L * Y = b) with a lower triangular Q15 matrix
+ * @details b and Y are in the active format. Every row is accumulated in 64 bits with FRACTIONAL_BITS + 15 fractional bits,
+ * so the division by the diagonal directly returns Y[i] without an intermediate rounding.
+ *
+ * @param L The reference to the lower triangular Q15 matrix
+ * @param b The reference to the column vector b
+ * @param Y The reference to the resulting column vector Y
+ */
+void q15_matrix_forward_substitution(const q15_matrix_t* L, const q_matrix_t* b, const q_matrix_t* Y)
+{
+    Q15_MATRIX_ASSERT(L);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(Y);
+
+    assert((L->rows == L->cols) && "Matrix L is not square shape when performing forward substitution");
+    assert((L->rows == b->rows) && (b->cols == 1) && "Vector b has the wrong shape (Can not perform forward substitution)");
+    assert((Y->rows == b->rows) && (Y->cols == 1) && "Destination vector has the wrong shape (Can not perform forward substitution)");
+
+    for(size_t i = 0; i < L->rows; i++)
+    {
+        int64_t acc = (int64_t) Q_MATRIX_AT(b, i, 0) * ((int64_t) 1 << q15_FRACTIONAL_BITS);
+        for(size_t j = 0; j < i; j++)
+        {
+            acc -= (int64_t) Q15_MATRIX_AT(L, i, j) * Q_MATRIX_AT(Y, j, 0);
+        }
+
+        assert((Q15_MATRIX_AT(L, i, i) != 0) && "Matrix L is singular (Can not perform forward substitution)");
+        Q_MATRIX_AT(Y, i, 0) = q15_matrix_acc_to_q(acc / Q15_MATRIX_AT(L, i, i), FRACTIONAL_BITS);
+    }
+}
+
+/**
+ * @brief The back substitution (U * X = Y) with an upper triangular Q15 matrix
+ * @details Y and X are in the active format, see q15_matrix_forward_substitution for the accumulation.
+ *
+ * @param U The reference to the upper triangular Q15 matrix
+ * @param Y The reference to the column vector Y
+ * @param X The reference to the resulting column vector X
+ */
+void q15_matrix_back_substitution(const q15_matrix_t* U, const q_matrix_t* Y, const q_matrix_t* X)
+{
+    Q15_MATRIX_ASSERT(U);
+    Q_MATRIX_ASSERT(Y);
+    Q_MATRIX_ASSERT(X);
+
+    assert((U->rows == U->cols) && "Matrix U is not square shape when performing back substitution");
+    assert((U->rows == Y->rows) && (Y->cols == 1) && "Vector Y has the wrong shape (Can not perform back substitution)");
+    assert((X->rows == Y->rows) && (X->cols == 1) && "Destination vector has the wrong shape (Can not perform back substitution)");
+
+    for(size_t i = U->rows; i-- > 0;)
+    {
+        int64_t acc = (int64_t) Q_MATRIX_AT(Y, i, 0) * ((int64_t) 1 << q15_FRACTIONAL_BITS);
+        for(size_t j = i + 1; j < U->cols; j++)
+        {
+            acc -= (int64_t) Q15_MATRIX_AT(U, i, j) * Q_MATRIX_AT(X, j, 0);
+        }
+
+        assert((Q15_MATRIX_AT(U, i, i) != 0) && "Matrix U is singular (Can not perform back substitution)");
+        Q_MATRIX_AT(X, i, 0) = q15_matrix_acc_to_q(acc / Q15_MATRIX_AT(U, i, i), FRACTIONAL_BITS);
+    }
+}
+
+// MARK: Reductions
+
+/**
+ * @brief The trace of a square Q15 matrix, returned in the active format
+ *
+ * @param m The reference to the Q15 matrix
+ * @return q_t The trace of the matrix
+ */
+q_t q15_matrix_trace(const q15_matrix_t* m)
+{
+    Q15_MATRIX_ASSERT(m);
+
+    assert((m->rows == m->cols) && "Matrix is not square shape when calculating the trace");
+
+    int64_t acc = 0;
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        acc += Q15_MATRIX_AT(m, i, i);
+    }
+
+    return q15_matrix_acc_to_q(acc, q15_FRACTIONAL_BITS);
+}
+
+/**
+ * @brief The sum of all the elements of a Q15 matrix, returned in the active format
+ *
+ * @param m The reference to the Q15 matrix
+ * @return q_t The sum of the elements
+ */
+q_t q15_matrix_sum_contents(const q15_matrix_t* m)
+{
+    Q15_MATRIX_ASSERT(m);
+
+    int64_t acc = 0;
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = 0; j < m->cols; j++)
+        {
+            acc += Q15_MATRIX_AT(m, i, j);
+        }
+    }
+
+    return q15_matrix_acc_to_q(acc, q15_FRACTIONAL_BITS);
+}
+
+/**
+ * @brief The infinity norm (maximum absolute row sum) of a Q15 matrix, returned in the active format
+ *
+ * @param m The reference to the Q15 matrix
+ * @return q_t The infinity norm of the matrix
+ */
+q_t q15_matrix_infinity_norm(const q15_matrix_t* m)
+{
+    Q15_MATRIX_ASSERT(m);
+
+    int64_t ret = 0;
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        int64_t sum = 0;
+        for(size_t j = 0; j < m->cols; j++)
+        {
+            const int32_t x = Q15_MATRIX_AT(m, i, j);
+            sum += (x < 0) ? -x : x;
+        }
+
+        if(sum > ret)
+        {
+            ret = sum;
+        }
+    }
+
+    return q15_matrix_acc_to_q(ret, q15_FRACTIONAL_BITS);
+}
+
+/**
+ * @brief The Euclidean (Frobenius) norm of a Q15 matrix, returned in the active format
+ * @details The squares are accumulated exactly in 64 bits Q30 and the square root is taken on the wide sum (q_sqrt_acc), so
+ * the norm does not saturate when the sum of the squares exceeds the range of q_t.
+ *
+ * @param m The reference to the Q15 matrix
+ * @return q_t The Euclidean norm of the matrix
+ */
+q_t q15_matrix_euclidean_norm(const q15_matrix_t* m)
+{
+    Q15_MATRIX_ASSERT(m);
+
+    int64_t acc = 0;
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = 0; j < m->cols; j++)
+        {
+            const int32_t x = Q15_MATRIX_AT(m, i, j);
+            acc += x * x;
+        }
+    }
+
+    // Rescale the Q30 sum to the scale of the full products of the active format
+#if FRACTIONAL_BITS >= 15
+    return q_sqrt_acc((q_acc_t) acc * ((q_acc_t) 1 << (2 * (FRACTIONAL_BITS - q15_FRACTIONAL_BITS))));
+#else
+    return q_sqrt_acc((q_acc_t) (acc >> (2 * (q15_FRACTIONAL_BITS - FRACTIONAL_BITS))));
+#endif // FRACTIONAL_BITS >= 15
+}
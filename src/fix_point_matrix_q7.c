@@ -0,0 +1,552 @@
+#include "../include/fix_point_matrix_q7.h"
+#include "../include/fix_point_simd.h"
+#include "../include/fix_point_arena.h"
+
+#if Q7_GEMM_X86
+#include <immintrin.h>
+#endif // Q7_GEMM_X86
+
+#define Q7_GEMM_MR 4 // Rows of a micro tile
+#define Q7_GEMM_NR 8 // Columns of a micro tile (one vector of int32 accumulators)
+
+// Accumulation kernel, its packed operands come from the arena and are released by q7_gemm
+typedef void (*q7_gemm_acc_t)(const q7_matrix_t* a, const q7_matrix_t* b, int32_t* acc);
+
+// Dispatch table entry of a kernel level
+struct q7_gemm_kernel_t {
+    q7_gemm_level_t level;
+    q7_gemm_acc_t acc;
+};
+typedef struct q7_gemm_kernel_t q7_gemm_kernel_t;
+
+// MARK: Matrix allocation
+
+/**
+ * @brief This function allocates memory for a Q7 matrix with the specified number of rows and columns.
+ *
+ * @param rows The number of rows in the matrix
+ * @param cols The number of columns in the matrix
+ * @return q7_matrix_t The Q7 matrix, initialized with zeros
+ */
+q7_matrix_t q7_matrix_alloc(size_t rows, size_t cols)
+{
+    assert((rows > 0) && "Number of rows must be greater than 0 when allocating a matrix");
+    assert((cols > 0) && "Number of columns must be greater than 0 when allocating a matrix");
+
+    q7_matrix_t m;
+    m.rows     = rows;
+    m.cols     = cols;
+    m.stride   = cols;
+    m.elements = (q7_t*) calloc(rows * cols, sizeof(q7_t));
+    assert((m.elements != NULL) && "Memory allocation failed");
+    q_arena_count_heap_allocation();
+    return m;
+}
+
+/**
+ * @brief This function frees the memory allocated for the Q7 matrix.
+ *
+ * @param m The Q7 matrix
+ */
+void q7_matrix_free(q7_matrix_t* m)
+{
+    Q7_MATRIX_ASSERT(m);
+
+    m->rows = 0;
+    m->cols = 0;
+    m->stride = 0;
+    free(m->elements);
+    m->elements = NULL;
+}
+
+// MARK: Conversion
+
+/**
+ * @brief Converts a matrix in the active format to Q7, the values outside of [-1, 1) are saturated.
+ *
+ * @param src The reference to the matrix in the active format
+ * @param dst The reference to the Q7 matrix
+ */
+void q7_matrix_from_q(const q_matrix_t* src, q7_matrix_t* dst)
+{
+    Q_MATRIX_ASSERT(src);
+    Q7_MATRIX_ASSERT(dst);
+
+    assert((src->rows == dst->rows) && (src->cols == dst->cols) && "Matrices have different shapes when converting to Q7");
+
+    for(size_t i = 0; i < src->rows; i++)
+    {
+        for(size_t j = 0; j < src->cols; j++)
+        {
+            Q7_MATRIX_AT(dst, i, j) = q7_from_q(Q_MATRIX_AT(src, i, j));
+        }
+    }
+}
+
+/**
+ * @brief Converts a Q7 matrix to the active format.
+ *
+ * @param src The reference to the Q7 matrix
+ * @param dst The reference to the matrix in the active format
+ */
+void q7_matrix_to_q(const q7_matrix_t* src, q_matrix_t* dst)
+{
+    Q7_MATRIX_ASSERT(src);
+    Q_MATRIX_ASSERT(dst);
+
+    assert((src->rows == dst->rows) && (src->cols == dst->cols) && "Matrices have different shapes when converting from Q7");
+
+    for(size_t i = 0; i < src->rows; i++)
+    {
+        for(size_t j = 0; j < src->cols; j++)
+        {
+            Q_MATRIX_AT(dst, i, j) = q7_to_q(Q7_MATRIX_AT(src, i, j));
+        }
+    }
+}
+
+// MARK: Scalar kernel
+
+/**
+ * @brief Accumulates the exact Q14 products of A and B in int32 (acc = A * B, row-major with b->cols columns)
+ */
+static void q7_gemm_acc_scalar(const q7_matrix_t* a, const q7_matrix_t* b, int32_t* acc)
+{
+    const size_t n = b->cols;
+
+    for(size_t i = 0; i < a->rows; i++)
+    {
+        int32_t* acc_i = &acc[i * n];
+        for(size_t j = 0; j < n; j++)
+        {
+            acc_i[j] = 0;
+        }
+
+        for(size_t p = 0; p < a->cols; p++)
+        {
+            const int32_t a_ip = Q7_MATRIX_AT(a, i, p);
+            const q7_t* b_p = &Q7_MATRIX_AT(b, p, 0);
+
+            for(size_t j = 0; j < n; j++)
+            {
+                acc_i[j] += a_ip * b_p[j];
+            }
+        }
+    }
+}
+
+#if Q7_GEMM_X86
+
+// MARK: Packing
+
+/**
+ * @brief Copies a micro tile to the accumulators, dropping the padded rows and columns
+ */
+static void q7_gemm_store_tile(int32_t tile[Q7_GEMM_MR][Q7_GEMM_NR], int32_t* acc, size_t m, size_t n, size_t i, size_t j)
+{
+    const size_t mr = (m - i < Q7_GEMM_MR) ? (m - i) : Q7_GEMM_MR;
+    const size_t nr = (n - j < Q7_GEMM_NR) ? (n - j) : Q7_GEMM_NR;
+
+    for(size_t r = 0; r < mr; r++)
+    {
+        memcpy(&acc[(i + r) * n + j], tile[r], nr * sizeof(int32_t));
+    }
+}
+
+/**
+ * @brief Packs A for the AVX2 kernel: every row is sign extended to int16 and padded with zeros to kp (even) columns, and
+ * the rows are padded with zeros to a multiple of Q7_GEMM_MR. Consecutive pairs of a row are then broadcast as one int32.
+ */
+static int16_t* q7_gemm_pack_a_pairs(const q7_matrix_t* a, size_t mp, size_t kp)
+{
+    int16_t* dst = (int16_t*) q_arena_alloc(mp * kp * sizeof(int16_t));
+    memset(dst, 0, mp * kp * sizeof(int16_t));
+
+    for(size_t i = 0; i < a->rows; i++)
+    {
+        for(size_t p = 0; p < a->cols; p++)
+        {
+            dst[i * kp + p] = Q7_MATRIX_AT(a, i, p);
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief Packs B for the AVX2 kernel in panels of Q7_GEMM_NR columns. Row pair p of a panel stores the int16 pairs
+ * (B[2p][j], B[2p + 1][j]) of its columns next to each other, which is the operand layout of _mm256_madd_epi16.
+ */
+static int16_t* q7_gemm_pack_b_pairs(const q7_matrix_t* b, size_t panels, size_t kp)
+{
+    int16_t* dst = (int16_t*) q_arena_alloc(panels * kp * Q7_GEMM_NR * sizeof(int16_t));
+    memset(dst, 0, panels * kp * Q7_GEMM_NR * sizeof(int16_t));
+
+    for(size_t p = 0; p < b->rows; p++)
+    {
+        for(size_t j = 0; j < b->cols; j++)
+        {
+            const size_t panel = j / Q7_GEMM_NR;
+            dst[(panel * kp + (p & ~(size_t) 1)) * Q7_GEMM_NR + 2 * (j % Q7_GEMM_NR) + (p & 1)] = Q7_MATRIX_AT(b, p, j);
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief Packs A for the VNNI kernel: the rows are biased to unsigned bytes (a + 128) because vpdpbusd multiplies unsigned
+ * by signed bytes. Padding uses 128 (a = 0), the rows are padded to a multiple of Q7_GEMM_MR and kp (multiple of 4) columns.
+ */
+static uint8_t* q7_gemm_pack_a_quads(const q7_matrix_t* a, size_t mp, size_t kp)
+{
+    uint8_t* dst = (uint8_t*) q_arena_alloc(mp * kp);
+    memset(dst, 0x80, mp * kp);
+
+    for(size_t i = 0; i < a->rows; i++)
+    {
+        for(size_t p = 0; p < a->cols; p++)
+        {
+            dst[i * kp + p] = (uint8_t) (Q7_MATRIX_AT(a, i, p) + 128);
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief Packs B for the VNNI kernel in panels of Q7_GEMM_NR columns. Row quad q of a panel stores the 4 bytes
+ * B[4q .. 4q + 3][j] of every column next to each other. The correction 128 * sum(B[:, j]) removes the bias of A.
+ */
+static int8_t* q7_gemm_pack_b_quads(const q7_matrix_t* b, size_t panels, size_t kp, int32_t* correction)
+{
+    int8_t* dst = (int8_t*) q_arena_alloc(panels * kp * Q7_GEMM_NR);
+    memset(dst, 0, panels * kp * Q7_GEMM_NR);
+
+    for(size_t j = 0; j < panels * Q7_GEMM_NR; j++)
+    {
+        correction[j] = 0;
+    }
+
+    for(size_t p = 0; p < b->rows; p++)
+    {
+        for(size_t j = 0; j < b->cols; j++)
+        {
+            const size_t panel = j / Q7_GEMM_NR;
+            dst[(panel * kp + (p & ~(size_t) 3)) * Q7_GEMM_NR + 4 * (j % Q7_GEMM_NR) + (p & 3)] = Q7_MATRIX_AT(b, p, j);
+            correction[j] += 128 * Q7_MATRIX_AT(b, p, j);
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief Broadcasts 4 consecutive bytes (a pair of int16 or a quad of int8) of a packed row to every 32 bits lane
+ */
+__attribute__((target("avx2")))
+static inline __m256i q7_gemm_broadcast(const void* src)
+{
+    int32_t x;
+    memcpy(&x, src, sizeof(x));
+    return _mm256_set1_epi32(x);
+}
+
+// MARK: AVX2 kernel
+
+/**
+ * @brief 4 x 8 micro tile with _mm256_madd_epi16. The products of two Q7 numbers fit in 15 bits, so the pairwise sums of
+ * vpmaddwd are exact (vpmaddubsw is not used because it saturates signed x signed products of int8 pairs).
+ */
+__attribute__((target("avx2")))
+static void q7_gemm_micro_kernel_avx2(const int16_t* a, size_t kp, const int16_t* b, int32_t tile[Q7_GEMM_MR][Q7_GEMM_NR])
+{
+    __m256i c0 = _mm256_setzero_si256(), c1 = c0, c2 = c0, c3 = c0;
+
+    for(size_t p = 0; p < kp; p += 2)
+    {
+        const __m256i vb = _mm256_loadu_si256((const __m256i*) &b[p * Q7_GEMM_NR]);
+        c0 = _mm256_add_epi32(c0, _mm256_madd_epi16(q7_gemm_broadcast(&a[p]), vb));
+        c1 = _mm256_add_epi32(c1, _mm256_madd_epi16(q7_gemm_broadcast(&a[kp + p]), vb));
+        c2 = _mm256_add_epi32(c2, _mm256_madd_epi16(q7_gemm_broadcast(&a[2 * kp + p]), vb));
+        c3 = _mm256_add_epi32(c3, _mm256_madd_epi16(q7_gemm_broadcast(&a[3 * kp + p]), vb));
+    }
+
+    _mm256_storeu_si256((__m256i*) tile[0], c0);
+    _mm256_storeu_si256((__m256i*) tile[1], c1);
+    _mm256_storeu_si256((__m256i*) tile[2], c2);
+    _mm256_storeu_si256((__m256i*) tile[3], c3);
+}
+
+static void q7_gemm_acc_avx2(const q7_matrix_t* a, const q7_matrix_t* b, int32_t* acc)
+{
+    const size_t m = a->rows, n = b->cols;
+    const size_t kp = (a->cols + 1) & ~(size_t) 1;
+    const size_t mp = (m + Q7_GEMM_MR - 1) / Q7_GEMM_MR * Q7_GEMM_MR;
+    const size_t panels = (n + Q7_GEMM_NR - 1) / Q7_GEMM_NR;
+
+    int16_t* a_pack = q7_gemm_pack_a_pairs(a, mp, kp);
+    int16_t* b_pack = q7_gemm_pack_b_pairs(b, panels, kp);
+    int32_t tile[Q7_GEMM_MR][Q7_GEMM_NR];
+
+    // The panel of B stays in the L1 cache while the rows of A stream through it
+    for(size_t jp = 0; jp < panels; jp++)
+    {
+        for(size_t i = 0; i < m; i += Q7_GEMM_MR)
+        {
+            q7_gemm_micro_kernel_avx2(&a_pack[i * kp], kp, &b_pack[jp * kp * Q7_GEMM_NR], tile);
+            q7_gemm_store_tile(tile, acc, m, n, i, jp * Q7_GEMM_NR);
+        }
+    }
+}
+
+// MARK: VNNI kernels
+
+/**
+ * @brief 4 x 8 micro tile with vpdpbusd (4 unsigned x signed byte products summed into every int32 lane).
+ * @details Generated for AVX512-VNNI (EVEX, 256 bits with AVX512VL) and AVX-VNNI (VEX), which only differ in the encoding.
+ * The wrap-around of the int32 lanes is harmless because the corrected result fits in int32.
+ */
+#define Q7_GEMM_VNNI_MICRO_KERNEL(NAME, TARGET, DPBUSD) \
+__attribute__((target(TARGET))) \
+static void NAME(const uint8_t* a, size_t kp, const int8_t* b, int32_t tile[Q7_GEMM_MR][Q7_GEMM_NR]) \
+{ \
+    __m256i c0 = _mm256_setzero_si256(), c1 = c0, c2 = c0, c3 = c0; \
+    for(size_t p = 0; p < kp; p += 4) \
+    { \
+        const __m256i vb = _mm256_loadu_si256((const __m256i*) &b[p * Q7_GEMM_NR]); \
+        c0 = DPBUSD(c0, q7_gemm_broadcast(&a[p]), vb); \
+        c1 = DPBUSD(c1, q7_gemm_broadcast(&a[kp + p]), vb); \
+        c2 = DPBUSD(c2, q7_gemm_broadcast(&a[2 * kp + p]), vb); \
+        c3 = DPBUSD(c3, q7_gemm_broadcast(&a[3 * kp + p]), vb); \
+    } \
+    _mm256_storeu_si256((__m256i*) tile[0], c0); \
+    _mm256_storeu_si256((__m256i*) tile[1], c1); \
+    _mm256_storeu_si256((__m256i*) tile[2], c2); \
+    _mm256_storeu_si256((__m256i*) tile[3], c3); \
+}
+
+Q7_GEMM_VNNI_MICRO_KERNEL(q7_gemm_micro_kernel_avx512vnni, "avx2,avx512vnni,avx512vl", _mm256_dpbusd_epi32)
+Q7_GEMM_VNNI_MICRO_KERNEL(q7_gemm_micro_kernel_avxvnni, "avx2,avxvnni", _mm256_dpbusd_avx_epi32)
+
+static void q7_gemm_acc_vnni(const q7_matrix_t* a, const q7_matrix_t* b, int32_t* acc)
+{
+    const size_t m = a->rows, n = b->cols;
+    const size_t kp = (a->cols + 3) & ~(size_t) 3;
+    const size_t mp = (m + Q7_GEMM_MR - 1) / Q7_GEMM_MR * Q7_GEMM_MR;
+    const size_t panels = (n + Q7_GEMM_NR - 1) / Q7_GEMM_NR;
+
+    __builtin_cpu_init();
+    void (*micro_kernel)(const uint8_t*, size_t, const int8_t*, int32_t[Q7_GEMM_MR][Q7_GEMM_NR]) =
+        (__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512vl")) ? q7_gemm_micro_kernel_avx512vnni : q7_gemm_micro_kernel_avxvnni;
+
+    int32_t* correction = (int32_t*) q_arena_alloc(panels * Q7_GEMM_NR * sizeof(int32_t));
+    uint8_t* a_pack = q7_gemm_pack_a_quads(a, mp, kp);
+    int8_t* b_pack = q7_gemm_pack_b_quads(b, panels, kp, correction);
+    int32_t tile[Q7_GEMM_MR][Q7_GEMM_NR];
+
+    for(size_t jp = 0; jp < panels; jp++)
+    {
+        const int32_t* corr = &correction[jp * Q7_GEMM_NR];
+
+        for(size_t i = 0; i < m; i += Q7_GEMM_MR)
+        {
+            micro_kernel(&a_pack[i * kp], kp, &b_pack[jp * kp * Q7_GEMM_NR], tile);
+
+            for(size_t r = 0; r < Q7_GEMM_MR; r++)
+            {
+                for(size_t j = 0; j < Q7_GEMM_NR; j++)
+                {
+                    tile[r][j] = (int32_t) ((uint32_t) tile[r][j] - (uint32_t) corr[j]); // Modular, as in the kernel
+                }
+            }
+            q7_gemm_store_tile(tile, acc, m, n, i, jp * Q7_GEMM_NR);
+        }
+    }
+}
+
+#endif // Q7_GEMM_X86
+
+// MARK: Dispatch
+
+static q_dispatch_t q7_gemm_active = NULL;
+
+static const q7_gemm_kernel_t q7_gemm_scalar_kernel = {Q7_GEMM_SCALAR, q7_gemm_acc_scalar};
+#if Q7_GEMM_X86
+static const q7_gemm_kernel_t q7_gemm_avx2_kernel = {Q7_GEMM_AVX2, q7_gemm_acc_avx2};
+static const q7_gemm_kernel_t q7_gemm_vnni_kernel = {Q7_GEMM_VNNI, q7_gemm_acc_vnni};
+#endif // Q7_GEMM_X86
+
+/**
+ * @brief Detects the widest quantized GEMM kernel supported by the processor (through CPUID)
+ *
+ * @return q7_gemm_level_t The widest supported level, Q7_GEMM_SCALAR on other architectures
+ */
+q7_gemm_level_t q7_gemm_detect(void)
+{
+#if Q7_GEMM_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        if(__builtin_cpu_supports("avxvnni") || (__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512vl")))
+        {
+            return Q7_GEMM_VNNI;
+        }
+        return Q7_GEMM_AVX2;
+    }
+#endif // Q7_GEMM_X86
+    return Q7_GEMM_SCALAR;
+}
+
+/**
+ * @brief Returns the kernel of a level, limited to the widest level supported by the processor.
+ *
+ * @param level The requested level
+ * @return const q7_gemm_kernel_t* The kernel
+ */
+static const q7_gemm_kernel_t* q7_gemm_select(q7_gemm_level_t level)
+{
+    const q7_gemm_level_t supported = q7_gemm_detect();
+    if(level > supported)
+    {
+        level = supported;
+    }
+
+    switch(level)
+    {
+#if Q7_GEMM_X86
+        case Q7_GEMM_VNNI:
+            return &q7_gemm_vnni_kernel;
+        case Q7_GEMM_AVX2:
+            return &q7_gemm_avx2_kernel;
+#endif // Q7_GEMM_X86
+        default:
+            return &q7_gemm_scalar_kernel;
+    }
+}
+
+static const void* q7_gemm_resolve(void)
+{
+    return q7_gemm_select(Q7_GEMM_VNNI);
+}
+
+/**
+ * @brief Selects the kernel used by q7_gemm, limited to the widest level supported by the processor.
+ * @details All the levels are bit-exact. By default the widest supported level is selected on the first use.
+ *
+ * @param level The requested level
+ * @return q7_gemm_level_t The level that was selected
+ */
+q7_gemm_level_t q7_gemm_set_level(q7_gemm_level_t level)
+{
+    const q7_gemm_kernel_t* kernel = q7_gemm_select(level);
+    q_dispatch_set(&q7_gemm_active, kernel);
+    return kernel->level;
+}
+
+// MARK: Quantized GEMM
+
+/**
+ * @brief Computes the requantization parameters for a real scale
+ * @details The real result of the product is scale * (A * B), its Q7 representation is acc * scale / 2^7 where acc is
+ * the Q14 accumulator. The factor scale / 2^7 is represented as multiplier / 2^shift with multiplier in [2^30, 2^31).
+ *
+ * @example
+ * q7_requant_t r = q7_requant_from_float(0.25f); // dst = saturate(round(A * B / 4))
+ *
+ * @param scale The real scale applied to the product, must be positive
+ * @return q7_requant_t The requantization parameters
+ */
+q7_requant_t q7_requant_from_float(float scale)
+{
+    assert((scale > 0.0f) && "The requantization scale must be positive");
+
+    // scale = mantissa * 2^exponent, mantissa in [0.5, 1)
+    double mantissa = (double) scale;
+    int32_t exponent = 0;
+    while(mantissa >= 1.0)
+    {
+        mantissa *= 0.5;
+        exponent++;
+    }
+    while(mantissa < 0.5)
+    {
+        mantissa *= 2.0;
+        exponent--;
+    }
+
+    int64_t multiplier = (int64_t) (mantissa * (double) (1LL << 31) + 0.5);
+    int32_t shift = 31 - exponent + 7;
+    if(multiplier == (1LL << 31))
+    {
+        multiplier >>= 1;
+        shift--;
+    }
+
+    assert((shift > 0) && (shift < 63) && "The requantization scale is out of range");
+
+    q7_requant_t r = {(int32_t) multiplier, shift};
+    return r;
+}
+
+/**
+ * @brief Quantized product of two Q7 matrices (dst = requant(A * B + bias))
+ * @details The Q14 products are summed exactly in int32 accumulators by the selected kernel (see q7_gemm_set_level),
+ * then the bias is added and every element is requantized once:
+ *
+ * dst[i][j] = saturate((acc[i][j] + bias[j]) * multiplier + 2^(shift - 1)) >> shift)
+ *
+ * The depth of the product (columns of A) must be at most Q7_GEMM_MAX_DEPTH. dst may not share its elements with A or B.
+ *
+ * @example
+ * q7_matrix_t x = q7_matrix_alloc(1, 64);   // Input activations
+ * q7_matrix_t w = q7_matrix_alloc(64, 16);  // Weights
+ * q7_matrix_t y = q7_matrix_alloc(1, 16);   // Output activations
+ * int32_t bias[16] = {0};                   // Bias in Q14
+ * q7_gemm(&x, &w, bias, q7_requant_from_float(0.125f), &y);
+ *
+ * @param a The reference to the Q7 matrix A (m x k)
+ * @param b The reference to the Q7 matrix B (k x n)
+ * @param bias The per-column bias in Q14 (n elements) or NULL
+ * @param requant The requantization parameters
+ * @param dst The reference to the resulting Q7 matrix (m x n)
+ */
+void q7_gemm(const q7_matrix_t* a, const q7_matrix_t* b, const int32_t* bias, q7_requant_t requant, q7_matrix_t* dst)
+{
+    Q7_MATRIX_ASSERT(a);
+    Q7_MATRIX_ASSERT(b);
+    Q7_MATRIX_ASSERT(dst);
+
+    assert((a->cols == b->rows) && "Matrix A columns must be equal to matrix B rows (Can not perform dot product)");
+    assert((dst->rows == a->rows) && (dst->cols == b->cols) && "Destination matrix has the wrong shape (Can not perform dot product)");
+    assert((a->cols <= Q7_GEMM_MAX_DEPTH) && "The depth of the product overflows the int32 accumulators");
+    assert((requant.shift > 0) && (requant.shift < 63) && "Invalid requantization shift");
+
+    const q7_gemm_kernel_t* kernel = (const q7_gemm_kernel_t*) q_dispatch_get(&q7_gemm_active, q7_gemm_resolve);
+
+    const size_t m = a->rows, n = b->cols;
+    q_arena_mark_t mark = q_arena_mark();
+    int32_t* acc = (int32_t*) q_arena_alloc(m * n * sizeof(int32_t));
+
+    kernel->acc(a, b, acc);
+
+    const int64_t rounding = (int64_t) 1 << (requant.shift - 1);
+    for(size_t i = 0; i < m; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            const int64_t x = (int64_t) acc[i * n + j] + ((bias != NULL) ? bias[j] : 0);
+            Q7_MATRIX_AT(dst, i, j) = q7_saturate((x * requant.multiplier + rounding) >> requant.shift);
+        }
+    }
+
+    q_arena_release(mark); // Release the accumulators and the packed operands
+}
+
+/**
+ * @brief The dot product of two Q7 matrices with the plain Q7 scaling (see q7_gemm and Q7_REQUANT_IDENTITY)
+ *
+ * @param a The reference to the Q7 matrix A
+ * @param b The reference to the Q7 matrix B
+ * @param dst The reference to the resulting Q7 matrix
+ */
+void q7_matrix_dot_product(const q7_matrix_t* a, const q7_matrix_t* b, q7_matrix_t* dst)
+{
+    q7_gemm(a, b, NULL, Q7_REQUANT_IDENTITY, dst);
+}
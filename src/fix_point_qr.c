@@ -0,0 +1,619 @@
+#include "../include/fix_point_qr.h"
+#include "../include/fix_point_arena.h"
+#include "../include/fix_point_gemm.h"
+
+// MARK: Allocation
+
+/**
+ * @brief This function allocates a QR factorization of a rows x cols matrix.
+ *
+ * @param rows The number of rows of the factorized matrices
+ * @param cols The number of columns of the factorized matrices, not larger than rows
+ * @return q_qr_t The QR factorization, released with q_qr_free
+ */
+q_qr_t q_qr_alloc(size_t rows, size_t cols)
+{
+    assert((rows >= cols) && "QR factorization needs at least as many rows as columns");
+
+    q_qr_t qr;
+    qr.QR = q_matrix_alloc(rows, cols);
+    qr.tau = (q_t*) calloc(cols, sizeof(q_t));
+    assert((qr.tau != NULL) && "Memory allocation failed");
+    q_arena_count_heap_allocation();
+    return qr;
+}
+
+/**
+ * @brief This function allocates a QR factorization of a rows x cols matrix from the arena of the calling thread.
+ * @details The factorization is released with q_arena_release, it must not be passed to q_qr_free.
+ *
+ * @param rows The number of rows of the factorized matrices
+ * @param cols The number of columns of the factorized matrices, not larger than rows
+ * @return q_qr_t The QR factorization
+ */
+q_qr_t q_qr_arena_alloc(size_t rows, size_t cols)
+{
+    assert((rows >= cols) && "QR factorization needs at least as many rows as columns");
+
+    q_qr_t qr;
+    qr.QR = q_arena_matrix_alloc(rows, cols);
+    qr.tau = (q_t*) q_arena_alloc(cols * sizeof(q_t));
+    memset(qr.tau, 0, cols * sizeof(q_t));
+    return qr;
+}
+
+/**
+ * @brief This function frees the memory allocated for the QR factorization.
+ *
+ * @param qr The QR factorization
+ */
+void q_qr_free(q_qr_t* qr)
+{
+    Q_QR_ASSERT(qr);
+
+    q_matrix_free(&qr->QR);
+    free(qr->tau);
+    qr->tau = NULL;
+}
+
+// MARK: Householder reflectors
+
+/**
+ * @brief Computes the Householder reflector that zeroes the column j below the diagonal.
+ * @details With alpha = A[j][j] and x = A[j+1:m][j]:
+ * beta = -sign(alpha) * ||(alpha, x)||, tau = (beta - alpha) / beta, v = x / (alpha - beta)
+ * so H * (alpha, x) = (beta, 0) with H = I - tau * (1, v) * (1, v)^T. The sign of beta avoids the cancellation in
+ * alpha - beta, every element of v is not larger than one and tau is in [1, 2]. beta replaces the diagonal and v the
+ * elements below it. A column that is already zero below the diagonal gets tau = 0 (H = I).
+ *
+ * @param A The reference to the matrix being factorized
+ * @param j The column of the reflector
+ * @return q_t The scalar factor tau
+ */
+static q_t q_qr_reflector(q_matrix_t* A, size_t j)
+{
+    const size_t m = A->rows;
+    const q_t alpha = Q_MATRIX_AT(A, j, j);
+
+    q_acc_t sum = 0;
+    for(size_t i = j + 1; i < m; i++)
+    {
+        const q_t x = Q_MATRIX_AT(A, i, j);
+        sum += (q_acc_t) ((q_long_t) x * x);
+    }
+
+    if(sum == 0)
+    {
+        return Q_ZERO;
+    }
+
+    const q_t norm = q_sqrt_acc(sum + (q_acc_t) ((q_long_t) alpha * alpha));
+    const q_t beta = (alpha >= 0) ? -norm : norm;
+    const q_t scale = alpha - beta;
+
+    const q_divisor_t d = q_divisor_prepare(scale); // The whole column is divided by the same scale
+    for(size_t i = j + 1; i < m; i++)
+    {
+        Q_MATRIX_AT(A, i, j) = q_division_prepared(Q_MATRIX_AT(A, i, j), d);
+    }
+    Q_MATRIX_AT(A, j, j) = beta;
+
+    return q_division(beta - alpha, beta);
+}
+
+/**
+ * @brief Applies the reflector j to the columns [c0, c1) of a matrix, C = H_j * C.
+ * @details C[j:m][c] = C[j:m][c] - tau * v * (v^T * C[j:m][c]). The rows are traversed in order with the columns as the
+ * innermost loop, the inner products are accumulated in a row of wide accumulators.
+ *
+ * @param V The reference to the factorization holding the Householder vectors
+ * @param j The reflector
+ * @param tau The scalar factor of the reflector
+ * @param C The reference to the matrix, it has the rows of V
+ * @param c0 The first column
+ * @param c1 The column after the last one
+ * @param acc The accumulators, at least c1 - c0 elements
+ * @param t The scaled inner products, at least c1 - c0 elements
+ */
+static void q_qr_reflect(const q_matrix_t* V, size_t j, q_t tau, q_matrix_t* C, size_t c0, size_t c1, q_acc_t* acc, q_t* t)
+{
+    if((tau == Q_ZERO) || (c0 >= c1))
+    {
+        return;
+    }
+
+    const size_t m = C->rows;
+    const size_t nc = c1 - c0;
+
+    q_t* row = &Q_MATRIX_AT(C, j, c0);
+    for(size_t c = 0; c < nc; c++)
+    {
+        acc[c] = Q_ACC_FROM_Q(row[c]); // The first element of v is one
+    }
+
+    for(size_t i = j + 1; i < m; i++)
+    {
+        const q_t v = Q_MATRIX_AT(V, i, j);
+        if(v == Q_ZERO)
+        {
+            continue;
+        }
+
+        row = &Q_MATRIX_AT(C, i, c0);
+        for(size_t c = 0; c < nc; c++)
+        {
+            acc[c] += Q_ACC_TERM(v, row[c]);
+        }
+    }
+
+    row = &Q_MATRIX_AT(C, j, c0);
+    for(size_t c = 0; c < nc; c++)
+    {
+        t[c] = q_product(tau, Q_ACC_TO_Q(acc[c]));
+        row[c] -= t[c];
+    }
+
+    for(size_t i = j + 1; i < m; i++)
+    {
+        const q_t v = Q_MATRIX_AT(V, i, j);
+        if(v == Q_ZERO)
+        {
+            continue;
+        }
+
+        row = &Q_MATRIX_AT(C, i, c0);
+        for(size_t c = 0; c < nc; c++)
+        {
+            row[c] = Q_ACC_TO_Q(Q_ACC_FROM_Q(row[c]) - Q_ACC_TERM(v, t[c]));
+        }
+    }
+}
+
+// MARK: Factorization
+
+/**
+ * @brief Factorizes the panel of the columns [k0, k0 + kb) with unblocked Householder reflections. Every reflector is
+ * applied to the remaining columns of the panel only.
+ *
+ * @param qr The QR factorization in progress
+ * @param k0 The first column of the panel
+ * @param kb The number of columns of the panel
+ * @param acc The accumulators, at least kb elements
+ * @param t The scaled inner products, at least kb elements
+ */
+static void q_qr_panel(q_qr_t* qr, size_t k0, size_t kb, q_acc_t* acc, q_t* t)
+{
+    q_matrix_t* A = &qr->QR;
+    const size_t k1 = k0 + kb;
+
+    for(size_t j = k0; j < k1; j++)
+    {
+        qr->tau[j] = q_qr_reflector(A, j);
+        q_qr_reflect(A, j, qr->tau[j], A, j + 1, k1, acc, t);
+    }
+}
+
+/**
+ * @brief Applies the reflectors of the panel [k0, k1) to the trailing columns with the compact WY representation.
+ * @details H_k0 * ... * H_k1-1 = I - V * T * V^T, V holds the Householder vectors of the panel (unit lower trapezoidal)
+ * and T is upper triangular:
+ * T[i][i] = tau[i], T[0:i][i] = -tau[i] * T[0:i][0:i] * (V[:][0:i]^T * v_i)
+ * The trailing columns are updated with two matrix products, A2 = A2 - V * (T^T * (V^T * A2)), computed by the GEMM
+ * engine on up to max_threads threads. V, V^T, T and the product W = V^T * A2 are taken from the arena of the calling
+ * thread.
+ *
+ * @param qr The QR factorization in progress
+ * @param k0 The first column of the panel
+ * @param k1 The first column after the panel
+ * @param max_threads The maximum number of threads of the products, 0 selects the default
+ */
+static void q_qr_update(q_qr_t* qr, size_t k0, size_t k1, size_t max_threads)
+{
+    q_matrix_t* A = &qr->QR;
+    const size_t mp = A->rows - k0;
+    const size_t kb = k1 - k0;
+    const size_t nc = A->cols - k1;
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t V = q_arena_matrix_alloc(mp, kb);
+    q_matrix_t Vt = q_arena_matrix_alloc(kb, mp);
+    q_matrix_t T = q_arena_matrix_alloc(kb, kb);
+    q_matrix_t W = q_arena_matrix_alloc(kb, nc);
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(nc * sizeof(q_acc_t));
+    q_t* z = (q_t*) q_arena_alloc(kb * sizeof(q_t));
+
+    // V with its implicit ones and zeros, and its transpose for the contiguous inner products
+    for(size_t p = 0; p < mp; p++)
+    {
+        const q_t* row = &Q_MATRIX_AT(A, k0 + p, k0);
+        for(size_t r = 0; r < kb; r++)
+        {
+            const q_t v = (p > r) ? row[r] : ((p == r) ? Q_ONE : Q_ZERO);
+            Q_MATRIX_AT(&V, p, r) = v;
+            Q_MATRIX_AT(&Vt, r, p) = v;
+        }
+    }
+
+    // T column by column
+    for(size_t i = 0; i < kb; i++)
+    {
+        const q_t tau = qr->tau[k0 + i];
+        const q_t* v_i = &Q_MATRIX_AT(&Vt, i, 0);
+        Q_MATRIX_AT(&T, i, i) = tau;
+
+        for(size_t r = 0; r < i; r++)
+        {
+            const q_t* v_r = &Q_MATRIX_AT(&Vt, r, 0);
+            q_acc_t sum = 0;
+            for(size_t p = i; p < mp; p++) // v_i is zero above the row i
+            {
+                sum += Q_ACC_TERM(v_r[p], v_i[p]);
+            }
+            z[r] = Q_ACC_TO_Q(sum);
+        }
+
+        for(size_t r = 0; r < i; r++)
+        {
+            q_acc_t sum = 0;
+            for(size_t q = r; q < i; q++)
+            {
+                sum += Q_ACC_TERM(Q_MATRIX_AT(&T, r, q), z[q]);
+            }
+            Q_MATRIX_AT(&T, r, i) = -q_product(tau, Q_ACC_TO_Q(sum));
+        }
+    }
+
+    q_matrix_t A2 = q_matrix_view(A, k0, k1, mp, nc);
+    q_gemm_parallel(&Vt, &A2, &W, Q_GEMM_OVERWRITE, max_threads); // W = V^T * A2
+
+    // W = T^T * W from the last row, the rows above are still the products of V^T * A2
+    for(size_t i = kb; i-- > 0;)
+    {
+        for(size_t c = 0; c < nc; c++)
+        {
+            acc[c] = 0;
+        }
+
+        for(size_t k = 0; k <= i; k++)
+        {
+            const q_t t = Q_MATRIX_AT(&T, k, i);
+            if(t == Q_ZERO)
+            {
+                continue;
+            }
+
+            const q_t* w = &Q_MATRIX_AT(&W, k, 0);
+            for(size_t c = 0; c < nc; c++)
+            {
+                acc[c] += Q_ACC_TERM(t, w[c]);
+            }
+        }
+
+        q_t* w = &Q_MATRIX_AT(&W, i, 0);
+        for(size_t c = 0; c < nc; c++)
+        {
+            w[c] = Q_ACC_TO_Q(acc[c]);
+        }
+    }
+
+    q_gemm_parallel(&V, &W, &A2, Q_GEMM_SUBTRACT, max_threads); // A2 = A2 - V * W
+
+    q_arena_release(mark); // Release the compact WY representation
+}
+
+/**
+ * @brief This function computes the Householder QR factorization of a matrix with at least as many rows as columns.
+ * @details The factorization is computed with q_qr_decompose_blocked, the panel width is Q_QR_BLOCK and the trailing
+ * updates use the default number of threads.
+ *
+ * @example
+ * q_qr_t qr = q_qr_alloc(100, 3);
+ * q_qr_decompose(&A, &qr);
+ * q_qr_solve(&qr, &b, &x); // Least squares solution of A * x = b
+ * q_qr_free(&qr);
+ *
+ * @param m The reference to the matrix (rows >= cols), it may be the QR matrix of the factorization
+ * @param qr The QR factorization of the matrix
+ */
+void q_qr_decompose(const q_matrix_t* m, q_qr_t* qr)
+{
+    q_qr_decompose_blocked(m, qr, 0, 0);
+}
+
+/**
+ * @brief This function computes the blocked Householder QR factorization, A = Q * R.
+ * @details The matrix is processed in panels of block columns. Every panel is factorized with unblocked Householder
+ * reflections and its reflectors are applied to the trailing columns at once with the compact WY representation
+ * (I - V * T * V^T), so most of the operations are matrix products done by the GEMM engine on up to max_threads threads.
+ * The norms are computed from the exact sum of the squares. When the matrix has no more columns than the panel width the
+ * factorization is the unblocked Householder QR, the blocked factors differ in the last bits.
+ *
+ * @example
+ * q_qr_decompose_blocked(&A, &qr, 16, 4); // Panels of 16 columns, trailing updates on up to 4 threads
+ *
+ * @param m The reference to the matrix (rows >= cols), it may be the QR matrix of the factorization
+ * @param qr The QR factorization of the matrix
+ * @param block The panel width, 0 selects Q_QR_BLOCK
+ * @param max_threads The maximum number of threads of the trailing updates, 0 selects the default
+ */
+void q_qr_decompose_blocked(const q_matrix_t* m, q_qr_t* qr, size_t block, size_t max_threads)
+{
+    Q_MATRIX_ASSERT(m);
+    Q_QR_ASSERT(qr);
+
+    assert((m->rows >= m->cols) && "QR factorization needs at least as many rows as columns");
+    assert((qr->QR.rows == m->rows) && (qr->QR.cols == m->cols) && "QR factorization has different dimensions than the input matrix");
+
+    const size_t n = m->cols;
+    const size_t nb = (block == 0) ? Q_QR_BLOCK : block;
+
+    q_matrix_cpy(m, &qr->QR); // The reflections are applied in place
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(nb * sizeof(q_acc_t));
+    q_t* t = (q_t*) q_arena_alloc(nb * sizeof(q_t));
+
+    for(size_t k0 = 0; k0 < n; k0 += nb)
+    {
+        const size_t kb = (n - k0 < nb) ? (n - k0) : nb;
+
+        q_qr_panel(qr, k0, kb, acc, t);
+
+        if(k0 + kb < n)
+        {
+            q_qr_update(qr, k0, k0 + kb, max_threads);
+        }
+    }
+
+    q_arena_release(mark); // Release the accumulators
+}
+
+// MARK: Solvers
+
+/**
+ * @brief This function overwrites a matrix with the product of the transpose of Q and the matrix, b = Q^T * b.
+ * @details The reflectors are applied one after the other, b may hold k columns (m x k).
+ *
+ * @param qr The QR factorization
+ * @param b The reference to the matrix (m x k)
+ */
+void q_qr_apply_qt(const q_qr_t* qr, q_matrix_t* b)
+{
+    Q_QR_ASSERT(qr);
+    Q_MATRIX_ASSERT(b);
+
+    assert((b->rows == qr->QR.rows) && "Matrix b has a different number of rows than the factorized matrix");
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(b->cols * sizeof(q_acc_t));
+    q_t* t = (q_t*) q_arena_alloc(b->cols * sizeof(q_t));
+
+    for(size_t j = 0; j < qr->QR.cols; j++)
+    {
+        q_qr_reflect(&qr->QR, j, qr->tau[j], b, 0, b->cols, acc, t);
+    }
+
+    q_arena_release(mark); // Release the accumulators
+}
+
+/**
+ * @brief This function solves the linear least squares problem min ||A * x - b|| with the QR factorization of A.
+ * @details x = R^-1 * (Q^T * b)[0:n], the normal equations A^T * A are never formed so the condition number is not squared.
+ * Q^T * b is computed in a copy of b taken from the arena of the calling thread and R is solved by back substitution. b
+ * may hold k right-hand sides (m x k). A square matrix gives the solution of the linear system.
+ *
+ * @param qr The QR factorization of A (m x n)
+ * @param b The reference to the right-hand sides (m x k)
+ * @param x The reference to the solutions (n x k)
+ */
+void q_qr_solve(const q_qr_t* qr, const q_matrix_t* b, q_matrix_t* x)
+{
+    Q_QR_ASSERT(qr);
+    Q_MATRIX_ASSERT(b);
+    Q_MATRIX_ASSERT(x);
+
+    const size_t m = qr->QR.rows;
+    const size_t n = qr->QR.cols;
+
+    assert((b->rows == m) && "Matrix b has a different number of rows than the factorized matrix");
+    assert((x->rows == n) && "Destination matrix has a different number of rows than the columns of the factorized matrix");
+    assert((x->cols == b->cols) && "Destination matrix and b have different number of columns when solving the least squares problem");
+
+    for(size_t i = 0; i < n; i++)
+    {
+        assert((Q_MATRIX_AT(&qr->QR, i, i) != Q_ZERO) && "Matrix is rank deficient (Can not solve the least squares problem)");
+    }
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_matrix_t y = q_arena_matrix_alloc(m, b->cols);
+
+    q_matrix_cpy(b, &y);
+    q_qr_apply_qt(qr, &y); // y = Q^T * b
+
+    q_matrix_t R = q_matrix_view(&qr->QR, 0, 0, n, n);
+    q_matrix_t y_top = q_matrix_view(&y, 0, 0, n, b->cols);
+    q_matrix_triangular_solve(&R, &y_top, x, Q_TRIANGLE_UPPER); // R * x = (Q^T * b)[0:n]
+
+    q_arena_release(mark); // Release the y matrix
+}
+
+/**
+ * @brief This function forms the first n columns of Q (thin Q, m x n).
+ * @details The reflectors are applied to the first columns of the identity from the last to the first, every reflector
+ * only touches the columns on its right.
+ *
+ * @param qr The QR factorization
+ * @param Q The reference to the orthonormal columns (m x n)
+ */
+void q_qr_get_q(const q_qr_t* qr, q_matrix_t* Q)
+{
+    Q_QR_ASSERT(qr);
+    Q_MATRIX_ASSERT(Q);
+
+    const size_t n = qr->QR.cols;
+    assert((Q->rows == qr->QR.rows) && (Q->cols == n) && "Matrix Q has a different shape than the factorized matrix");
+
+    q_zeros(Q);
+    for(size_t i = 0; i < n; i++)
+    {
+        Q_MATRIX_AT(Q, i, i) = Q_ONE;
+    }
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_acc_t* acc = (q_acc_t*) q_arena_alloc(n * sizeof(q_acc_t));
+    q_t* t = (q_t*) q_arena_alloc(n * sizeof(q_t));
+
+    for(size_t j = n; j-- > 0;)
+    {
+        q_qr_reflect(&qr->QR, j, qr->tau[j], Q, j, n, acc, t);
+    }
+
+    q_arena_release(mark); // Release the accumulators
+}
+
+/**
+ * @brief This function copies the upper triangular factor R (n x n), the elements below the diagonal are zero.
+ *
+ * @param qr The QR factorization
+ * @param R The reference to the upper triangular factor (n x n)
+ */
+void q_qr_get_r(const q_qr_t* qr, q_matrix_t* R)
+{
+    Q_QR_ASSERT(qr);
+    Q_MATRIX_ASSERT(R);
+
+    const size_t n = qr->QR.cols;
+    assert((R->rows == n) && (R->cols == n) && "Matrix R has a different shape than the factorized matrix");
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            Q_MATRIX_AT(R, i, j) = (j >= i) ? Q_MATRIX_AT(&qr->QR, i, j) : Q_ZERO;
+        }
+    }
+}
+
+/**
+ * @brief This function solves the linear least squares problem min ||A * x - b||.
+ * @details The QR factorization is taken from the arena of the calling thread (see q_qr_decompose and q_qr_solve).
+ *
+ * @param m The reference to the matrix A (m x n, m >= n)
+ * @param b The reference to the right-hand sides (m x k)
+ * @param x The reference to the solutions (n x k)
+ */
+void q_matrix_least_squares(const q_matrix_t* m, const q_matrix_t* b, q_matrix_t* x)
+{
+    Q_MATRIX_ASSERT(m);
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_qr_t qr = q_qr_arena_alloc(m->rows, m->cols);
+
+    q_qr_decompose(m, &qr);
+    q_qr_solve(&qr, b, x);
+
+    q_arena_release(mark); // Release the factorization
+}
+
+// MARK: Givens rotations
+
+/**
+ * @brief This function computes the Givens rotation that zeroes b, [c s; -s c] * [a; b] = [r; 0].
+ * @details r = sqrt(a^2 + b^2) is computed from the exact sum of the squares, c = a / r and s = b / r.
+ *
+ * @param a The first element
+ * @param b The element to be zeroed
+ * @param c The cosine of the rotation
+ * @param s The sine of the rotation
+ * @param r The rotated first element
+ */
+void q_givens(q_t a, q_t b, q_t* c, q_t* s, q_t* r)
+{
+    if(b == Q_ZERO)
+    {
+        *c = Q_ONE;
+        *s = Q_ZERO;
+        *r = a;
+        return;
+    }
+
+    const q_t h = q_sqrt_acc((q_acc_t) ((q_long_t) a * a) + (q_acc_t) ((q_long_t) b * b));
+    *c = q_division(a, h);
+    *s = q_division(b, h);
+    *r = h;
+}
+
+/**
+ * @brief This function adds a row to a QR factorization with Givens rotations (recursive least squares).
+ * @details R and z hold the triangular factor and the first n elements of Q^T * b of the rows seen so far. The new row of
+ * A and of b is rotated into them one column at a time, O(n^2) operations per row instead of a new factorization. Starting
+ * from R = 0 and z = 0 and adding every row gives the factorization of the whole system, x is then the solution of
+ * R * x = z (see q_matrix_back_substitution).
+ *
+ * @example
+ * q_zeros(&R); q_zeros(&z);
+ * for(size_t i = 0; i < m; i++) { q_qr_givens_update(&R, &z, &rows[i], &rhs[i]); }
+ * q_matrix_back_substitution(&R, &z, &x);
+ *
+ * @param R The reference to the upper triangular factor (n x n), updated
+ * @param z The reference to the transformed right-hand sides (n x k), updated. It may be NULL when rhs is NULL.
+ * @param row The reference to the new row of A (1 x n), it is not modified
+ * @param rhs The reference to the new row of b (1 x k), it is not modified. It may be NULL to only update R.
+ */
+void q_qr_givens_update(q_matrix_t* R, q_matrix_t* z, const q_matrix_t* row, const q_matrix_t* rhs)
+{
+    Q_MATRIX_ASSERT(R);
+    Q_MATRIX_ASSERT(row);
+
+    const size_t n = R->rows;
+    const size_t k = (rhs != NULL) ? rhs->cols : 0;
+
+    assert((R->cols == n) && "Matrix R is not square shape when updating the QR factorization");
+    assert((row->rows == 1) && (row->cols == n) && "New row has a different number of columns than R when updating the QR factorization");
+    assert(((rhs == NULL) == (z == NULL)) && "The right-hand sides and their transformation must be given together");
+    if(rhs != NULL)
+    {
+        Q_MATRIX_ASSERT(z);
+        Q_MATRIX_ASSERT(rhs);
+        assert((rhs->rows == 1) && (z->rows == n) && (z->cols == k) && "Right-hand sides have different dimensions when updating the QR factorization");
+    }
+
+    q_arena_mark_t mark = q_arena_mark();
+    q_t* w = (q_t*) q_arena_alloc((n + k) * sizeof(q_t)); // The row of A followed by the row of b
+    q_t* y = w + n;
+
+    memcpy(w, &Q_MATRIX_AT(row, 0, 0), n * sizeof(q_t));
+    if(k > 0)
+    {
+        memcpy(y, &Q_MATRIX_AT(rhs, 0, 0), k * sizeof(q_t));
+    }
+
+    for(size_t j = 0; j < n; j++)
+    {
+        if(w[j] == Q_ZERO)
+        {
+            continue;
+        }
+
+        q_t c, s;
+        q_givens(Q_MATRIX_AT(R, j, j), w[j], &c, &s, &Q_MATRIX_AT(R, j, j));
+        w[j] = Q_ZERO;
+
+        q_t* r = &Q_MATRIX_AT(R, j, 0);
+        for(size_t col = j + 1; col < n; col++)
+        {
+            const q_t a = r[col], b = w[col];
+            r[col] = Q_ACC_TO_Q(Q_ACC_TERM(c, a) + Q_ACC_TERM(s, b));
+            w[col] = Q_ACC_TO_Q(Q_ACC_TERM(c, b) - Q_ACC_TERM(s, a));
+        }
+
+        for(size_t col = 0; col < k; col++)
+        {
+            const q_t a = Q_MATRIX_AT(z, j, col), b = y[col];
+            Q_MATRIX_AT(z, j, col) = Q_ACC_TO_Q(Q_ACC_TERM(c, a) + Q_ACC_TERM(s, b));
+            y[col] = Q_ACC_TO_Q(Q_ACC_TERM(c, b) - Q_ACC_TERM(s, a));
+        }
+    }
+
+    q_arena_release(mark); // Release the rotated row
+}
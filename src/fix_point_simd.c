@@ -0,0 +1,325 @@
+#include "../include/fix_point_simd.h"
+
+#if Q_SIMD_X86
+#include <immintrin.h>
+#endif // Q_SIMD_X86
+
+// MARK: Scalar kernels
+
+static void q_simd_add_scalar(const q_t* a, const q_t* b, q_t* dst, size_t n)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        dst[i] = (q_t) ((q_unsigned_t) a[i] + (q_unsigned_t) b[i]); // Wraps around like the vector lanes
+    }
+}
+
+static void q_simd_mul_scalar(const q_t* a, const q_t* b, q_t* dst, size_t n)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        dst[i] = q_product(a[i], b[i]);
+    }
+}
+
+static void q_simd_scale_scalar(const q_t* a, q_t scalar, q_t* dst, size_t n)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        dst[i] = q_product(a[i], scalar);
+    }
+}
+
+static void q_simd_fill_scalar(q_t* dst, q_t value, size_t n)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        dst[i] = value;
+    }
+}
+
+static void q_simd_copy_scalar(const q_t* src, q_t* dst, size_t n)
+{
+    memmove(dst, src, n * sizeof(q_t));
+}
+
+static const q_simd_kernels_t q_simd_scalar_kernels = {
+    Q_SIMD_SCALAR,
+    q_simd_add_scalar,
+    q_simd_mul_scalar,
+    q_simd_scale_scalar,
+    q_simd_fill_scalar,
+    q_simd_copy_scalar
+};
+
+#if Q_SIMD_X86
+
+// MARK: SSE4.1 kernels
+
+/**
+ * @brief Multiplies 4 lanes of Q numbers (q_product on every lane)
+ * @details _mm_mul_epi32 multiplies the even lanes into 64 bits products. The odd lanes are moved into the even positions
+ * and multiplied as well. The bits [FRACTIONAL_BITS, FRACTIONAL_BITS + 32) of every product are the truncated Q result,
+ * they are shifted into the low half (even lanes) or the high half (odd lanes) of the 64 bits lanes and blended together.
+ */
+__attribute__((target("sse4.1")))
+static inline __m128i q_simd_product_sse41(__m128i a, __m128i b)
+{
+    __m128i even = _mm_srli_epi64(_mm_mul_epi32(a, b), FRACTIONAL_BITS);
+    __m128i odd  = _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), 32 - FRACTIONAL_BITS);
+    return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+__attribute__((target("sse4.1")))
+static void q_simd_add_sse41(const q_t* a, const q_t* b, q_t* dst, size_t n)
+{
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i*) &a[i]);
+        __m128i vb = _mm_loadu_si128((const __m128i*) &b[i]);
+        _mm_storeu_si128((__m128i*) &dst[i], _mm_add_epi32(va, vb));
+    }
+    q_simd_add_scalar(&a[i], &b[i], &dst[i], n - i);
+}
+
+__attribute__((target("sse4.1")))
+static void q_simd_mul_sse41(const q_t* a, const q_t* b, q_t* dst, size_t n)
+{
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i*) &a[i]);
+        __m128i vb = _mm_loadu_si128((const __m128i*) &b[i]);
+        _mm_storeu_si128((__m128i*) &dst[i], q_simd_product_sse41(va, vb));
+    }
+    q_simd_mul_scalar(&a[i], &b[i], &dst[i], n - i);
+}
+
+__attribute__((target("sse4.1")))
+static void q_simd_scale_sse41(const q_t* a, q_t scalar, q_t* dst, size_t n)
+{
+    const __m128i vs = _mm_set1_epi32(scalar);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i*) &a[i]);
+        _mm_storeu_si128((__m128i*) &dst[i], q_simd_product_sse41(va, vs));
+    }
+    q_simd_scale_scalar(&a[i], scalar, &dst[i], n - i);
+}
+
+__attribute__((target("sse4.1")))
+static void q_simd_fill_sse41(q_t* dst, q_t value, size_t n)
+{
+    const __m128i vv = _mm_set1_epi32(value);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_si128((__m128i*) &dst[i], vv);
+    }
+    q_simd_fill_scalar(&dst[i], value, n - i);
+}
+
+static const q_simd_kernels_t q_simd_sse41_kernels = {
+    Q_SIMD_SSE41,
+    q_simd_add_sse41,
+    q_simd_mul_sse41,
+    q_simd_scale_sse41,
+    q_simd_fill_sse41,
+    q_simd_copy_scalar // memmove is already dispatched to the widest vector copy by the C library
+};
+
+// MARK: AVX2 kernels
+
+/**
+ * @brief Multiplies 8 lanes of Q numbers (q_product on every lane)
+ * @details Same scheme as q_simd_product_sse41 with _mm256_mul_epi32.
+ */
+__attribute__((target("avx2")))
+static inline __m256i q_simd_product_avx2(__m256i a, __m256i b)
+{
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), FRACTIONAL_BITS);
+    __m256i odd  = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 32 - FRACTIONAL_BITS);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+__attribute__((target("avx2")))
+static void q_simd_add_avx2(const q_t* a, const q_t* b, q_t* dst, size_t n)
+{
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*) &a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*) &b[i]);
+        _mm256_storeu_si256((__m256i*) &dst[i], _mm256_add_epi32(va, vb));
+    }
+    q_simd_add_scalar(&a[i], &b[i], &dst[i], n - i);
+}
+
+__attribute__((target("avx2")))
+static void q_simd_mul_avx2(const q_t* a, const q_t* b, q_t* dst, size_t n)
+{
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*) &a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*) &b[i]);
+        _mm256_storeu_si256((__m256i*) &dst[i], q_simd_product_avx2(va, vb));
+    }
+    q_simd_mul_scalar(&a[i], &b[i], &dst[i], n - i);
+}
+
+__attribute__((target("avx2")))
+static void q_simd_scale_avx2(const q_t* a, q_t scalar, q_t* dst, size_t n)
+{
+    const __m256i vs = _mm256_set1_epi32(scalar);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*) &a[i]);
+        _mm256_storeu_si256((__m256i*) &dst[i], q_simd_product_avx2(va, vs));
+    }
+    q_simd_scale_scalar(&a[i], scalar, &dst[i], n - i);
+}
+
+__attribute__((target("avx2")))
+static void q_simd_fill_avx2(q_t* dst, q_t value, size_t n)
+{
+    const __m256i vv = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_si256((__m256i*) &dst[i], vv);
+    }
+    q_simd_fill_scalar(&dst[i], value, n - i);
+}
+
+static const q_simd_kernels_t q_simd_avx2_kernels = {
+    Q_SIMD_AVX2,
+    q_simd_add_avx2,
+    q_simd_mul_avx2,
+    q_simd_scale_avx2,
+    q_simd_fill_avx2,
+    q_simd_copy_scalar // memmove is already dispatched to the widest vector copy by the C library
+};
+
+#endif // Q_SIMD_X86
+
+// MARK: Dispatch
+
+static q_dispatch_t q_simd_active = NULL;
+
+/**
+ * @brief Returns the table of a dispatch slot, resolving it on the first call.
+ * @details The slot is published with release semantics and read with acquire semantics, so concurrent first calls
+ * (from the thread pool for instance) are race free. When several threads resolve the slot at the same time, the first
+ * published table wins, a table set explicitly in the meantime is never overwritten.
+ *
+ * @param slot The dispatch slot
+ * @param resolve Returns the default table
+ * @return const void* The active table
+ */
+const void* q_dispatch_get(q_dispatch_t* slot, const void* (*resolve)(void))
+{
+    const void* table = atomic_load_explicit(slot, memory_order_acquire);
+    if(table == NULL)
+    {
+        const void* expected = NULL;
+        table = resolve();
+        if(!atomic_compare_exchange_strong_explicit(slot, &expected, table, memory_order_acq_rel, memory_order_acquire))
+        {
+            table = expected;
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Publishes the table of a dispatch slot.
+ *
+ * @param slot The dispatch slot
+ * @param table The new active table
+ */
+void q_dispatch_set(q_dispatch_t* slot, const void* table)
+{
+    atomic_store_explicit(slot, table, memory_order_release);
+}
+
+/**
+ * @brief Detects the widest instruction set supported by the processor (through CPUID)
+ *
+ * @return q_simd_level_t The widest supported level, Q_SIMD_SCALAR on other architectures or Q formats
+ */
+q_simd_level_t q_simd_detect(void)
+{
+#if Q_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return Q_SIMD_AVX2;
+    }
+    if(__builtin_cpu_supports("sse4.1"))
+    {
+        return Q_SIMD_SSE41;
+    }
+#endif // Q_SIMD_X86
+    return Q_SIMD_SCALAR;
+}
+
+/**
+ * @brief Returns the kernels of a level, limited to the widest level supported by the processor.
+ *
+ * @param level The requested level
+ * @return const q_simd_kernels_t* The kernels
+ */
+static const q_simd_kernels_t* q_simd_select(q_simd_level_t level)
+{
+    const q_simd_level_t supported = q_simd_detect();
+    if(level > supported)
+    {
+        level = supported;
+    }
+
+    switch(level)
+    {
+#if Q_SIMD_X86
+        case Q_SIMD_AVX2:
+            return &q_simd_avx2_kernels;
+        case Q_SIMD_SSE41:
+            return &q_simd_sse41_kernels;
+#endif // Q_SIMD_X86
+        default:
+            return &q_simd_scalar_kernels;
+    }
+}
+
+static const void* q_simd_resolve(void)
+{
+    return q_simd_select(Q_SIMD_AVX2);
+}
+
+/**
+ * @brief Selects the kernels used by the element-wise matrix operations.
+ * @details The level is limited to the widest level supported by the processor. It is mostly useful to compare the kernels
+ * in tests and benchmarks, by default the widest supported level is selected on the first use.
+ *
+ * @param level The requested level
+ * @return q_simd_level_t The level that was selected
+ */
+q_simd_level_t q_simd_set_level(q_simd_level_t level)
+{
+    const q_simd_kernels_t* kernels = q_simd_select(level);
+    q_dispatch_set(&q_simd_active, kernels);
+    return kernels->level;
+}
+
+/**
+ * @brief Returns the kernels for the element-wise matrix operations, picking the widest supported level on the first call.
+ *
+ * @return const q_simd_kernels_t* The active kernels
+ */
+const q_simd_kernels_t* q_simd_kernels(void)
+{
+    return (const q_simd_kernels_t*) q_dispatch_get(&q_simd_active, q_simd_resolve);
+}
@@ -0,0 +1,313 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "../include/fix_point_thread.h"
+
+// Persistent pool of worker threads. The caller of a parallel loop is worker 0 and takes part in the loop, the pool threads
+// are workers 1 .. threads - 1. Every worker owns a contiguous range of tasks which it consumes from the front, when its
+// range is empty it steals tasks from the back of the other ranges. A range is packed in one atomic word (begin in the low
+// 32 bits, end in the high 32 bits) so the owner and the thieves synchronize with a single compare and swap.
+
+struct thread_pool_t {
+    pthread_mutex_t lock;       // Protects the fields below except the ranges
+    pthread_cond_t start;       // Signaled when a new loop is published
+    pthread_cond_t done;        // Signaled when the last pool thread finishes a loop
+    pthread_mutex_t job;        // Held by the caller of the running loop (one loop at a time)
+
+    pthread_t threads[Q_THREAD_MAX];
+    uint64_t seen[Q_THREAD_MAX];   // Generation each pool thread was created at
+    size_t created;                // Number of pool threads (worker ids 1 .. created)
+    uint64_t generation;           // Incremented for every published loop
+    int stop;
+
+    q_thread_task_t fn;
+    void* ctx;
+    size_t participants;           // Workers taking part in the current loop (the caller included)
+    size_t pending;                // Pool threads still running the current loop
+
+    _Atomic uint64_t ranges[Q_THREAD_MAX];
+};
+
+static struct thread_pool_t q_thread_pool = {
+    .lock  = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done  = PTHREAD_COND_INITIALIZER,
+    .job   = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static size_t q_thread_max = 0; // 0 => number of online processors
+
+// MARK: Task ranges
+
+static inline uint64_t q_thread_range(uint64_t begin, uint64_t end)
+{
+    return begin | (end << 32);
+}
+
+/**
+ * @brief Takes the first task of the range of a worker (the owner side)
+ *
+ * @param worker The worker owning the range
+ * @param task The task taken
+ * @return int 1 if a task was taken, 0 if the range is empty
+ */
+static int q_thread_pop(size_t worker, size_t* task)
+{
+    uint64_t r = atomic_load(&q_thread_pool.ranges[worker]);
+    for(;;)
+    {
+        const uint64_t begin = r & 0xFFFFFFFFu, end = r >> 32;
+        if(begin >= end)
+        {
+            return 0;
+        }
+        if(atomic_compare_exchange_weak(&q_thread_pool.ranges[worker], &r, q_thread_range(begin + 1, end)))
+        {
+            *task = (size_t) begin;
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief Takes the last task of the range of another worker (the thief side)
+ *
+ * @param victim The worker owning the range
+ * @param task The task taken
+ * @return int 1 if a task was stolen, 0 if the range is empty
+ */
+static int q_thread_steal(size_t victim, size_t* task)
+{
+    uint64_t r = atomic_load(&q_thread_pool.ranges[victim]);
+    for(;;)
+    {
+        const uint64_t begin = r & 0xFFFFFFFFu, end = r >> 32;
+        if(begin >= end)
+        {
+            return 0;
+        }
+        if(atomic_compare_exchange_weak(&q_thread_pool.ranges[victim], &r, q_thread_range(begin, end - 1)))
+        {
+            *task = (size_t) (end - 1);
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief Runs the tasks of the current loop on a worker until every range is empty
+ *
+ * @param worker The index of the worker
+ */
+static void q_thread_run(size_t worker)
+{
+    const size_t participants = q_thread_pool.participants;
+    q_thread_task_t fn = q_thread_pool.fn;
+    void* ctx = q_thread_pool.ctx;
+    size_t task;
+
+    while(q_thread_pop(worker, &task))
+    {
+        fn(ctx, task, worker);
+    }
+
+    for(size_t v = 1; v < participants;)
+    {
+        if(q_thread_steal((worker + v) % participants, &task))
+        {
+            fn(ctx, task, worker);
+            v = 1; // The victim may still hold work, start over from the closest worker
+        }
+        else
+        {
+            v++;
+        }
+    }
+}
+
+// MARK: Pool threads
+
+static void* q_thread_worker(void* arg)
+{
+    const size_t id = (size_t) arg;
+
+    pthread_mutex_lock(&q_thread_pool.lock);
+    uint64_t seen = q_thread_pool.seen[id];
+
+    for(;;)
+    {
+        while((q_thread_pool.generation == seen) && !q_thread_pool.stop)
+        {
+            pthread_cond_wait(&q_thread_pool.start, &q_thread_pool.lock);
+        }
+        if(q_thread_pool.stop)
+        {
+            break;
+        }
+        seen = q_thread_pool.generation;
+
+        if(id < q_thread_pool.participants)
+        {
+            pthread_mutex_unlock(&q_thread_pool.lock);
+            q_thread_run(id);
+            pthread_mutex_lock(&q_thread_pool.lock);
+
+            if(--q_thread_pool.pending == 0)
+            {
+                pthread_cond_signal(&q_thread_pool.done);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&q_thread_pool.lock);
+    return NULL;
+}
+
+/**
+ * @brief Stops and joins the threads of the pool. It is registered with atexit when the first thread is created, the pool
+ * is created again by the next parallel loop.
+ */
+void q_thread_pool_shutdown(void)
+{
+    pthread_mutex_lock(&q_thread_pool.job);
+    pthread_mutex_lock(&q_thread_pool.lock);
+    q_thread_pool.stop = 1;
+    pthread_cond_broadcast(&q_thread_pool.start);
+    pthread_mutex_unlock(&q_thread_pool.lock);
+
+    for(size_t i = 1; i <= q_thread_pool.created; i++)
+    {
+        pthread_join(q_thread_pool.threads[i], NULL);
+    }
+
+    pthread_mutex_lock(&q_thread_pool.lock);
+    q_thread_pool.created = 0;
+    q_thread_pool.stop = 0;
+    pthread_mutex_unlock(&q_thread_pool.lock);
+    pthread_mutex_unlock(&q_thread_pool.job);
+}
+
+// MARK: Parallel loops
+
+/**
+ * @brief Sets the default number of threads of the parallel kernels (the calling thread included)
+ *
+ * @param max_threads The number of threads, 0 selects the number of online processors and 1 disables the parallelism
+ */
+void q_thread_set_max_threads(size_t max_threads)
+{
+    q_thread_max = max_threads;
+}
+
+/**
+ * @brief Returns the default number of threads of the parallel kernels
+ *
+ * @return size_t The number of threads, in [1, Q_THREAD_MAX]
+ */
+size_t q_thread_get_max_threads(void)
+{
+    return q_thread_resolve(0);
+}
+
+/**
+ * @brief Resolves a requested number of threads
+ *
+ * @param max_threads The requested number of threads, 0 selects the default (see q_thread_set_max_threads)
+ * @return size_t The number of threads, in [1, Q_THREAD_MAX]
+ */
+size_t q_thread_resolve(size_t max_threads)
+{
+    if(max_threads == 0)
+    {
+        max_threads = q_thread_max;
+    }
+    if(max_threads == 0)
+    {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        max_threads = (online > 0) ? (size_t) online : 1;
+    }
+    return (max_threads > Q_THREAD_MAX) ? Q_THREAD_MAX : max_threads;
+}
+
+/**
+ * @brief Runs fn(ctx, task, worker) for every task in [0, tasks) on up to threads threads of the persistent pool.
+ * @details The tasks are split in contiguous ranges, one per thread, and the idle threads steal from the other ranges. The
+ * calling thread takes part as worker 0 and the function returns when every task has finished. Worker indices are always
+ * lower than q_thread_resolve(threads), so per-worker buffers can be sized beforehand. When another loop is already running
+ * (concurrent or nested calls) the tasks are executed by the calling thread alone.
+ *
+ * @example
+ * static void task(void* ctx, size_t i, size_t worker) { ((int*) ctx)[i] = (int) (i * i); }
+ * int squares[100];
+ * q_thread_parallel_for(100, 0, task, squares);
+ *
+ * @param tasks The number of tasks
+ * @param threads The maximum number of threads, 0 selects the default
+ * @param fn The task function
+ * @param ctx The context passed to every task
+ */
+void q_thread_parallel_for(size_t tasks, size_t threads, q_thread_task_t fn, void* ctx)
+{
+    assert((fn != NULL) && "The task function is NULL");
+    assert((tasks < ((size_t) 1 << 32)) && "Too many tasks in a parallel loop");
+
+    threads = q_thread_resolve(threads);
+    threads = (threads > tasks) ? tasks : threads;
+
+    if((threads <= 1) || (pthread_mutex_trylock(&q_thread_pool.job) != 0))
+    {
+        for(size_t t = 0; t < tasks; t++)
+        {
+            fn(ctx, t, 0);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&q_thread_pool.lock);
+
+    if(q_thread_pool.created == 0)
+    {
+        static int registered = 0;
+        if(!registered)
+        {
+            atexit(q_thread_pool_shutdown);
+            registered = 1;
+        }
+    }
+
+    while(q_thread_pool.created + 1 < threads)
+    {
+        const size_t id = q_thread_pool.created + 1;
+        q_thread_pool.seen[id] = q_thread_pool.generation;
+        if(pthread_create(&q_thread_pool.threads[id], NULL, q_thread_worker, (void*) id) != 0)
+        {
+            break;
+        }
+        q_thread_pool.created = id;
+    }
+    threads = (threads > q_thread_pool.created + 1) ? q_thread_pool.created + 1 : threads;
+
+    for(size_t w = 0; w < threads; w++)
+    {
+        atomic_store(&q_thread_pool.ranges[w], q_thread_range(tasks * w / threads, tasks * (w + 1) / threads));
+    }
+
+    q_thread_pool.fn = fn;
+    q_thread_pool.ctx = ctx;
+    q_thread_pool.participants = threads;
+    q_thread_pool.pending = threads - 1;
+    q_thread_pool.generation++;
+    pthread_cond_broadcast(&q_thread_pool.start);
+    pthread_mutex_unlock(&q_thread_pool.lock);
+
+    q_thread_run(0);
+
+    pthread_mutex_lock(&q_thread_pool.lock);
+    while(q_thread_pool.pending > 0)
+    {
+        pthread_cond_wait(&q_thread_pool.done, &q_thread_pool.lock);
+    }
+    pthread_mutex_unlock(&q_thread_pool.lock);
+
+    pthread_mutex_unlock(&q_thread_pool.job);
+}
@@ -37,11 +37,43 @@ int main() {
     
     CU_pSuite matrix = CU_add_suite("matrix", initialize_suite, cleanup_suite);
 
+    CU_pSuite gemm = CU_add_suite("gemm", initialize_suite, cleanup_suite);
+
+    CU_pSuite simd = CU_add_suite("simd", initialize_suite, cleanup_suite);
+
+    CU_pSuite formats = CU_add_suite("formats", initialize_suite, cleanup_suite);
+
+    CU_pSuite matrix_q15 = CU_add_suite("matrix_q15", initialize_suite, cleanup_suite);
+
+    CU_pSuite matrix_q7 = CU_add_suite("matrix_q7", initialize_suite, cleanup_suite);
+
+    CU_pSuite thread = CU_add_suite("thread", initialize_suite, cleanup_suite);
+
+    CU_pSuite arena = CU_add_suite("arena", initialize_suite, cleanup_suite);
+
+    CU_pSuite lu = CU_add_suite("lu", initialize_suite, cleanup_suite);
+
+    CU_pSuite cholesky = CU_add_suite("cholesky", initialize_suite, cleanup_suite);
+
+    CU_pSuite qr = CU_add_suite("qr", initialize_suite, cleanup_suite);
+    CU_pSuite eigen = CU_add_suite("eigen", initialize_suite, cleanup_suite);
+
     // Add the test cases to the suite
     add_conversion_tests(conversions);
     add_general_math_tests(general_math);
     add_trigonometric_tests(trigonometric);
     add_matrix_tests(matrix);
+    add_gemm_tests(gemm);
+    add_simd_tests(simd);
+    add_formats_tests(formats);
+    add_matrix_q15_tests(matrix_q15);
+    add_matrix_q7_tests(matrix_q7);
+    add_thread_tests(thread);
+    add_arena_tests(arena);
+    add_lu_tests(lu);
+    add_cholesky_tests(cholesky);
+    add_qr_tests(qr);
+    add_eigen_tests(eigen);
 
     // Run all tests using the basic interface
     CU_basic_set_mode(CU_BRM_VERBOSE);
@@ -1,7 +1,19 @@
 #ifndef TEST_H
 #define TEST_H
 #include <CUnit/Basic.h>
+#include "test_fixtures.h"
 #include "test_q_conversion.h"
 #include "test_q_conversion.h"
+#include "test_q_gemm.h"
+#include "test_q_simd.h"
+#include "test_q_formats.h"
+#include "test_q_matrix_q15.h"
+#include "test_q_matrix_q7.h"
+#include "test_q_thread.h"
+#include "test_q_arena.h"
+#include "test_q_lu.h"
+#include "test_q_cholesky.h"
+#include "test_q_qr.h"
+#include "test_q_eigen.h"
 
 #endif // TEST_H
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef TEST_FIXTURES_H
+#define TEST_FIXTURES_H
+#include "../include/fix_point_matrix.h"
+
+/**
+ * @brief Fills the matrix with random values in [-1, 1) and adds a constant to its diagonal, so the factorizations stay
+ * inside the Q range. The diagonal dominates when the constant is the number of rows.
+ * @details Shared by the test suites and the benchmarks, it does not depend on CUnit.
+ *
+ * @param m The matrix to be filled
+ * @param diagonal The constant added to the diagonal
+ */
+static inline void fill_well_conditioned(q_matrix_t* m, q_t diagonal)
+{
+    q_matrix_fill_rand_float(m, -1.0f, 1.0f);
+    for(size_t i = 0; i < m->rows && i < m->cols; i++)
+    {
+        Q_MATRIX_AT(m, i, i) += diagonal;
+    }
+}
+
+#endif // TEST_FIXTURES_H
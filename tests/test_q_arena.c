@@ -0,0 +1,179 @@
+#include "test_q_arena.h"
+
+void test_q_arena_mark_release()
+{
+    q_arena_free(); // Start from an empty arena, the previous tests left blocks behind
+    q_arena_mark_t outer = q_arena_mark();
+
+    // The allocations are aligned and do not overlap
+    unsigned char* a = (unsigned char*) q_arena_alloc(3);
+    unsigned char* b = (unsigned char*) q_arena_alloc(100);
+    CU_ASSERT_EQUAL((uintptr_t) a % Q_ARENA_ALIGNMENT, 0);
+    CU_ASSERT_EQUAL((uintptr_t) b % Q_ARENA_ALIGNMENT, 0);
+    CU_ASSERT_TRUE(b >= a + 3);
+
+    // Nested marks are released in reverse order and the memory is reused
+    q_arena_mark_t inner = q_arena_mark();
+    q_matrix_t m = q_arena_matrix_alloc(5, 7);
+    CU_ASSERT_EQUAL(m.stride, 7);
+    for(size_t i = 0; i < m.rows; i++)
+    {
+        for(size_t j = 0; j < m.cols; j++)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&m, i, j), Q_ZERO);
+        }
+    }
+    q_ones(&m);
+    q_arena_release(inner);
+
+    q_matrix_t again = q_arena_matrix_alloc(5, 7);
+    CU_ASSERT_PTR_EQUAL(again.elements, m.elements);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&again, 4, 6), Q_ZERO); // Zero initialized after the reuse
+
+    // Allocations larger than a block grow the arena
+    const size_t before = q_arena_heap_allocations();
+    q_t* big = (q_t*) q_arena_alloc(4 * Q_ARENA_BLOCK_BYTES);
+    big[4 * Q_ARENA_BLOCK_BYTES / sizeof(q_t) - 1] = Q_ONE;
+    CU_ASSERT_TRUE(q_arena_heap_allocations() > before);
+
+    q_arena_release(outer);
+    CU_ASSERT_PTR_EQUAL((unsigned char*) q_arena_alloc(3), a);
+    q_arena_release(outer);
+}
+
+void test_q_arena_steady_state()
+{
+    /* After a first call the solvers must not touch the heap anymore, their temporaries come from the arena. */
+    const size_t n = 40;
+    q_matrix_t m = q_matrix_square_alloc(n);
+    q_matrix_t inv = q_matrix_square_alloc(n);
+    q_matrix_t prod = q_matrix_square_alloc(n);
+    q_matrix_t P = q_matrix_square_alloc(n);
+    q_matrix_t L = q_matrix_square_alloc(n);
+    q_matrix_t U = q_matrix_square_alloc(n);
+    q_matrix_t b = q_matrix_alloc(n, 1);
+    q_matrix_t x = q_matrix_alloc(n, 1);
+    q_matrix_t I = q_matrix_square_alloc(n);
+    q15_matrix_t a15 = q15_matrix_square_alloc(n);
+    q15_matrix_t c15 = q15_matrix_square_alloc(n);
+    q7_matrix_t a7 = q7_matrix_square_alloc(n);
+    q7_matrix_t c7 = q7_matrix_square_alloc(n);
+    fill_well_conditioned(&m, INT_TO_Q(m.rows));
+    q_matrix_fill_rand_float(&b, -1.0f, 1.0f);
+    q_matrix_identity(&I);
+
+    for(size_t rep = 0; rep < 10; rep++)
+    {
+        const size_t before = q_arena_heap_allocations();
+
+        q_matrix_inverse(&m, &inv);
+        q_matrix_dot_product(&m, &inv, &prod);
+        q_matrix_PLU_decomposition(&m, &P, &L, &U);
+        q_matrix_LUP_solve(&L, &U, &P, &b, &x);
+        q_t det = q_matrix_determinant(&m);
+        (void) det;
+        q15_matrix_dot_product(&a15, &a15, &c15);
+        q7_matrix_dot_product(&a7, &a7, &c7);
+
+        if(rep > 0)
+        {
+            CU_ASSERT_EQUAL(q_arena_heap_allocations(), before);
+        }
+    }
+    CU_ASSERT_TRUE(q_matrix_is_approx_float(&prod, &I, 0.01f) == Q_MATRIX_OK);
+
+    // The matrices of the library are counted
+    const size_t before = q_arena_heap_allocations();
+    q_matrix_t tmp = q_matrix_alloc(2, 2);
+    CU_ASSERT_EQUAL(q_arena_heap_allocations(), before + 1);
+    q_matrix_free(&tmp);
+    q15_matrix_t tmp15 = q15_matrix_alloc(2, 2);
+    CU_ASSERT_EQUAL(q_arena_heap_allocations(), before + 2);
+    q15_matrix_free(&tmp15);
+    q7_matrix_t tmp7 = q7_matrix_alloc(2, 2);
+    CU_ASSERT_EQUAL(q_arena_heap_allocations(), before + 3);
+    q7_matrix_free(&tmp7);
+
+    q15_matrix_free(&a15);
+    q15_matrix_free(&c15);
+    q7_matrix_free(&a7);
+    q7_matrix_free(&c7);
+    q_matrix_free(&m);
+    q_matrix_free(&inv);
+    q_matrix_free(&prod);
+    q_matrix_free(&P);
+    q_matrix_free(&L);
+    q_matrix_free(&U);
+    q_matrix_free(&b);
+    q_matrix_free(&x);
+    q_matrix_free(&I);
+}
+
+#define ARENA_TASKS 16
+
+struct arena_test_t {
+    q_matrix_t m[ARENA_TASKS];
+    q_matrix_t inv[ARENA_TASKS];
+    int steady[ARENA_TASKS];
+};
+
+static void inverse_task(void* ctx, size_t task, size_t worker)
+{
+    (void) worker;
+    struct arena_test_t* t = (struct arena_test_t*) ctx;
+
+    q_matrix_inverse(&t->m[task], &t->inv[task]); // Warm up the arena of the thread
+    const size_t before = q_arena_heap_allocations();
+    q_matrix_inverse(&t->m[task], &t->inv[task]);
+    t->steady[task] = (q_arena_heap_allocations() == before);
+}
+
+void test_q_arena_threads()
+{
+    /* Every thread owns its arena, the solvers can run concurrently. */
+    static struct arena_test_t t;
+
+    for(size_t i = 0; i < ARENA_TASKS; i++)
+    {
+        t.m[i] = q_matrix_square_alloc(8 + i);
+        t.inv[i] = q_matrix_square_alloc(8 + i);
+        fill_well_conditioned(&t.m[i], INT_TO_Q(t.m[i].rows));
+    }
+
+    q_thread_parallel_for(ARENA_TASKS, 4, inverse_task, &t);
+
+    for(size_t i = 0; i < ARENA_TASKS; i++)
+    {
+        q_matrix_t prod = q_matrix_square_alloc(8 + i);
+        q_matrix_t I = q_matrix_square_alloc(8 + i);
+        q_matrix_identity(&I);
+        q_matrix_dot_product(&t.m[i], &t.inv[i], &prod);
+
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&prod, &I, 0.01f) == Q_MATRIX_OK);
+        CU_ASSERT_TRUE(t.steady[i]);
+
+        q_matrix_free(&prod);
+        q_matrix_free(&I);
+        q_matrix_free(&t.m[i]);
+        q_matrix_free(&t.inv[i]);
+    }
+}
+
+void add_arena_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_arena_mark_release", test_q_arena_mark_release)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_arena_steady_state", test_q_arena_steady_state)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_arena_threads", test_q_arena_threads)) {
+        return;
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_Q_ARENA_H
+#define TEST_Q_ARENA_H
+#include "CUnit/Basic.h"
+#include "test_fixtures.h"
+#include "../include/fix_point_arena.h"
+#include "../include/fix_point_matrix_q15.h"
+#include "../include/fix_point_matrix_q7.h"
+#include "../include/fix_point_thread.h"
+
+void test_q_arena_mark_release();
+void test_q_arena_steady_state();
+void test_q_arena_threads();
+
+void add_arena_tests(CU_pSuite suite);
+
+#endif // TEST_Q_ARENA_H
@@ -0,0 +1,419 @@
+#include "test_q_cholesky.h"
+
+#define TEST_SENTINEL ((q_t) 0x5A5A5A5A) // Written in the upper triangles, which the factorizations must not touch
+
+// Symmetric matrix with a dominant diagonal (positive definite), so the factors stay inside the Q range
+static void fill_spd(q_matrix_t* m)
+{
+    q_matrix_fill_rand_float(m, -1.0f, 1.0f);
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = 0; j < i; j++)
+        {
+            Q_MATRIX_AT(m, j, i) = Q_MATRIX_AT(m, i, j);
+        }
+        Q_MATRIX_AT(m, i, i) += INT_TO_Q(m->rows);
+    }
+}
+
+static void fill_upper(q_matrix_t* m, q_t value)
+{
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = i + 1; j < m->cols; j++)
+        {
+            Q_MATRIX_AT(m, i, j) = value;
+        }
+    }
+}
+
+static int upper_is(const q_matrix_t* m, q_t value)
+{
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = i + 1; j < m->cols; j++)
+        {
+            if(Q_MATRIX_AT(m, i, j) != value)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// dst = L * D * L^T from the lower triangle of the factor, D is the identity for the Cholesky factor
+static void reconstruct(const q_matrix_t* factor, int unit, q_matrix_t* dst)
+{
+    const size_t n = factor->rows;
+    q_matrix_t L = q_matrix_square_alloc(n);
+    q_matrix_t LD = q_matrix_square_alloc(n);
+    q_matrix_t Lt = q_matrix_square_alloc(n);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j <= i; j++)
+        {
+            Q_MATRIX_AT(&L, i, j) = Q_MATRIX_AT(factor, i, j);
+            Q_MATRIX_AT(&LD, i, j) = Q_MATRIX_AT(factor, i, j);
+        }
+        if(unit)
+        {
+            Q_MATRIX_AT(&L, i, i) = Q_ONE;
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(&LD, i, j) = q_product(Q_MATRIX_AT(factor, i, j), Q_MATRIX_AT(factor, j, j));
+            }
+        }
+    }
+
+    q_matrix_transpose(&L, &Lt);
+    q_matrix_dot_product(&LD, &Lt, dst);
+
+    q_matrix_free(&L);
+    q_matrix_free(&LD);
+    q_matrix_free(&Lt);
+}
+
+// Factorizes m with the Cholesky (unit = 0) or the LDL^T (unit = 1) factorization
+static void factorize(const q_matrix_t* m, q_matrix_t* factor, int unit)
+{
+    if(unit)
+    {
+        q_matrix_ldlt(m, factor);
+    }
+    else
+    {
+        q_matrix_cholesky(m, factor);
+    }
+}
+
+static void check_factorization(int unit)
+{
+    for(size_t n = 1; n < 32; n++)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t F = q_matrix_square_alloc(n);
+        q_matrix_t R = q_matrix_square_alloc(n);
+        fill_spd(&m);
+
+        // Only the lower triangle is written
+        fill_upper(&F, TEST_SENTINEL);
+        factorize(&m, &F, unit);
+        CU_ASSERT_TRUE(upper_is(&F, TEST_SENTINEL));
+
+        reconstruct(&F, unit, &R);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&R, &m, 0.01f) == Q_MATRIX_OK);
+
+        // Only the lower triangle is read, the factorization can be computed in place
+        q_matrix_cpy(&m, &R);
+        fill_upper(&R, TEST_SENTINEL);
+        factorize(&R, &R, unit);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&R, &F) == Q_MATRIX_OK);
+
+        q_matrix_free(&m);
+        q_matrix_free(&F);
+        q_matrix_free(&R);
+    }
+}
+
+static void check_solve(int unit)
+{
+    for(size_t n = 1; n < 32; n++)
+    {
+        const size_t k = 1 + n % 5;
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t F = q_matrix_square_alloc(n);
+        q_matrix_t X = q_matrix_alloc(n, k);
+        q_matrix_t B = q_matrix_alloc(n, k);
+        q_matrix_t solution = q_matrix_alloc(n, k);
+        q_matrix_t x = q_matrix_alloc(n, 1);
+        q_lu_t lu = q_lu_alloc(n);
+
+        fill_spd(&m);
+        q_matrix_fill_rand_float(&X, -2.0f, 2.0f);
+        q_matrix_dot_product(&m, &X, &B);
+
+        factorize(&m, &F, unit);
+        if(unit)
+        {
+            q_matrix_ldlt_solve(&F, &B, &solution);
+        }
+        else
+        {
+            q_matrix_cholesky_solve(&F, &B, &solution);
+        }
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&solution, &X, 0.01f) == Q_MATRIX_OK);
+
+        // Every column is the solution of the same column, and matches the LU solver
+        q_lu_decompose(&m, &lu);
+        for(size_t c = 0; c < k; c++)
+        {
+            q_matrix_t column = q_matrix_view_col(&B, c);
+            q_lu_solve(&lu, &column, &x);
+            for(size_t i = 0; i < n; i++)
+            {
+                CU_ASSERT_TRUE(q_absolute(Q_MATRIX_AT(&solution, i, c) - Q_MATRIX_AT(&x, i, 0)) <= float_to_q(0.005f));
+            }
+        }
+
+        // The solution may overwrite b
+        if(unit)
+        {
+            q_matrix_ldlt_solve(&F, &B, &B);
+        }
+        else
+        {
+            q_matrix_cholesky_solve(&F, &B, &B);
+        }
+        CU_ASSERT_TRUE(q_matrix_is_equal(&solution, &B) == Q_MATRIX_OK);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&F);
+        q_matrix_free(&X);
+        q_matrix_free(&B);
+        q_matrix_free(&solution);
+        q_matrix_free(&x);
+    }
+}
+
+static void check_inverse(int unit)
+{
+    for(size_t n = 1; n < 32; n++)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t F = q_matrix_square_alloc(n);
+        q_matrix_t inv = q_matrix_square_alloc(n);
+        q_matrix_t prod = q_matrix_square_alloc(n);
+        q_matrix_t I = q_matrix_square_alloc(n);
+        fill_spd(&m);
+        q_matrix_identity(&I);
+
+        factorize(&m, &F, unit);
+        if(unit)
+        {
+            q_matrix_ldlt_inverse(&F, &inv);
+        }
+        else
+        {
+            q_matrix_cholesky_inverse(&F, &inv);
+        }
+
+        q_matrix_dot_product(&m, &inv, &prod);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&prod, &I, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_transpose(&inv, &prod);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&prod, &inv) == Q_MATRIX_OK); // The inverse is symmetric
+
+        // The factor can be its own destination
+        if(unit)
+        {
+            q_matrix_ldlt_inverse(&F, &F);
+        }
+        else
+        {
+            q_matrix_cholesky_inverse(&F, &F);
+        }
+        CU_ASSERT_TRUE(q_matrix_is_equal(&F, &inv) == Q_MATRIX_OK);
+
+        q_matrix_free(&m);
+        q_matrix_free(&F);
+        q_matrix_free(&inv);
+        q_matrix_free(&prod);
+        q_matrix_free(&I);
+    }
+}
+
+void test_q_matrix_cholesky()
+{
+    check_factorization(0);
+
+    // Known factor: [4 2; 2 5] = [2 0; 1 2] * [2 1; 0 2], det = 16
+    q_matrix_t m = q_matrix_square_alloc(2);
+    q_matrix_t L = q_matrix_square_alloc(2);
+    Q_MATRIX_AT(&m, 0, 0) = INT_TO_Q(4);
+    Q_MATRIX_AT(&m, 1, 0) = INT_TO_Q(2);
+    Q_MATRIX_AT(&m, 1, 1) = INT_TO_Q(5);
+
+    q_matrix_cholesky(&m, &L);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&L, 0, 0)), 2.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&L, 1, 0)), 1.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&L, 1, 1)), 2.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_cholesky_determinant(&L)), 16.0, 0.01);
+
+    q_matrix_free(&m);
+    q_matrix_free(&L);
+}
+
+static void check_blocked(int unit)
+{
+    /* The blocked factors must reconstruct A for every panel width and number of threads, only the lower triangle is
+    written. The trailing updates round once per panel, so the factors are only bit identical to the unblocked elimination
+    when there is a single panel.
+    */
+    const size_t sizes[] = {5, 40, 70, 129};
+    const size_t blocks[] = {1, 8, 32, 200};
+    const size_t threads[] = {1, 4};
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const size_t n = sizes[s];
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t reference = q_matrix_square_alloc(n);
+        q_matrix_t F = q_matrix_square_alloc(n);
+        q_matrix_t R = q_matrix_square_alloc(n);
+        fill_spd(&m);
+
+        if(unit)
+        {
+            q_matrix_ldlt_blocked(&m, &reference, n, 1); // Unblocked
+        }
+        else
+        {
+            q_matrix_cholesky_blocked(&m, &reference, n, 1); // Unblocked
+        }
+
+        for(size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++)
+        {
+            for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+            {
+                fill_upper(&F, TEST_SENTINEL);
+                if(unit)
+                {
+                    q_matrix_ldlt_blocked(&m, &F, blocks[b], threads[t]);
+                }
+                else
+                {
+                    q_matrix_cholesky_blocked(&m, &F, blocks[b], threads[t]);
+                }
+                CU_ASSERT_TRUE(upper_is(&F, TEST_SENTINEL));
+
+                reconstruct(&F, unit, &R);
+                CU_ASSERT_TRUE(q_matrix_is_approx_float(&R, &m, 0.01f) == Q_MATRIX_OK);
+
+                fill_upper(&F, Q_ZERO);
+                if(blocks[b] >= n)
+                {
+                    CU_ASSERT_TRUE(q_matrix_is_equal(&F, &reference) == Q_MATRIX_OK);
+                }
+                else
+                {
+                    CU_ASSERT_TRUE(q_matrix_is_approx_float(&F, &reference, 0.001f) == Q_MATRIX_OK);
+                }
+            }
+        }
+
+        q_matrix_free(&m);
+        q_matrix_free(&reference);
+        q_matrix_free(&F);
+        q_matrix_free(&R);
+    }
+}
+
+void test_q_matrix_cholesky_blocked()
+{
+    check_blocked(0);
+}
+
+void test_q_matrix_ldlt_blocked()
+{
+    check_blocked(1);
+}
+
+void test_q_matrix_cholesky_solve()
+{
+    check_solve(0);
+}
+
+void test_q_matrix_cholesky_inverse()
+{
+    check_inverse(0);
+}
+
+void test_q_matrix_ldlt()
+{
+    check_factorization(1);
+
+    // Known factors: [4 2; 2 5] = [1 0; 0.5 1] * diag(4, 4) * [1 0.5; 0 1], det = 16
+    q_matrix_t m = q_matrix_square_alloc(2);
+    q_matrix_t LD = q_matrix_square_alloc(2);
+    Q_MATRIX_AT(&m, 0, 0) = INT_TO_Q(4);
+    Q_MATRIX_AT(&m, 1, 0) = INT_TO_Q(2);
+    Q_MATRIX_AT(&m, 1, 1) = INT_TO_Q(5);
+
+    q_matrix_ldlt(&m, &LD);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&LD, 0, 0), INT_TO_Q(4));
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&LD, 1, 0), float_to_q(0.5f));
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&LD, 1, 1), INT_TO_Q(4));
+    CU_ASSERT_EQUAL(q_matrix_ldlt_determinant(&LD), INT_TO_Q(16));
+
+    // The determinants of both factorizations and of the LU factorization agree
+    for(size_t n = 1; n < 5; n++)
+    {
+        q_matrix_t A = q_matrix_square_alloc(n);
+        q_matrix_t F = q_matrix_square_alloc(n);
+        q_lu_t lu = q_lu_alloc(n);
+        fill_spd(&A);
+
+        q_lu_decompose(&A, &lu);
+        const double reference = q_to_float(q_lu_determinant(&lu));
+
+        q_matrix_ldlt(&A, &F);
+        CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_ldlt_determinant(&F)), reference, 0.001 * reference);
+        q_matrix_cholesky(&A, &F);
+        CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_cholesky_determinant(&F)), reference, 0.001 * reference);
+
+        q_lu_free(&lu);
+        q_matrix_free(&A);
+        q_matrix_free(&F);
+    }
+
+    q_matrix_free(&m);
+    q_matrix_free(&LD);
+}
+
+void test_q_matrix_ldlt_solve()
+{
+    check_solve(1);
+}
+
+void test_q_matrix_ldlt_inverse()
+{
+    check_inverse(1);
+}
+
+void add_cholesky_tests(CU_pSuite suite)
+{
+    if(NULL == CU_add_test(suite, "test_q_matrix_cholesky", test_q_matrix_cholesky)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_cholesky_blocked", test_q_matrix_cholesky_blocked)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_cholesky_solve", test_q_matrix_cholesky_solve)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_cholesky_inverse", test_q_matrix_cholesky_inverse)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_ldlt", test_q_matrix_ldlt)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_ldlt_blocked", test_q_matrix_ldlt_blocked)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_ldlt_solve", test_q_matrix_ldlt_solve)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_ldlt_inverse", test_q_matrix_ldlt_inverse)) {
+        return;
+    }
+}
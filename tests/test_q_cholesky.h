@@ -0,0 +1,18 @@
+#ifndef TEST_Q_CHOLESKY_H
+#define TEST_Q_CHOLESKY_H
+#include "CUnit/Basic.h"
+#include "../include/fix_point_cholesky.h"
+#include "../include/fix_point_lu.h"
+
+void test_q_matrix_cholesky();
+void test_q_matrix_cholesky_blocked();
+void test_q_matrix_cholesky_solve();
+void test_q_matrix_cholesky_inverse();
+void test_q_matrix_ldlt();
+void test_q_matrix_ldlt_blocked();
+void test_q_matrix_ldlt_solve();
+void test_q_matrix_ldlt_inverse();
+
+void add_cholesky_tests(CU_pSuite suite);
+
+#endif // TEST_Q_CHOLESKY_H
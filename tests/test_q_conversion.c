@@ -30,6 +30,36 @@ void testFloat_Q() {
 
 }
 
+// MARK: - Compile time constants
+static const q_t constants[] = {Q_ONE_HALF, Q_PI, Q_TWO_PI, Q_HALF_PI, Q_QUARTER_PI, Q_THIRD_PI, Q_SIXTH_PI, Q_E, Q_MILLI};
+static const double expected_constants[] = {
+    0.5, 3.14159265358979323846, 6.28318530717958647692, 1.57079632679489661923, 0.78539816339744830962,
+    1.04719755119659774615, 0.52359877559829887308, 2.71828182845904523536, 0.001
+};
+
+void testConstants_Q() {
+    const double resolution = 1.0 / (1LL << FRACTIONAL_BITS);
+
+    for (size_t i = 0; i < sizeof(constants) / sizeof(constants[0]); i++){
+        // Rounded to the nearest representable value
+        CU_ASSERT_DOUBLE_EQUAL((double) constants[i] * resolution, expected_constants[i], resolution / 2);
+    }
+
+    CU_ASSERT_EQUAL(Q_MINUS_ONE, -Q_ONE);
+    CU_ASSERT_EQUAL(Q_MINUS_ONE_HALF, -Q_ONE_HALF);
+    CU_ASSERT_EQUAL(Q_NEG_PI, -Q_PI);
+    CU_ASSERT_EQUAL(Q_NEG_HALF_PI, -Q_HALF_PI);
+
+    // The constants are integer constant expressions
+    int matched = 0;
+    switch (constants[1]){
+        case Q_HALF_PI: break;
+        case Q_PI: matched = 1; break;
+        default: break;
+    }
+    CU_ASSERT_EQUAL(matched, 1);
+}
+
 // MARK: - Add Tests to Suite
 void add_conversion_tests(CU_pSuite suite)
 {
@@ -44,4 +74,8 @@ void add_conversion_tests(CU_pSuite suite)
     if (NULL == CU_add_test(suite, "Float_Q_Conversion", testFloat_Q)) {
         return;
     }
+
+    if (NULL == CU_add_test(suite, "Constants_Q", testConstants_Q)) {
+        return;
+    }
 }
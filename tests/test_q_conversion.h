@@ -4,6 +4,7 @@
 
 void testInt_Q();
 void testFloat_Q();
+void testConstants_Q();
 
 void add_conversion_tests(CU_pSuite suite);
 
@@ -0,0 +1,545 @@
+#include "test_q_eigen.h"
+#include <math.h>
+#include "../include/fix_point_simd.h"
+
+// Fills a matrix from a row-major array of floats
+static void fill(q_matrix_t* m, const float* values)
+{
+    for(size_t i = 0; i < m->rows; i++)
+    {
+        for(size_t j = 0; j < m->cols; j++)
+        {
+            Q_MATRIX_AT(m, i, j) = float_to_q(values[i * m->cols + j]);
+        }
+    }
+}
+
+// Checks Q * B * Q^T = A and Q^T * Q = I
+static void check_similarity(const q_matrix_t* A, const q_matrix_t* B, const q_matrix_t* Q, float tol)
+{
+    const size_t n = A->rows;
+    q_matrix_t Qt = q_matrix_square_alloc(n);
+    q_matrix_t QB = q_matrix_square_alloc(n);
+    q_matrix_t QBQt = q_matrix_square_alloc(n);
+    q_matrix_t QtQ = q_matrix_square_alloc(n);
+    q_matrix_t I = q_matrix_square_alloc(n);
+
+    q_matrix_identity(&I);
+    q_matrix_transpose(Q, &Qt);
+    q_matrix_dot_product(Q, B, &QB);
+    q_matrix_dot_product(&QB, &Qt, &QBQt);
+    CU_ASSERT_TRUE(q_matrix_is_approx_float(&QBQt, A, tol) == Q_MATRIX_OK);
+
+    q_matrix_dot_product(&Qt, Q, &QtQ);
+    CU_ASSERT_TRUE(q_matrix_is_approx_float(&QtQ, &I, 0.001f) == Q_MATRIX_OK);
+
+    q_matrix_free(&Qt);
+    q_matrix_free(&QB);
+    q_matrix_free(&QBQt);
+    q_matrix_free(&QtQ);
+    q_matrix_free(&I);
+}
+
+// Checks the eigenvalue layout (sorted real parts, conjugate pairs) and ||A * v - lambda * v|| for every eigenvector
+static void check_eigen(const q_matrix_t* A, const q_matrix_t* values, const q_matrix_t* vectors, float tol)
+{
+    const size_t n = A->rows;
+    float trace = 0.0f;
+    float sum = 0.0f;
+
+    for(size_t j = 0; j < n; j++)
+    {
+        const float re = q_to_float(Q_MATRIX_AT(values, j, 0));
+        const float im = q_to_float(Q_MATRIX_AT(values, j, 1));
+        trace += q_to_float(Q_MATRIX_AT(A, j, j));
+        sum += re;
+
+        if(j > 0)
+        {
+            CU_ASSERT_TRUE(Q_MATRIX_AT(values, j - 1, 0) >= Q_MATRIX_AT(values, j, 0));
+        }
+
+        // Column of the real part and of the imaginary part (conjugated for the second eigenvalue of a pair)
+        size_t cr = j;
+        size_t ci = j;
+        float sign = 0.0f;
+        if(im > 0.0f)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(values, j + 1, 0), Q_MATRIX_AT(values, j, 0));
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(values, j + 1, 1), -Q_MATRIX_AT(values, j, 1));
+            ci = j + 1;
+            sign = 1.0f;
+        }
+        else if(im < 0.0f)
+        {
+            cr = j - 1;
+            sign = -1.0f;
+        }
+
+        if(vectors == NULL)
+        {
+            continue;
+        }
+
+        float norm = 0.0f;
+        float residual = 0.0f;
+        for(size_t i = 0; i < n; i++)
+        {
+            float avr = 0.0f;
+            float avi = 0.0f;
+            for(size_t k = 0; k < n; k++)
+            {
+                const float a = q_to_float(Q_MATRIX_AT(A, i, k));
+                avr += a * q_to_float(Q_MATRIX_AT(vectors, k, cr));
+                avi += a * sign * q_to_float(Q_MATRIX_AT(vectors, k, ci));
+            }
+
+            const float vr = q_to_float(Q_MATRIX_AT(vectors, i, cr));
+            const float vi = sign * q_to_float(Q_MATRIX_AT(vectors, i, ci));
+            const float dr = avr - (re * vr - im * vi);
+            const float di = avi - (re * vi + im * vr);
+            residual += dr * dr + di * di;
+            norm += vr * vr + vi * vi;
+        }
+
+        CU_ASSERT_DOUBLE_EQUAL(norm, 1.0, 0.001);
+        CU_ASSERT_TRUE(sqrtf(residual) < tol);
+    }
+
+    CU_ASSERT_DOUBLE_EQUAL(sum, trace, tol);
+}
+
+void test_q_matrix_hessenberg()
+{
+    for(size_t n = 1; n < 16; n++)
+    {
+        q_matrix_t A = q_matrix_square_alloc(n);
+        q_matrix_t H = q_matrix_square_alloc(n);
+        q_matrix_t Q = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+        q_matrix_hessenberg(&A, &H, &Q);
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = 0; j + 1 < i; j++)
+            {
+                CU_ASSERT_EQUAL(Q_MATRIX_AT(&H, i, j), Q_ZERO);
+            }
+        }
+        check_similarity(&A, &H, &Q, 0.01f);
+
+        // Without Q and in place
+        q_matrix_t in_place = q_matrix_square_alloc(n);
+        q_matrix_cpy(&A, &in_place);
+        q_matrix_hessenberg(&in_place, &in_place, NULL);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&in_place, &H) == Q_MATRIX_OK);
+
+        q_matrix_free(&in_place);
+        q_matrix_free(&A);
+        q_matrix_free(&H);
+        q_matrix_free(&Q);
+    }
+}
+
+void test_q_matrix_schur()
+{
+    for(size_t n = 1; n < 16; n++)
+    {
+        q_matrix_t A = q_matrix_square_alloc(n);
+        q_matrix_t T = q_matrix_square_alloc(n);
+        q_matrix_t Z = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+        CU_ASSERT_EQUAL(q_matrix_schur(&A, &T, &Z), Q_MATRIX_OK);
+
+        // Quasi triangular: zero below the subdiagonal and no two consecutive subdiagonal elements
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = 0; j + 1 < i; j++)
+            {
+                CU_ASSERT_EQUAL(Q_MATRIX_AT(&T, i, j), Q_ZERO);
+            }
+            if((i >= 2) && (Q_MATRIX_AT(&T, i, i - 1) != Q_ZERO))
+            {
+                CU_ASSERT_EQUAL(Q_MATRIX_AT(&T, i - 1, i - 2), Q_ZERO);
+            }
+        }
+        check_similarity(&A, &T, &Z, 0.01f);
+
+        q_matrix_free(&A);
+        q_matrix_free(&T);
+        q_matrix_free(&Z);
+    }
+}
+
+void test_q_matrix_eigenvalues()
+{
+    // Triangular matrix: the diagonal, sorted
+    const float upper[] = {1, 2, 3, 0, -4, 5, 0, 0, 6};
+    q_matrix_t A = q_matrix_square_alloc(3);
+    q_matrix_t values = q_matrix_alloc(3, 2);
+    fill(&A, upper);
+    q_matrix_eigenvalues(&A, &values);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 0)), 6.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 1, 0)), 1.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 2, 0)), -4.0, 0.001);
+    for(size_t i = 0; i < 3; i++)
+    {
+        CU_ASSERT_EQUAL(Q_MATRIX_AT(&values, i, 1), Q_ZERO);
+    }
+
+    // Cyclic permutation: 1 and the complex pair -1/2 +- i * sqrt(3)/2, positive imaginary part first
+    const float cycle[] = {0, 0, 1, 1, 0, 0, 0, 1, 0};
+    fill(&A, cycle);
+    q_matrix_eigenvalues(&A, &values);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 0)), 1.0, 0.001);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&values, 0, 1), Q_ZERO);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 1, 0)), -0.5, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 1, 1)), 0.8660, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 2, 0)), -0.5, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 2, 1)), -0.8660, 0.001);
+    q_matrix_free(&A);
+    q_matrix_free(&values);
+
+    // Companion matrix of (x - 1)(x - 2)(x - 3)(x - 4), its eigenvalues are sensitive to the rounding
+    const float companion[] = {10, -35, 50, -24, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0};
+    A = q_matrix_square_alloc(4);
+    values = q_matrix_alloc(4, 2);
+    fill(&A, companion);
+    q_matrix_eigenvalues(&A, &values);
+    for(size_t i = 0; i < 4; i++)
+    {
+        CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, i, 0)), 4.0 - i, 0.05);
+        CU_ASSERT_EQUAL(Q_MATRIX_AT(&values, i, 1), Q_ZERO);
+    }
+    q_matrix_free(&A);
+    q_matrix_free(&values);
+
+    // Large and small elements are scaled before the iterations
+    const float rotation[] = {1000, 2000, -3000, 500};
+    A = q_matrix_square_alloc(2);
+    values = q_matrix_alloc(2, 2);
+    fill(&A, rotation);
+    q_matrix_eigenvalues(&A, &values);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 0)), 750.0, 0.01);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 1)), 2436.6986, 0.1);
+    const float small[] = {0.1f, 0.2f, -0.3f, 0.05f};
+    fill(&A, small);
+    q_matrix_eigenvalues(&A, &values);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 0)), 0.075, 0.0002);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 1)), 0.2437, 0.0002);
+    q_matrix_free(&A);
+    q_matrix_free(&values);
+
+    // Random matrices: sorted, conjugate pairs, the sum of the eigenvalues is the trace
+    for(size_t n = 1; n < 24; n++)
+    {
+        A = q_matrix_square_alloc(n);
+        values = q_matrix_alloc(n, 2);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+        CU_ASSERT_EQUAL(q_matrix_eigen(&A, &values, NULL), Q_MATRIX_OK);
+        check_eigen(&A, &values, NULL, 0.01f);
+
+        q_matrix_free(&A);
+        q_matrix_free(&values);
+    }
+}
+
+void test_q_matrix_eigenvectors()
+{
+    // Rotation by 90 degrees: i with the eigenvector (1, -i) / sqrt(2) up to a complex factor
+    const float rotation[] = {0, -1, 1, 0};
+    q_matrix_t A = q_matrix_square_alloc(2);
+    q_matrix_t values = q_matrix_alloc(2, 2);
+    q_matrix_t vectors = q_matrix_square_alloc(2);
+    fill(&A, rotation);
+    CU_ASSERT_EQUAL(q_matrix_eigen(&A, &values, &vectors), Q_MATRIX_OK);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, 0, 1)), 1.0, 0.001);
+    check_eigen(&A, &values, &vectors, 0.001f);
+
+    q_matrix_t columns = q_matrix_square_alloc(2);
+    q_matrix_eigenvectors(&A, &columns);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&columns, &vectors) == Q_MATRIX_OK);
+    q_matrix_free(&columns);
+    q_matrix_free(&A);
+    q_matrix_free(&values);
+    q_matrix_free(&vectors);
+
+    for(size_t n = 1; n < 24; n++)
+    {
+        A = q_matrix_square_alloc(n);
+        values = q_matrix_alloc(n, 2);
+        vectors = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+        CU_ASSERT_EQUAL(q_matrix_eigen(&A, &values, &vectors), Q_MATRIX_OK);
+        check_eigen(&A, &values, &vectors, 0.05f);
+
+        // The eigenvalues do not depend on the eigenvectors being computed
+        q_matrix_t only = q_matrix_alloc(n, 2);
+        q_matrix_eigenvalues(&A, &only);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&only, &values, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_free(&only);
+        q_matrix_free(&A);
+        q_matrix_free(&values);
+        q_matrix_free(&vectors);
+    }
+}
+
+void test_q_matrix_eigen_symmetric()
+{
+    for(size_t n = 1; n < 24; n++)
+    {
+        q_matrix_t A = q_matrix_square_alloc(n);
+        q_matrix_t values = q_matrix_alloc(n, 1);
+        q_matrix_t vectors = q_matrix_square_alloc(n);
+        q_matrix_t D = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(&A, i, j) = Q_MATRIX_AT(&A, j, i);
+            }
+        }
+
+        // A = V * D * V^T with orthonormal V and decreasing eigenvalues
+        CU_ASSERT_EQUAL(q_matrix_eigen_symmetric(&A, &values, &vectors), Q_MATRIX_OK);
+        for(size_t i = 0; i < n; i++)
+        {
+            Q_MATRIX_AT(&D, i, i) = Q_MATRIX_AT(&values, i, 0);
+            if(i > 0)
+            {
+                CU_ASSERT_TRUE(Q_MATRIX_AT(&values, i - 1, 0) >= Q_MATRIX_AT(&values, i, 0));
+            }
+        }
+        check_similarity(&A, &D, &vectors, 0.01f);
+
+        // The general interface takes the symmetric path: same eigenvalues and eigenvectors, no imaginary parts
+        q_matrix_t pairs = q_matrix_alloc(n, 2);
+        q_matrix_t general = q_matrix_square_alloc(n);
+        CU_ASSERT_EQUAL(q_matrix_eigen(&A, &pairs, &general), Q_MATRIX_OK);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&general, &vectors) == Q_MATRIX_OK);
+        for(size_t i = 0; i < n; i++)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&pairs, i, 0), Q_MATRIX_AT(&values, i, 0));
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&pairs, i, 1), Q_ZERO);
+        }
+        check_eigen(&A, &pairs, &general, 0.05f);
+
+        q_matrix_free(&pairs);
+        q_matrix_free(&general);
+        q_matrix_free(&A);
+        q_matrix_free(&values);
+        q_matrix_free(&vectors);
+        q_matrix_free(&D);
+    }
+}
+
+void test_q_matrix_eigen_symmetric_methods()
+{
+    /* Both symmetric methods must diagonalize the matrix and agree on the eigenvalues, on either side of
+    Q_EIGEN_JACOBI_MAX. The last matrix has a repeated eigenvalue and an already diagonal block. */
+    const size_t sizes[] = {1, 2, 3, 5, 8, 17, 32, 40};
+    const q_eigen_method_t methods[] = {Q_EIGEN_JACOBI, Q_EIGEN_TRIDIAGONAL_QR};
+
+    for(size_t s = 0; s <= sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const int repeated = (s == sizeof(sizes) / sizeof(sizes[0]));
+        const size_t n = repeated ? 24 : sizes[s];
+        q_matrix_t A = q_matrix_square_alloc(n);
+        q_matrix_t values[2] = {q_matrix_alloc(n, 1), q_matrix_alloc(n, 1)};
+        q_matrix_t vectors = q_matrix_square_alloc(n);
+        q_matrix_t D = q_matrix_square_alloc(n);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = 0; j < i; j++)
+            {
+                Q_MATRIX_AT(&A, i, j) = Q_MATRIX_AT(&A, j, i);
+                if(repeated && (i >= n / 2))
+                {
+                    Q_MATRIX_AT(&A, i, j) = Q_MATRIX_AT(&A, j, i) = Q_ZERO;
+                }
+            }
+            if(repeated && (i >= n / 2))
+            {
+                Q_MATRIX_AT(&A, i, i) = INT_TO_Q(2);
+            }
+        }
+
+        for(size_t m = 0; m < 2; m++)
+        {
+            CU_ASSERT_EQUAL(q_matrix_eigen_symmetric_method(&A, &values[m], &vectors, methods[m]), Q_MATRIX_OK);
+            q_matrix_fill(&D, Q_ZERO);
+            for(size_t i = 0; i < n; i++)
+            {
+                Q_MATRIX_AT(&D, i, i) = Q_MATRIX_AT(&values[m], i, 0);
+            }
+            check_similarity(&A, &D, &vectors, 0.02f);
+        }
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&values[0], &values[1], 0.005f) == Q_MATRIX_OK);
+
+        // The default method is the one selected for this size
+        q_matrix_t chosen = q_matrix_alloc(n, 1);
+        CU_ASSERT_EQUAL(q_matrix_eigen_symmetric(&A, &chosen, NULL), Q_MATRIX_OK);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&chosen, &values[(n <= Q_EIGEN_JACOBI_MAX) ? 0 : 1]) == Q_MATRIX_OK);
+
+        q_matrix_free(&chosen);
+        q_matrix_free(&A);
+        q_matrix_free(&values[0]);
+        q_matrix_free(&values[1]);
+        q_matrix_free(&vectors);
+        q_matrix_free(&D);
+    }
+}
+
+void test_q_matrix_eigen_symmetric3_batch()
+{
+    static const size_t index[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+    static const size_t counts[] = {1, 7, 64, 65, 200};
+
+    for(size_t n = 0; n < sizeof(counts) / sizeof(counts[0]); n++)
+    {
+        const size_t count = counts[n];
+        q_matrix_t A = q_matrix_alloc(6, count);
+        q_matrix_t values = q_matrix_alloc(3, count);
+        q_matrix_t vectors = q_matrix_alloc(9, count);
+        q_matrix_t m = q_matrix_square_alloc(3);
+        q_matrix_t reference = q_matrix_alloc(3, 1);
+        q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+        q_matrix_eigen_symmetric3_batch(&A, &values, &vectors);
+
+        for(size_t c = 0; c < count; c++)
+        {
+            for(size_t i = 0; i < 3; i++)
+            {
+                for(size_t j = 0; j < 3; j++)
+                {
+                    Q_MATRIX_AT(&m, i, j) = Q_MATRIX_AT(&A, index[i][j], c);
+                }
+            }
+
+            // Same eigenvalues as the Jacobi iterations of a single matrix, decreasing
+            CU_ASSERT_EQUAL(q_matrix_eigen_symmetric(&m, &reference, NULL), Q_MATRIX_OK);
+            for(size_t j = 0; j < 3; j++)
+            {
+                CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, j, c)), q_to_float(Q_MATRIX_AT(&reference, j, 0)), 0.001);
+            }
+            CU_ASSERT_TRUE(Q_MATRIX_AT(&values, 0, c) >= Q_MATRIX_AT(&values, 1, c));
+            CU_ASSERT_TRUE(Q_MATRIX_AT(&values, 1, c) >= Q_MATRIX_AT(&values, 2, c));
+
+            // Orthonormal eigenvectors and A * v = lambda * v
+            for(size_t j = 0; j < 3; j++)
+            {
+                for(size_t k = 0; k < 3; k++)
+                {
+                    float dot = 0.0f;
+                    for(size_t i = 0; i < 3; i++)
+                    {
+                        dot += q_to_float(Q_MATRIX_AT(&vectors, 3 * i + j, c)) * q_to_float(Q_MATRIX_AT(&vectors, 3 * i + k, c));
+                    }
+                    CU_ASSERT_DOUBLE_EQUAL(dot, (j == k) ? 1.0 : 0.0, 0.0002);
+                }
+
+                for(size_t i = 0; i < 3; i++)
+                {
+                    float av = 0.0f;
+                    for(size_t k = 0; k < 3; k++)
+                    {
+                        av += q_to_float(Q_MATRIX_AT(&m, i, k)) * q_to_float(Q_MATRIX_AT(&vectors, 3 * k + j, c));
+                    }
+                    const float lv = q_to_float(Q_MATRIX_AT(&values, j, c)) * q_to_float(Q_MATRIX_AT(&vectors, 3 * i + j, c));
+                    CU_ASSERT_DOUBLE_EQUAL(av, lv, 0.001);
+                }
+            }
+        }
+
+        // The scalar and the vector code give the same bits, the eigenvalues do not depend on the eigenvectors
+        q_matrix_t other = q_matrix_alloc(3, count);
+        q_matrix_t other_vectors = q_matrix_alloc(9, count);
+        const q_simd_level_t level = q_simd_kernels()->level;
+        q_simd_set_level(Q_SIMD_SCALAR);
+        q_matrix_eigen_symmetric3_batch(&A, &other, &other_vectors);
+        q_simd_set_level(level);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&other, &values) == Q_MATRIX_OK);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&other_vectors, &vectors) == Q_MATRIX_OK);
+        q_matrix_eigen_symmetric3_batch(&A, &other, NULL);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&other, &values) == Q_MATRIX_OK);
+
+        q_matrix_free(&other);
+        q_matrix_free(&other_vectors);
+        q_matrix_free(&A);
+        q_matrix_free(&values);
+        q_matrix_free(&vectors);
+        q_matrix_free(&m);
+        q_matrix_free(&reference);
+    }
+
+    // Zero, diagonal, large and small matrices: every matrix is scaled on its own
+    const float cases[][6] = {{0, 0, 0, 0, 0, 0}, {1, 0, 0, -2, 0, 3}, {2000, 1000, 0, 2000, 0, 500}, {0.002f, 0.001f, 0, 0.002f, 0, 0.0005f}};
+    const float expected[][3] = {{0, 0, 0}, {3, 1, -2}, {3000, 1000, 500}, {0.003f, 0.001f, 0.0005f}};
+    const size_t count = sizeof(cases) / sizeof(cases[0]);
+    q_matrix_t A = q_matrix_alloc(6, count);
+    q_matrix_t values = q_matrix_alloc(3, count);
+    q_matrix_t vectors = q_matrix_alloc(9, count);
+    for(size_t c = 0; c < count; c++)
+    {
+        for(size_t e = 0; e < 6; e++)
+        {
+            Q_MATRIX_AT(&A, e, c) = float_to_q(cases[c][e]);
+        }
+    }
+
+    q_matrix_eigen_symmetric3_batch(&A, &values, &vectors);
+    for(size_t c = 0; c < count; c++)
+    {
+        for(size_t j = 0; j < 3; j++)
+        {
+            CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&values, j, c)), expected[c][j], 0.0001 + 0.0001 * expected[c][0]);
+        }
+    }
+    for(size_t e = 0; e < 9; e++)
+    {
+        CU_ASSERT_EQUAL(Q_MATRIX_AT(&vectors, e, 0), ((e % 4) == 0) ? Q_ONE : Q_ZERO); // Identity for the zero matrix
+    }
+    CU_ASSERT_EQUAL(q_absolute(Q_MATRIX_AT(&vectors, 2 * 3 + 0, 1)), Q_ONE); // Largest eigenvalue of the diagonal matrix is a22
+
+    q_matrix_free(&A);
+    q_matrix_free(&values);
+    q_matrix_free(&vectors);
+}
+
+void add_eigen_tests(CU_pSuite suite)
+{
+    if(NULL == CU_add_test(suite, "test_q_matrix_hessenberg", test_q_matrix_hessenberg)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_schur", test_q_matrix_schur)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_eigenvalues", test_q_matrix_eigenvalues)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_eigenvectors", test_q_matrix_eigenvectors)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_eigen_symmetric", test_q_matrix_eigen_symmetric)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_eigen_symmetric_methods", test_q_matrix_eigen_symmetric_methods)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_eigen_symmetric3_batch", test_q_matrix_eigen_symmetric3_batch)) {
+        return;
+    }
+}
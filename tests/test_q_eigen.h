@@ -0,0 +1,16 @@
+#ifndef TEST_Q_EIGEN_H
+#define TEST_Q_EIGEN_H
+#include "CUnit/Basic.h"
+#include "../include/fix_point_eigen.h"
+
+void test_q_matrix_hessenberg();
+void test_q_matrix_schur();
+void test_q_matrix_eigenvalues();
+void test_q_matrix_eigenvectors();
+void test_q_matrix_eigen_symmetric();
+void test_q_matrix_eigen_symmetric_methods();
+void test_q_matrix_eigen_symmetric3_batch();
+
+void add_eigen_tests(CU_pSuite suite);
+
+#endif // TEST_Q_EIGEN_H
@@ -0,0 +1,131 @@
+#include "test_q_formats.h"
+
+Q_DECLARE_FORMAT(q8_24, int32_t, int64_t, 24, INT32_MIN, INT32_MAX) // User declared family
+
+void test_q_formats_conversion()
+{
+    for(float x = -0.99f; x < 0.99f; x += 0.01f)
+    {
+        CU_ASSERT_DOUBLE_EQUAL(q7_to_float(q7_from_float(x)), x, 1.0 / (1 << 7));
+        CU_ASSERT_DOUBLE_EQUAL(q15_to_float(q15_from_float(x)), x, 1.0 / (1 << 15));
+        CU_ASSERT_DOUBLE_EQUAL(q31_to_float(q31_from_float(x)), x, 1e-6);
+        CU_ASSERT_DOUBLE_EQUAL(q16_16_to_float(q16_16_from_float(100.0f * x)), 100.0f * x, 1.0 / (1 << 16));
+        CU_ASSERT_DOUBLE_EQUAL(q8_24_to_float(q8_24_from_float(100.0f * x)), 100.0f * x, 1e-5);
+    }
+
+    for(int32_t i = -100; i <= 100; i++)
+    {
+        CU_ASSERT_EQUAL(q16_16_to_int(q16_16_from_int(i)), i);
+        CU_ASSERT_EQUAL(q8_24_to_int(q8_24_from_int(i)), i);
+        CU_ASSERT_EQUAL(q16_16_to_q(q16_16_from_int(i)), (i < 0) ? -INT_TO_Q(-i) : INT_TO_Q(i));
+    }
+
+    // Conversions with the active format are exact when no bits are lost
+    CU_ASSERT_EQUAL(q15_to_q(q15_from_q(Q_ONE_HALF)), Q_ONE_HALF);
+    CU_ASSERT_EQUAL(q31_to_q(q31_from_q(Q_ONE_HALF)), Q_ONE_HALF);
+    CU_ASSERT_EQUAL(Q_CONVERT(q15, q31, q15_from_float(0.25f)), q31_from_float(0.25f));
+    CU_ASSERT_EQUAL(Q_CONVERT(q31, q7, q31_from_float(-0.5f)), q7_from_float(-0.5f));
+}
+
+void test_q_formats_arithmetic()
+{
+    const float values[] = {-0.75f, -0.5f, -0.125f, 0.0f, 0.0625f, 0.25f, 0.5f, 0.875f};
+    const size_t n = sizeof(values) / sizeof(values[0]);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            const float a = values[i], b = values[j];
+
+            CU_ASSERT_DOUBLE_EQUAL(q15_to_float(q15_product(q15_from_float(a), q15_from_float(b))), a * b, 1.0 / (1 << 14));
+            CU_ASSERT_DOUBLE_EQUAL(q31_to_float(q31_product(q31_from_float(a), q31_from_float(b))), a * b, 1e-6);
+            CU_ASSERT_DOUBLE_EQUAL(q7_to_float(q7_product(q7_from_float(a), q7_from_float(b))), a * b, 1.0 / (1 << 6));
+            CU_ASSERT_DOUBLE_EQUAL(q16_16_to_float(q16_16_add(q16_16_from_float(a), q16_16_from_float(b))), a + b, 1e-6);
+            CU_ASSERT_DOUBLE_EQUAL(q15_to_float(q15_sub(q15_from_float(a), q15_from_float(b))),
+                                   fminf(fmaxf(a - b, -1.0f), 32767.0f / 32768.0f), 1.0 / (1 << 14));
+
+            if(fabsf(a) < fabsf(b))
+            {
+                CU_ASSERT_DOUBLE_EQUAL(q15_to_float(q15_division(q15_from_float(a), q15_from_float(b))), a / b, 1.0 / (1 << 13));
+                CU_ASSERT_DOUBLE_EQUAL(q31_to_float(q31_division(q31_from_float(a), q31_from_float(b))), a / b, 1e-6);
+            }
+
+            CU_ASSERT_DOUBLE_EQUAL(q8_24_to_float(q8_24_product(q8_24_from_float(8 * a), q8_24_from_float(8 * b))), 64 * a * b, 1e-5);
+        }
+
+        CU_ASSERT_DOUBLE_EQUAL(q15_to_float(q15_absolute(q15_from_float(values[i]))), fabsf(values[i]), 1.0 / (1 << 15));
+    }
+}
+
+void test_q_formats_saturation()
+{
+    // -1 * -1 = 1 is not representable in the Q0.n families
+    CU_ASSERT_EQUAL(q7_product(q7_MIN, q7_MIN), q7_MAX);
+    CU_ASSERT_EQUAL(q15_product(q15_MIN, q15_MIN), q15_MAX);
+    CU_ASSERT_EQUAL(q31_product(q31_MIN, q31_MIN), q31_MAX);
+    CU_ASSERT_EQUAL(q15_absolute(q15_MIN), q15_MAX);
+
+    CU_ASSERT_EQUAL(q15_add(q15_from_float(0.75f), q15_from_float(0.75f)), q15_MAX);
+    CU_ASSERT_EQUAL(q15_sub(q15_from_float(-0.75f), q15_from_float(0.75f)), q15_MIN);
+    CU_ASSERT_EQUAL(q15_division(q15_from_float(0.5f), q15_from_float(0.25f)), q15_MAX);
+    CU_ASSERT_EQUAL(q15_division(q15_from_float(-0.5f), q15_from_float(0.25f)), q15_MIN);
+    CU_ASSERT_EQUAL(q15_division(q15_from_float(0.5f), 0), q15_MAX);
+    CU_ASSERT_EQUAL(q31_division(q31_from_float(-0.5f), 0), q31_MIN);
+
+    CU_ASSERT_EQUAL(q15_from_float(2.0f), q15_MAX);
+    CU_ASSERT_EQUAL(q15_from_float(-2.0f), q15_MIN);
+    CU_ASSERT_EQUAL(q15_from_q(INT_TO_Q(3)), q15_MAX);
+    CU_ASSERT_EQUAL(q15_from_q(-INT_TO_Q(3)), q15_MIN);
+    CU_ASSERT_EQUAL(Q_CONVERT(q16_16, q7, q16_16_from_int(5)), q7_MAX);
+
+    CU_ASSERT_EQUAL(q7_ONE, q7_MAX);   // 1 is not representable in Q0.7, the closest value is used
+    CU_ASSERT_EQUAL(q16_16_ONE, 1 << 16);
+}
+
+void test_q_formats_side_by_side()
+{
+    /* Sensor samples in Q15 are scaled by a Q16.16 gain into the active format without an intermediate float conversion. */
+    q15_t samples[16];
+    q_t scaled[16];
+    const q16_16_t gain = q16_16_from_float(12.5f);
+
+    for(size_t i = 0; i < 16; i++)
+    {
+        samples[i] = q15_from_float(((float) i - 8.0f) / 8.5f);
+        scaled[i] = q16_16_to_q(q16_16_product(Q_CONVERT(q15, q16_16, samples[i]), gain));
+    }
+
+    for(size_t i = 0; i < 16; i++)
+    {
+        CU_ASSERT_DOUBLE_EQUAL(q_to_float(scaled[i]), 12.5f * q15_to_float(samples[i]), 2.0 / (1 << 15));
+    }
+
+    CU_ASSERT_EQUAL(sizeof(q7_t), 1);
+    CU_ASSERT_EQUAL(sizeof(q15_t), 2);
+    CU_ASSERT_EQUAL(sizeof(q31_t), 4);
+    CU_ASSERT_EQUAL(sizeof(q16_16_t), 4);
+}
+
+void add_formats_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_formats_conversion", test_q_formats_conversion)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_formats_arithmetic", test_q_formats_arithmetic)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_formats_saturation", test_q_formats_saturation)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_formats_side_by_side", test_q_formats_side_by_side)) {
+        return;
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef TEST_Q_FORMATS_H
+#define TEST_Q_FORMATS_H
+#include <math.h>
+#include "CUnit/Basic.h"
+#include "../include/fix_point_formats.h"
+
+void test_q_formats_conversion();
+void test_q_formats_arithmetic();
+void test_q_formats_saturation();
+void test_q_formats_side_by_side();
+
+void add_formats_tests(CU_pSuite suite);
+
+#endif // TEST_Q_FORMATS_H
@@ -0,0 +1,250 @@
+#include "test_q_gemm.h"
+
+/**
+ * @brief Reference product with the naive triple loop and the same accumulation mode as the library (C = A * B, C = C + A * B or C = C - A * B)
+ * 
+ * @param a The reference to matrix A
+ * @param b The reference to matrix B
+ * @param c The reference to the resulting matrix C
+ * @param mode The GEMM mode
+ */
+static void reference_product(const q_matrix_t* a, const q_matrix_t* b, q_matrix_t* c, q_gemm_mode_t mode)
+{
+    for(size_t i = 0; i < c->rows; i++)
+    {
+        for(size_t j = 0; j < c->cols; j++)
+        {
+            q_acc_t sum = (mode == Q_GEMM_OVERWRITE) ? 0 : Q_ACC_FROM_Q(Q_MATRIX_AT(c, i, j));
+            for(size_t k = 0; k < a->cols; k++)
+            {
+                if(mode == Q_GEMM_SUBTRACT)
+                {
+                    sum -= Q_ACC_TERM(Q_MATRIX_AT(a, i, k), Q_MATRIX_AT(b, k, j));
+                }
+                else
+                {
+                    sum += Q_ACC_TERM(Q_MATRIX_AT(a, i, k), Q_MATRIX_AT(b, k, j));
+                }
+            }
+            Q_MATRIX_AT(c, i, j) = Q_ACC_TO_Q(sum);
+        }
+    }
+}
+
+void test_q_gemm_modes()
+{
+    /* We are evaluating the three modes of the GEMM against the reference product.
+
+    C = A * B, C = C + A * B, C = C - A * B
+    */
+    q_matrix_t a = q_matrix_alloc(37, 29);
+    q_matrix_t b = q_matrix_alloc(29, 41);
+    q_matrix_t c = q_matrix_alloc(37, 41);
+    q_matrix_t expected = q_matrix_alloc(37, 41);
+
+    q_matrix_fill_rand_float(&a, -4.0f, 4.0f);
+    q_matrix_fill_rand_float(&b, -4.0f, 4.0f);
+
+    const q_gemm_mode_t modes[] = {Q_GEMM_OVERWRITE, Q_GEMM_ADD, Q_GEMM_SUBTRACT};
+
+    for(size_t i = 0; i < 3; i++)
+    {
+        q_matrix_fill_float(&c, 1.5f);
+        q_matrix_fill_float(&expected, 1.5f);
+
+        q_gemm(&a, &b, &c, modes[i]);
+        reference_product(&a, &b, &expected, modes[i]);
+
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &expected) == Q_MATRIX_OK);
+    }
+
+    q_matrix_free(&a);
+    q_matrix_free(&b);
+    q_matrix_free(&c);
+    q_matrix_free(&expected);
+}
+
+void test_q_gemm_sizes()
+{
+    // The edges of the register tiles and the cache blocks must be handled for every shape
+    const size_t sizes[] = {1, 2, 3, 4, 5, 7, 8, 13, 16, 31, 64, 67, 130};
+    const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        for(size_t j = 0; j < count; j += 3)
+        {
+            size_t m = sizes[i], k = sizes[j], n = sizes[(i + j) % count];
+
+            q_matrix_t a = q_matrix_alloc(m, k);
+            q_matrix_t b = q_matrix_alloc(k, n);
+            q_matrix_t c = q_matrix_alloc(m, n);
+            q_matrix_t ref = q_matrix_alloc(m, n);
+
+            q_matrix_fill_rand_float(&a, -2.0f, 2.0f);
+            q_matrix_fill_rand_float(&b, -2.0f, 2.0f);
+
+            reference_product(&a, &b, &ref, Q_GEMM_OVERWRITE);
+            q_matrix_dot_product(&a, &b, &c);
+
+            CU_ASSERT_TRUE(q_matrix_is_equal(&c, &ref) == Q_MATRIX_OK);
+
+            q_matrix_free(&a);
+            q_matrix_free(&b);
+            q_matrix_free(&c);
+            q_matrix_free(&ref);
+        }
+    }
+}
+
+void test_q_gemm_depth_slices()
+{
+    // Deep products are accumulated over several slices of the depth, the partial sums must be carried exactly
+    const size_t m = 13, k = 3 * Q_GEMM_L1_BYTES / (2 * Q_GEMM_NR * sizeof(q_t)) + 5, n = 11;
+    q_matrix_t a = q_matrix_alloc(m, k);
+    q_matrix_t b = q_matrix_alloc(k, n);
+    q_matrix_t c = q_matrix_alloc(m, n);
+    q_matrix_t ref = q_matrix_alloc(m, n);
+
+    q_matrix_fill_rand_float(&a, -2.0f, 2.0f);
+    q_matrix_fill_rand_float(&b, -2.0f, 2.0f);
+    q_matrix_fill_rand_float(&c, -2.0f, 2.0f);
+    q_matrix_cpy(&c, &ref);
+
+    reference_product(&a, &b, &ref, Q_GEMM_SUBTRACT);
+    q_gemm(&a, &b, &c, Q_GEMM_SUBTRACT);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&c, &ref) == Q_MATRIX_OK);
+
+    // The first half of the depth overflows the Q range and the second half cancels it out
+    q_matrix_fill(&a, INT_TO_Q(100));
+    for(size_t p = 0; p < k; p++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            Q_MATRIX_AT(&b, p, j) = (p < k / 2) ? INT_TO_Q(100) : ((p < 2 * (k / 2)) ? -INT_TO_Q(100) : Q_ZERO);
+        }
+    }
+    q_matrix_dot_product(&a, &b, &c);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&c, m - 1, n - 1), Q_ZERO);
+
+    q_matrix_free(&a);
+    q_matrix_free(&b);
+    q_matrix_free(&c);
+    q_matrix_free(&ref);
+}
+
+void test_q_gemm_wide_accumulation()
+{
+#if Q_ACCUMULATE_WIDE
+    /* With the wide accumulation the products are rescaled once, so the sum of many products smaller than the
+    resolution is not lost. And the result saturates instead of wrapping around.
+    */
+    const size_t n = 1024;
+    q_matrix_t a = q_matrix_alloc(1, n);
+    q_matrix_t b = q_matrix_alloc(n, 1);
+    q_matrix_t c = q_matrix_alloc(1, 1);
+
+    q_matrix_fill(&a, (q_t) 1); // Smallest representable number
+    q_matrix_fill(&b, Q_ONE_HALF);
+    q_matrix_dot_product(&a, &b, &c);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&c, 0, 0), (q_t) (n / 2)); // Every single product truncates to 0
+
+    q_matrix_fill(&a, INT_TO_Q(100));
+    q_matrix_fill(&b, INT_TO_Q(100));
+    q_matrix_dot_product(&a, &b, &c);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&c, 0, 0), Q_RAW_MAX);
+
+    q_matrix_fill(&b, -INT_TO_Q(100));
+    q_matrix_dot_product(&a, &b, &c);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&c, 0, 0), Q_RAW_MIN);
+
+    // Products close to the range of q_long_t must be accumulated without overflow
+    q_matrix_t d = q_matrix_alloc(64, 64);
+    q_matrix_t e = q_matrix_alloc(64, 64);
+    q_matrix_t f = q_matrix_alloc(64, 64);
+    q_matrix_fill(&d, Q_RAW_MAX);
+    q_matrix_fill(&e, Q_RAW_MAX);
+    Q_MATRIX_AT(&e, 3, 5) = -Q_RAW_MAX;
+    for(size_t k = 0; k < 64; k += 2)
+    {
+        Q_MATRIX_AT(&d, 7, k) = -Q_RAW_MAX;
+    }
+    q_matrix_dot_product(&d, &e, &f);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&f, 0, 0), Q_RAW_MAX);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&f, 7, 0), Q_ZERO); // The positive and negative products cancel out exactly
+
+    q_matrix_free(&a);
+    q_matrix_free(&b);
+    q_matrix_free(&c);
+    q_matrix_free(&d);
+    q_matrix_free(&e);
+    q_matrix_free(&f);
+#endif // Q_ACCUMULATE_WIDE
+}
+
+void test_q_gemm_threads()
+{
+    /* The parallel product must be bit-exact with the single threaded one for any number of threads, shape and mode. */
+    const size_t shapes[][3] = {{200, 150, 170}, {37, 300, 400}, {513, 129, 65}, {130, 1030, 130}};
+    const size_t threads[] = {2, 3, 4, 7, 16};
+
+    for(size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        const size_t m = shapes[s][0], k = shapes[s][1], n = shapes[s][2];
+        q_matrix_t a = q_matrix_alloc(m, k);
+        q_matrix_t b = q_matrix_alloc(k, n);
+        q_matrix_t c0 = q_matrix_alloc(m, n);
+        q_matrix_t ref = q_matrix_alloc(m, n);
+        q_matrix_t c = q_matrix_alloc(m, n);
+
+        q_matrix_fill_rand_float(&a, -2.0f, 2.0f);
+        q_matrix_fill_rand_float(&b, -2.0f, 2.0f);
+        q_matrix_fill_rand_float(&c0, -2.0f, 2.0f);
+
+        for(int mode = Q_GEMM_OVERWRITE; mode <= Q_GEMM_SUBTRACT; mode++)
+        {
+            q_matrix_cpy(&c0, &ref);
+            q_gemm_parallel(&a, &b, &ref, (q_gemm_mode_t) mode, 1);
+
+            for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+            {
+                q_matrix_cpy(&c0, &c);
+                q_gemm_parallel(&a, &b, &c, (q_gemm_mode_t) mode, threads[t]);
+                CU_ASSERT_TRUE(memcmp(c.elements, ref.elements, m * n * sizeof(q_t)) == 0);
+            }
+        }
+
+        q_matrix_free(&a);
+        q_matrix_free(&b);
+        q_matrix_free(&c0);
+        q_matrix_free(&ref);
+        q_matrix_free(&c);
+    }
+}
+
+void add_gemm_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_gemm_modes", test_q_gemm_modes)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_gemm_sizes", test_q_gemm_sizes)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_gemm_depth_slices", test_q_gemm_depth_slices)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_gemm_wide_accumulation", test_q_gemm_wide_accumulation)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_gemm_threads", test_q_gemm_threads)) {
+        return;
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef TEST_Q_GEMM_H
+#define TEST_Q_GEMM_H
+#include "CUnit/Basic.h"
+#include "../include/fix_point_gemm.h"
+
+void test_q_gemm_modes();
+void test_q_gemm_sizes();
+void test_q_gemm_depth_slices();
+void test_q_gemm_wide_accumulation();
+void test_q_gemm_threads();
+
+void add_gemm_tests(CU_pSuite suite);
+
+#endif // TEST_Q_GEMM_H
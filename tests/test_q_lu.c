@@ -0,0 +1,322 @@
+#include "test_q_lu.h"
+
+void test_q_lu_decompose()
+{
+    /* The packed factors must match q_matrix_PLU_decomposition bit for bit, and P * L * U must give back A. */
+    for(size_t n = 1; n < 24; n++)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t P = q_matrix_square_alloc(n);
+        q_matrix_t L = q_matrix_square_alloc(n);
+        q_matrix_t U = q_matrix_square_alloc(n);
+        q_lu_t lu = q_lu_alloc(n);
+        q_matrix_fill_rand_float(&m, -8.0f, 8.0f);
+
+        q_matrix_PLU_decomposition(&m, &P, &L, &U);
+        q_lu_decompose(&m, &lu);
+
+        int parity = 1;
+        for(size_t i = 0; i < n; i++)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&P, lu.perm[i], i), Q_ONE); // The dense permutation has its one at perm[i]
+            for(size_t j = 0; j < n; j++)
+            {
+                if(j < i)
+                {
+                    CU_ASSERT_EQUAL(Q_MATRIX_AT(&lu.LU, i, j), Q_MATRIX_AT(&L, i, j));
+                }
+                else
+                {
+                    CU_ASSERT_EQUAL(Q_MATRIX_AT(&lu.LU, i, j), Q_MATRIX_AT(&U, i, j));
+                }
+            }
+
+            // Count the inversions of the permutation
+            for(size_t j = i + 1; j < n; j++)
+            {
+                if(lu.perm[j] < lu.perm[i])
+                {
+                    parity = -parity;
+                }
+            }
+        }
+        CU_ASSERT_EQUAL(lu.parity, parity);
+
+        // The factorization can be computed in place
+        q_matrix_cpy(&m, &lu.LU);
+        q_lu_decompose(&lu.LU, &lu);
+        CU_ASSERT_EQUAL(Q_MATRIX_AT(&lu.LU, n - 1, n - 1), Q_MATRIX_AT(&U, n - 1, n - 1));
+
+        q_lu_free(&lu);
+        CU_ASSERT_PTR_NULL(lu.perm);
+        q_matrix_free(&m);
+        q_matrix_free(&P);
+        q_matrix_free(&L);
+        q_matrix_free(&U);
+    }
+}
+
+void test_q_lu_solve()
+{
+    /* A * x = b with a known x, the solution must also match q_matrix_LUP_solve. */
+    for(size_t n = 1; n < 32; n++)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t P = q_matrix_square_alloc(n);
+        q_matrix_t L = q_matrix_square_alloc(n);
+        q_matrix_t U = q_matrix_square_alloc(n);
+        q_matrix_t x = q_matrix_alloc(n, 1);
+        q_matrix_t b = q_matrix_alloc(n, 1);
+        q_matrix_t solution = q_matrix_alloc(n, 1);
+        q_matrix_t reference = q_matrix_alloc(n, 1);
+        q_lu_t lu = q_lu_alloc(n);
+
+        fill_well_conditioned(&m, INT_TO_Q(m.rows));
+        q_matrix_fill_rand_float(&x, -2.0f, 2.0f);
+        q_matrix_dot_product(&m, &x, &b);
+
+        q_lu_decompose(&m, &lu);
+        q_lu_solve(&lu, &b, &solution);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&solution, &x, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_PLU_decomposition(&m, &P, &L, &U);
+        q_matrix_LUP_solve(&L, &U, &P, &b, &reference);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&solution, &reference) == Q_MATRIX_OK);
+
+        // The solution may overwrite b
+        q_lu_solve(&lu, &b, &b);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&solution, &b) == Q_MATRIX_OK);
+
+        // Several right-hand sides in one call, the column c is the solution for the column c
+        const size_t k = 1 + n % 5;
+        q_matrix_t B = q_matrix_alloc(n, k);
+        q_matrix_t X = q_matrix_alloc(n, k);
+        q_matrix_fill_rand_float(&B, -2.0f, 2.0f);
+        q_lu_solve(&lu, &B, &X);
+        for(size_t c = 0; c < k; c++)
+        {
+            q_matrix_t column = q_matrix_view_col(&B, c);
+            q_lu_solve(&lu, &column, &solution);
+            for(size_t i = 0; i < n; i++)
+            {
+                CU_ASSERT_EQUAL(Q_MATRIX_AT(&X, i, c), Q_MATRIX_AT(&solution, i, 0));
+            }
+        }
+        q_matrix_free(&B);
+        q_matrix_free(&X);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&P);
+        q_matrix_free(&L);
+        q_matrix_free(&U);
+        q_matrix_free(&x);
+        q_matrix_free(&b);
+        q_matrix_free(&solution);
+        q_matrix_free(&reference);
+    }
+}
+
+void test_q_lu_determinant()
+{
+    // A single row switch of a diagonal matrix (negative sign)
+    q_matrix_t m = q_matrix_square_alloc(3);
+    Q_MATRIX_AT(&m, 0, 1) = INT_TO_Q(2);
+    Q_MATRIX_AT(&m, 1, 0) = INT_TO_Q(3);
+    Q_MATRIX_AT(&m, 2, 2) = INT_TO_Q(4);
+
+    q_lu_t lu = q_lu_alloc(3);
+    q_lu_decompose(&m, &lu);
+    CU_ASSERT_EQUAL(lu.parity, -1);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_lu_determinant(&lu)), -24.0, 0.001);
+
+    // Cyclic permutation (two row switches, positive sign)
+    q_zeros(&m);
+    Q_MATRIX_AT(&m, 0, 1) = INT_TO_Q(2);
+    Q_MATRIX_AT(&m, 1, 2) = INT_TO_Q(3);
+    Q_MATRIX_AT(&m, 2, 0) = INT_TO_Q(4);
+    q_lu_decompose(&m, &lu);
+    CU_ASSERT_EQUAL(lu.parity, 1);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_lu_determinant(&lu)), 24.0, 0.001);
+    CU_ASSERT_EQUAL(q_lu_determinant(&lu), q_matrix_determinant(&m));
+
+    q_lu_free(&lu);
+    q_matrix_free(&m);
+}
+
+void test_q_lu_inverse()
+{
+    for(size_t n = 1; n < 24; n++)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t inv = q_matrix_square_alloc(n);
+        q_matrix_t prod = q_matrix_square_alloc(n);
+        q_matrix_t I = q_matrix_square_alloc(n);
+        q_lu_t lu = q_lu_alloc(n);
+
+        fill_well_conditioned(&m, INT_TO_Q(m.rows));
+        q_matrix_identity(&I);
+
+        q_lu_decompose(&m, &lu);
+        q_lu_inverse(&lu, &inv);
+        q_matrix_dot_product(&m, &inv, &prod);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&prod, &I, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_inverse(&m, &prod);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&prod, &inv) == Q_MATRIX_OK);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&inv);
+        q_matrix_free(&prod);
+        q_matrix_free(&I);
+    }
+}
+
+void test_q_lu_inverse_in_place()
+{
+    /* The inverse overwrites the factorization, the source matrix can be its own destination. */
+    for(size_t n = 1; n < 40; n += 3)
+    {
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t inv = q_matrix_square_alloc(n);
+        q_matrix_t prod = q_matrix_square_alloc(n);
+        q_matrix_t I = q_matrix_square_alloc(n);
+        q_lu_t lu = q_lu_alloc(n);
+
+        q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+        for(size_t i = 0; i < n; i++)
+        {
+            // A small diagonal so the pivoting has to switch rows
+            Q_MATRIX_AT(&m, i, i) = float_to_q(0.01f);
+            Q_MATRIX_AT(&m, i, (i + 1) % n) += INT_TO_Q(n);
+        }
+        q_matrix_identity(&I);
+
+        q_lu_decompose(&m, &lu);
+        q_lu_inverse_in_place(&lu);
+        q_matrix_dot_product(&m, &lu.LU, &prod);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&prod, &I, 0.01f) == Q_MATRIX_OK);
+        q_matrix_dot_product(&lu.LU, &m, &prod);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&prod, &I, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_cpy(&m, &inv);
+        q_matrix_inverse(&inv, &inv);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&inv, &lu.LU) == Q_MATRIX_OK);
+
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&inv);
+        q_matrix_free(&prod);
+        q_matrix_free(&I);
+    }
+}
+
+void test_q_lu_decompose_blocked()
+{
+    /* The blocked factors must reconstruct A (row i of L * U is the row perm[i] of A) for every panel width and number of
+    threads. The pivots may differ from the unblocked elimination when two candidates are within rounding of each other,
+    so the factors themselves are only compared when there is a single panel.
+    */
+    const size_t sizes[] = {5, 40, 70, 129};
+    const size_t blocks[] = {1, 8, 32, 200};
+    const size_t threads[] = {1, 4};
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const size_t n = sizes[s];
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t L = q_matrix_square_alloc(n);
+        q_matrix_t U = q_matrix_square_alloc(n);
+        q_matrix_t LU = q_matrix_square_alloc(n);
+        q_matrix_t PA = q_matrix_square_alloc(n);
+        q_lu_t reference = q_lu_alloc(n);
+        q_lu_t lu = q_lu_alloc(n);
+
+        q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+        for(size_t i = 0; i < n; i++)
+        {
+            Q_MATRIX_AT(&m, i, (i * 7) % n) += INT_TO_Q(2); // Large elements off the diagonal force row switches
+        }
+        q_lu_decompose_blocked(&m, &reference, n, 1); // Unblocked
+
+        for(size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++)
+        {
+            for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+            {
+                q_lu_decompose_blocked(&m, &lu, blocks[b], threads[t]);
+
+                q_zeros(&L);
+                q_zeros(&U);
+                for(size_t i = 0; i < n; i++)
+                {
+                    for(size_t j = 0; j < n; j++)
+                    {
+                        if(j < i)
+                        {
+                            Q_MATRIX_AT(&L, i, j) = Q_MATRIX_AT(&lu.LU, i, j);
+                        }
+                        else
+                        {
+                            Q_MATRIX_AT(&U, i, j) = Q_MATRIX_AT(&lu.LU, i, j);
+                        }
+                    }
+                    Q_MATRIX_AT(&L, i, i) = Q_ONE;
+
+                    q_matrix_t src = q_matrix_view_row(&m, lu.perm[i]);
+                    q_matrix_t dst = q_matrix_view_row(&PA, i);
+                    q_matrix_cpy(&src, &dst);
+                }
+
+                q_matrix_dot_product(&L, &U, &LU);
+                CU_ASSERT_TRUE(q_matrix_is_approx_float(&LU, &PA, 0.01f) == Q_MATRIX_OK);
+
+                if(blocks[b] >= n)
+                {
+                    // A single panel is the unblocked elimination
+                    CU_ASSERT_TRUE(q_matrix_is_equal(&lu.LU, &reference.LU) == Q_MATRIX_OK);
+                    CU_ASSERT_EQUAL(lu.parity, reference.parity);
+                }
+            }
+        }
+
+        q_lu_free(&reference);
+        q_lu_free(&lu);
+        q_matrix_free(&m);
+        q_matrix_free(&L);
+        q_matrix_free(&U);
+        q_matrix_free(&LU);
+        q_matrix_free(&PA);
+    }
+}
+
+void add_lu_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_lu_decompose", test_q_lu_decompose)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_lu_decompose_blocked", test_q_lu_decompose_blocked)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_lu_solve", test_q_lu_solve)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_lu_determinant", test_q_lu_determinant)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_lu_inverse", test_q_lu_inverse)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_lu_inverse_in_place", test_q_lu_inverse_in_place)) {
+        return;
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_Q_LU_H
+#define TEST_Q_LU_H
+#include "CUnit/Basic.h"
+#include "test_fixtures.h"
+#include "../include/fix_point_lu.h"
+
+void test_q_lu_decompose();
+void test_q_lu_decompose_blocked();
+void test_q_lu_solve();
+void test_q_lu_determinant();
+void test_q_lu_inverse();
+void test_q_lu_inverse_in_place();
+
+void add_lu_tests(CU_pSuite suite);
+
+#endif // TEST_Q_LU_H
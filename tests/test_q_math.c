@@ -160,6 +160,20 @@ void testIntPower()
 
     CU_ASSERT_DOUBLE_EQUAL(2267.5736961451244, q_to_float(b), 2267.5736961451244 * 0.01);
 
+    // Large powers take a logarithmic number of products (no recursion)
+    CU_ASSERT_EQUAL(q_int_power(Q_ONE, INT32_MAX), Q_ONE);
+    CU_ASSERT_EQUAL(q_int_power(Q_ONE, INT32_MIN), Q_ONE);
+    CU_ASSERT_EQUAL(q_int_power(-Q_ONE, 1000001), -Q_ONE);
+    CU_ASSERT_EQUAL(q_int_power(Q_ONE_HALF, 1000000), Q_ZERO);
+
+    a = float_to_q(0.99f);
+    CU_ASSERT_DOUBLE_EQUAL(pow(q_to_float(a), 100), q_to_float(q_int_power(a, 100)), 0.0005);
+    CU_ASSERT_DOUBLE_EQUAL(pow(q_to_float(a), 100), q_to_float(q_int_power_round(a, 100, Q_ROUND_DOWN)), 0.002);
+    CU_ASSERT_TRUE(q_int_power_round(a, 100, Q_ROUND_DOWN) <= q_int_power_round(a, 100, Q_ROUND_NEAREST));
+
+    // The powers saturate instead of wrapping
+    CU_ASSERT_EQUAL(q_int_power(INT_TO_Q(10), 20), Q_RAW_MAX);
+    CU_ASSERT_EQUAL(q_int_power(-INT_TO_Q(10), 21), Q_RAW_MIN);
 }
 
 // MARK: - Square Root Q format
@@ -180,6 +194,97 @@ void test_q_sqrt()
         CU_ASSERT_DOUBLE_EQUAL(sqrt(x), q_to_float(b), 0.001);
     }
 
+    // The result is the square root of a * 2^FRACTIONAL_BITS rounded to the nearest: (2r - 1)^2 <= 4x <= (2r + 1)^2
+    for (int64_t a = 1; a <= Q_RAW_MAX; a += (a < 4096) ? 1 : (Q_RAW_MAX / 4096)){
+        const int64_t r = q_sqrt((q_t) a);
+        const uint64_t x = (uint64_t) a << FRACTIONAL_BITS;
+
+        CU_ASSERT_TRUE((uint64_t) ((2 * r - 1) * (2 * r - 1)) <= 4 * x);
+        CU_ASSERT_TRUE(4 * x <= (uint64_t) ((2 * r + 1) * (2 * r + 1)));
+    }
+    CU_ASSERT_EQUAL(q_sqrt(Q_ZERO), Q_ZERO);
+    CU_ASSERT_EQUAL(q_sqrt(INT_TO_Q(4)), INT_TO_Q(2));
+    CU_ASSERT_EQUAL(q_sqrt(Q_RAW_MAX), q_sqrt(Q_RAW_MAX - 1));
+}
+
+// MARK: - Reciprocal Square Root Q format
+void test_q_rsqrt()
+{
+    float range = end_sqrt - start_sqrt;
+    float step = range / (N_sqrt - 1);
+
+    for (size_t i = 1; i < N_sqrt; i++){
+        float x = start_sqrt + i * step;
+        q_t a = float_to_q(x);
+        q_t b = q_rsqrt(a);
+
+        // Within one unit of the last place of 1 / sqrt(a) for the rounded a
+        CU_ASSERT_DOUBLE_EQUAL(1.0 / sqrt(q_to_float(a)), q_to_float(b), 1.0 / (1 << FRACTIONAL_BITS));
+    }
+
+    // Small numbers have large reciprocal square roots
+    for (q_t a = 1; a < 256; a++){
+        CU_ASSERT_DOUBLE_EQUAL(1.0 / sqrt(q_to_float(a)), q_to_float(q_rsqrt(a)), 1.0 / (1 << FRACTIONAL_BITS));
+    }
+    CU_ASSERT_EQUAL(q_rsqrt(Q_ONE), Q_ONE);
+    CU_ASSERT_EQUAL(q_rsqrt(INT_TO_Q(4)), Q_ONE_HALF);
+}
+
+/**
+ * @brief Random raw value of the whole q_t range
+ */
+static q_t test_q_rand_raw()
+{
+    return (q_t) (((uint32_t) rand() << 16) ^ (uint32_t) rand());
+}
+
+void test_q_reciprocal()
+{
+    srand((uint32_t) time(NULL));
+
+    // Same as q_division(Q_ONE, a) when 1 / a is in the Q range, saturated otherwise
+    for (size_t i = 0; i < 100000; i++){
+        q_t a = test_q_rand_raw();
+        if (a == Q_ZERO){
+            continue;
+        }
+
+        const q_acc_t exact = ((q_acc_t) 1 << (2 * FRACTIONAL_BITS)) / a;
+        CU_ASSERT_EQUAL(q_reciprocal(a), q_saturate(exact));
+    }
+
+    for (q_t a = 1; a < 256; a++){
+        CU_ASSERT_EQUAL(q_reciprocal(a), q_saturate(((q_acc_t) 1 << (2 * FRACTIONAL_BITS)) / a));
+        CU_ASSERT_EQUAL(q_reciprocal(-a), q_saturate(-((q_acc_t) 1 << (2 * FRACTIONAL_BITS)) / a));
+    }
+    CU_ASSERT_EQUAL(q_reciprocal(Q_RAW_MAX), q_division(Q_ONE, Q_RAW_MAX));
+    CU_ASSERT_EQUAL(q_reciprocal(Q_RAW_MIN), q_saturate(((q_acc_t) 1 << (2 * FRACTIONAL_BITS)) / Q_RAW_MIN));
+    CU_ASSERT_EQUAL(q_reciprocal(1), Q_RAW_MAX);
+    CU_ASSERT_EQUAL(q_reciprocal(-1), Q_RAW_MIN);
+}
+
+void test_q_division_prepared()
+{
+    srand((uint32_t) time(NULL));
+
+    // Bit exact with q_division for every numerator, the divisors cover every magnitude and both signs
+    const q_t divisors[] = {1, -1, 2, 3, 7, Q_ONE, -Q_ONE, Q_ONE + 1, Q_RAW_MAX, Q_RAW_MIN, Q_RAW_MIN + 1};
+    for (size_t i = 0; i < 2000; i++){
+        const q_t d = (i < sizeof(divisors) / sizeof(divisors[0])) ? divisors[i] : (test_q_rand_raw() >> (i % Q_FORM_INT_BITS));
+        if (d == Q_ZERO){
+            continue;
+        }
+
+        const q_divisor_t prepared = q_divisor_prepare(d);
+        const q_t numerators[] = {Q_ZERO, 1, -1, Q_ONE, -Q_ONE, Q_RAW_MAX, Q_RAW_MIN, d, (q_t) (d >> 1)};
+        for (size_t j = 0; j < sizeof(numerators) / sizeof(numerators[0]); j++){
+            CU_ASSERT_EQUAL(q_division_prepared(numerators[j], prepared), q_division(numerators[j], d));
+        }
+        for (size_t j = 0; j < 100; j++){
+            const q_t a = test_q_rand_raw() >> (j % Q_FORM_INT_BITS);
+            CU_ASSERT_EQUAL(q_division_prepared(a, prepared), q_division(a, d));
+        }
+    }
 }
 
 // MARK: Test Trigonometric Functions
@@ -219,6 +324,42 @@ void test_q_cos(){
 
 }
 
+// MARK: - Sine and cosine Q format
+void test_q_sincos(){
+    // One range reduction for both, the same results as q_sin and q_cos, within about one unit of the exact values of the
+    // rounded angle (the table interpolation and the reduction stay below the resolution)
+    const double tolerance = 1.0 / (1 << FRACTIONAL_BITS);
+
+    for (int32_t i = -(1 << 14); i <= (1 << 14); i++){
+        const q_t a = (q_t) (i * 257); // Several turns in both directions
+        q_t s, c;
+        q_sincos(a, &s, &c);
+
+        CU_ASSERT_EQUAL(s, q_sin(a));
+        CU_ASSERT_EQUAL(c, q_cos(a));
+        CU_ASSERT_DOUBLE_EQUAL(sin(q_to_float(a)), q_to_float(s), tolerance);
+        CU_ASSERT_DOUBLE_EQUAL(cos(q_to_float(a)), q_to_float(c), tolerance);
+    }
+
+    // Large angles lose no precision in the reduction
+    for (q_t a = Q_RAW_MAX; a > Q_RAW_MAX - 1000; a--){
+        CU_ASSERT_DOUBLE_EQUAL(sin((double) a / (1 << FRACTIONAL_BITS)), q_to_float(q_sin(a)), tolerance);
+        CU_ASSERT_DOUBLE_EQUAL(cos((double) a / (1 << FRACTIONAL_BITS)), q_to_float(q_cos(a)), tolerance);
+    }
+
+    CU_ASSERT_EQUAL(q_sin(Q_ZERO), Q_ZERO);
+    CU_ASSERT_EQUAL(q_cos(Q_ZERO), Q_ONE);
+    CU_ASSERT_EQUAL(q_sin(Q_HALF_PI), Q_ONE);
+    CU_ASSERT_EQUAL(q_sin(Q_NEG_HALF_PI), Q_MINUS_ONE);
+    CU_ASSERT_EQUAL(q_cos(Q_PI), Q_MINUS_ONE);
+    CU_ASSERT_TRUE(q_absolute(q_sin(Q_PI)) <= 1);
+    CU_ASSERT_TRUE(q_absolute(q_cos(Q_HALF_PI)) <= 1);
+
+    // Saturated at the asymptotes instead of wrapping
+    CU_ASSERT_TRUE(q_tan(Q_HALF_PI) >= INT_TO_Q(10000) || q_tan(Q_HALF_PI) <= -INT_TO_Q(10000));
+    CU_ASSERT_DOUBLE_EQUAL(1.0, q_to_float(q_tan(Q_QUARTER_PI)), 2 * tolerance);
+}
+
 // MARK: - Error Calculation
 /**
  * @brief This function calculates the error between the measured value and the expected value
@@ -274,6 +415,18 @@ void add_general_math_tests(CU_pSuite suite)
     if (NULL == CU_add_test(suite, "Q_Sqrt", test_q_sqrt)) {
         return;
     }
+
+    if (NULL == CU_add_test(suite, "Q_Rsqrt", test_q_rsqrt)) {
+        return;
+    }
+
+    if (NULL == CU_add_test(suite, "Q_Reciprocal", test_q_reciprocal)) {
+        return;
+    }
+
+    if (NULL == CU_add_test(suite, "Q_Division_Prepared", test_q_division_prepared)) {
+        return;
+    }
 }
 
 void add_trigonometric_tests(CU_pSuite suite)
@@ -294,4 +447,8 @@ void add_trigonometric_tests(CU_pSuite suite)
         return;
     }
 
+    if (NULL == CU_add_test(suite, "Q_Sincos", test_q_sincos)) {
+        return;
+    }
+
 }
@@ -12,10 +12,14 @@ void testDivision();
 void testAbsolute();
 void testIntPower();
 void test_q_sqrt();
+void test_q_rsqrt();
+void test_q_reciprocal();
+void test_q_division_prepared();
 
 void test_q_sin();
 void test_q_cos();
 void test_q_tan();
+void test_q_sincos();
 void test_q_sec();
 void test_q_csc();
 void test_q_cot();
@@ -309,6 +309,353 @@ void test_q_matrix_inverse()
     }
 }
 
+void test_q_matrix_determinant()
+{
+    /* We are evaluating the determinant of matrices with known determinants. The sign of the row switches
+    performed by the PLU decomposition must be taken into account.
+
+    det(A) = det(P) * det(L) * det(U) = (-1)^s * prod(U[i][i])
+
+    Where s is the number of row switches performed during the decomposition.
+    */
+
+    // Cyclic permutation of the rows of a diagonal matrix (two row switches, positive sign)
+    q_matrix_t m = q_matrix_square_alloc(3);
+    Q_MATRIX_AT(&m, 0, 1) = INT_TO_Q(2);
+    Q_MATRIX_AT(&m, 1, 2) = INT_TO_Q(3);
+    Q_MATRIX_AT(&m, 2, 0) = INT_TO_Q(4);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_determinant(&m)), 24.0, 0.001);
+
+    // A single row switch of the same matrix (negative sign)
+    q_zeros(&m);
+    Q_MATRIX_AT(&m, 0, 1) = INT_TO_Q(2);
+    Q_MATRIX_AT(&m, 1, 0) = INT_TO_Q(3);
+    Q_MATRIX_AT(&m, 2, 2) = INT_TO_Q(4);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_determinant(&m)), -24.0, 0.001);
+    q_matrix_free(&m);
+
+    // Upper triangular matrices with a reversed row order
+    for(size_t i = 3; i < 8; i++)
+    {
+        q_matrix_t t = q_matrix_square_alloc(i);
+        double expected = 1.0;
+
+        for(size_t k = 0; k < i; k++)
+        {
+            for(size_t l = k; l < i; l++)
+            {
+                Q_MATRIX_AT(&t, i - 1 - k, l) = (k == l) ? INT_TO_Q((k % 2) + 1) : float_to_q(0.25f);
+            }
+            expected *= (double) ((k % 2) + 1);
+        }
+
+        // Reversing the order of the rows is a product of floor(n / 2) row switches
+        expected *= ((i / 2) % 2) ? -1.0 : 1.0;
+
+        CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_determinant(&t)), expected, 0.01);
+        q_matrix_free(&t);
+    }
+}
+
+void test_q_matrix_views()
+{
+    /* The views share the buffer of the parent matrix. We are checking that the writes through a view land in the
+    parent and that the kernels give the same results on views (stride != cols) as on contiguous copies.
+    */
+
+    q_matrix_t m = q_matrix_alloc(7, 9);
+    q_matrix_fill_rand_float(&m, -4.0f, 4.0f);
+
+    // Row, column and block views alias the parent
+    q_matrix_t row = q_matrix_view_row(&m, 3);
+    q_matrix_t col = q_matrix_view_col(&m, 5);
+    CU_ASSERT_EQUAL(row.rows, 1);
+    CU_ASSERT_EQUAL(row.cols, 9);
+    CU_ASSERT_EQUAL(col.rows, 7);
+    CU_ASSERT_EQUAL(col.cols, 1);
+    CU_ASSERT_PTR_EQUAL(&Q_MATRIX_AT(&col, 2, 0), &Q_MATRIX_AT(&m, 2, 5));
+
+    q_matrix_fill_float(&col, 2.5f);
+    for(size_t i = 0; i < m.rows; i++)
+    {
+        CU_ASSERT_EQUAL(Q_MATRIX_AT(&m, i, 5), float_to_q(2.5f));
+    }
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&row, 0, 5), float_to_q(2.5f));
+
+    // Every other row of a block (a view of a view)
+    q_matrix_t block = q_matrix_view(&m, 1, 2, 6, 4);
+    q_matrix_t strided = q_matrix_view_strided(&block, 1, 1, 3, 3, 2);
+    CU_ASSERT_PTR_EQUAL(&Q_MATRIX_AT(&strided, 2, 1), &Q_MATRIX_AT(&m, 6, 4));
+
+    // The kernels honor the stride of the views
+    q_matrix_t a = q_matrix_view(&m, 0, 0, 4, 4);
+    q_matrix_t b = q_matrix_view(&m, 3, 5, 4, 4);
+    q_matrix_t a_copy = q_matrix_square_alloc(4);
+    q_matrix_t b_copy = q_matrix_square_alloc(4);
+    q_matrix_cpy(&a, &a_copy);
+    q_matrix_cpy(&b, &b_copy);
+
+    q_matrix_t expected = q_matrix_square_alloc(4);
+    q_matrix_t result = q_matrix_alloc(4, 8);
+    q_matrix_t result_view = q_matrix_view(&result, 0, 2, 4, 4);
+
+    q_matrix_sum(&a_copy, &b_copy, &expected);
+    q_matrix_sum(&a, &b, &result_view);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&expected, &result_view) == Q_MATRIX_OK);
+
+    q_matrix_dot_product(&a_copy, &b_copy, &expected);
+    q_matrix_dot_product(&a, &b, &result_view);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&expected, &result_view) == Q_MATRIX_OK);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&result, 0, 0), Q_ZERO); // The columns outside of the view are left untouched
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&result, 3, 7), Q_ZERO);
+
+    // The inverse solves each column in place
+    q_matrix_fill_rand_float(&b_copy, -10.0f, 10.0f);
+    q_matrix_inverse(&b_copy, &expected);
+    q_matrix_inverse(&b_copy, &result_view);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&expected, &result_view) == Q_MATRIX_OK);
+
+    q_matrix_free(&result);
+    q_matrix_free(&expected);
+    q_matrix_free(&b_copy);
+    q_matrix_free(&a_copy);
+    q_matrix_free(&m);
+}
+
+void test_q_matrix_aligned()
+{
+    /* We are checking that the matrices with aligned and padded rows give the same results as the contiguous matrices,
+    in particular for the sizes that are not a multiple of the vector width.
+    */
+
+    const size_t sizes[] = {1, 3, 16, 17, 33};
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const size_t n = sizes[s];
+        q_matrix_t a = q_matrix_square_alloc(n);
+        q_matrix_t b = q_matrix_square_alloc(n);
+        q_matrix_t c = q_matrix_square_alloc(n);
+        q_matrix_t a_aligned = q_matrix_square_alloc_aligned(n);
+        q_matrix_t b_aligned = q_matrix_square_alloc_aligned(n);
+        q_matrix_t c_aligned = q_matrix_square_alloc_aligned(n);
+
+        CU_ASSERT_TRUE(a_aligned.stride >= n);
+        CU_ASSERT_EQUAL((a_aligned.stride * sizeof(q_t)) % Q_MATRIX_ALIGNMENT, 0);
+        for(size_t i = 0; i < n; i++)
+        {
+            CU_ASSERT_EQUAL((uintptr_t) &Q_MATRIX_AT(&a_aligned, i, 0) % Q_MATRIX_ALIGNMENT, 0);
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&a_aligned, i, n - 1), Q_ZERO); // Zero initialized
+        }
+
+        q_matrix_fill_rand_float(&a, -4.0f, 4.0f);
+        q_matrix_fill_rand_float(&b, -4.0f, 4.0f);
+        q_matrix_cpy(&a, &a_aligned);
+        q_matrix_cpy(&b, &b_aligned);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&a, &a_aligned) == Q_MATRIX_OK);
+
+        q_matrix_sum(&a, &b, &c);
+        q_matrix_sum(&a_aligned, &b_aligned, &c_aligned);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &c_aligned) == Q_MATRIX_OK);
+
+        q_matrix_elementwise_mul(&a, &b, &c);
+        q_matrix_elementwise_mul(&a_aligned, &b_aligned, &c_aligned);
+        q_matrix_scalar_mul_float(&c, 0.5f);
+        q_matrix_scalar_mul_float(&c_aligned, 0.5f);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &c_aligned) == Q_MATRIX_OK);
+
+        q_matrix_dot_product(&a, &b, &c);
+        q_matrix_dot_product(&a_aligned, &b_aligned, &c_aligned);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &c_aligned) == Q_MATRIX_OK);
+
+        q_matrix_transpose(&a, &c);
+        q_matrix_transpose(&a_aligned, &c_aligned);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &c_aligned) == Q_MATRIX_OK);
+
+        q_matrix_inverse(&a, &c);
+        q_matrix_inverse(&a_aligned, &c_aligned);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &c_aligned) == Q_MATRIX_OK);
+
+        CU_ASSERT_EQUAL(q_matrix_determinant(&a), q_matrix_determinant(&a_aligned));
+        CU_ASSERT_EQUAL(q_matrix_trace(&a), q_matrix_trace(&a_aligned));
+        CU_ASSERT_EQUAL(q_matrix_sum_contents(&a), q_matrix_sum_contents(&a_aligned));
+        CU_ASSERT_EQUAL(q_matrix_1_norm(&a), q_matrix_1_norm(&a_aligned));
+        CU_ASSERT_EQUAL(q_matrix_infinity_norm(&a), q_matrix_infinity_norm(&a_aligned));
+        CU_ASSERT_EQUAL(q_matrix_euclidean_norm(&a), q_matrix_euclidean_norm(&a_aligned));
+
+        q_matrix_identity(&c);
+        q_matrix_identity(&c_aligned);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&c, &c_aligned) == Q_MATRIX_OK);
+
+        q_matrix_free(&a);
+        q_matrix_free(&b);
+        q_matrix_free(&c);
+        q_matrix_free(&a_aligned);
+        q_matrix_free(&b_aligned);
+        q_matrix_free(&c_aligned);
+    }
+}
+
+void test_q_matrix_triangular_solve()
+{
+    /* Solving k right-hand sides in one call must give exactly the solutions of the k single column solves, also when
+    the columns span several blocks of the solver and when the solution overwrites the right-hand sides.
+    */
+
+    const size_t shapes[][2] = {{1, 1}, {5, 3}, {12, 1}, {17, 64}, {9, 70}, {24, 130}};
+
+    for(size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        const size_t n = shapes[s][0], k = shapes[s][1];
+        q_matrix_t m = q_matrix_square_alloc(n);
+        q_matrix_t P = q_matrix_square_alloc(n);
+        q_matrix_t L = q_matrix_square_alloc(n);
+        q_matrix_t U = q_matrix_square_alloc(n);
+        q_matrix_t B = q_matrix_alloc(n, k);
+        q_matrix_t Y = q_matrix_alloc(n, k);
+        q_matrix_t X = q_matrix_alloc(n, k);
+        q_matrix_t y = q_matrix_alloc(n, 1);
+        q_matrix_t x = q_matrix_alloc(n, 1);
+
+        q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+        for(size_t i = 0; i < n; i++)
+        {
+            Q_MATRIX_AT(&m, i, i) += INT_TO_Q(n);
+        }
+        q_matrix_fill_rand_float(&B, -4.0f, 4.0f);
+        q_matrix_PLU_decomposition(&m, &P, &L, &U);
+
+        q_matrix_forward_substitution(&L, &B, &Y);
+        q_matrix_back_substitution(&U, &Y, &X);
+
+        for(size_t c = 0; c < k; c++)
+        {
+            q_matrix_t b = q_matrix_view_col(&B, c);
+            q_matrix_forward_substitution(&L, &b, &y);
+            q_matrix_back_substitution(&U, &y, &x);
+
+            for(size_t i = 0; i < n; i++)
+            {
+                CU_ASSERT_EQUAL(Q_MATRIX_AT(&Y, i, c), Q_MATRIX_AT(&y, i, 0));
+                CU_ASSERT_EQUAL(Q_MATRIX_AT(&X, i, c), Q_MATRIX_AT(&x, i, 0));
+            }
+        }
+
+        // The solutions of A * X = B, with and without the permutation, in place
+        q_matrix_LUP_solve(&L, &U, &P, &B, &Y);
+        q_matrix_dot_product(&m, &Y, &X);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&X, &B, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_cpy(&B, &X);
+        q_matrix_forward_substitution(&L, &X, &X);
+        q_matrix_back_substitution(&U, &X, &X);
+        q_matrix_LU_solve(&L, &U, &B, &B);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&X, &B) == Q_MATRIX_OK);
+
+        // The transpose variants read the lower triangle by columns, they must match the solves with the transposed matrix
+        q_matrix_t Lt = q_matrix_square_alloc(n);
+        q_matrix_transpose(&L, &Lt);
+        q_matrix_triangular_solve(&Lt, &B, &X, Q_TRIANGLE_UPPER);
+        q_matrix_triangular_solve(&L, &B, &Y, Q_TRIANGLE_LOWER_TRANSPOSE);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&X, &Y) == Q_MATRIX_OK);
+        q_matrix_triangular_solve(&Lt, &B, &X, Q_TRIANGLE_UNIT_UPPER);
+        q_matrix_triangular_solve(&L, &B, &Y, Q_TRIANGLE_UNIT_LOWER_TRANSPOSE);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&X, &Y) == Q_MATRIX_OK);
+        q_matrix_free(&Lt);
+
+        q_matrix_free(&m);
+        q_matrix_free(&P);
+        q_matrix_free(&L);
+        q_matrix_free(&U);
+        q_matrix_free(&B);
+        q_matrix_free(&Y);
+        q_matrix_free(&X);
+        q_matrix_free(&y);
+        q_matrix_free(&x);
+    }
+}
+
+void test_q_matrix_power()
+{
+    /* A^k by repeated squaring must match k - 1 successive products up to the rounding of the products, also in place. The
+    elements are small so the powers stay in the Q range.
+    */
+
+    const size_t n = 6;
+    q_matrix_t m = q_matrix_square_alloc(n);
+    q_matrix_t power = q_matrix_square_alloc(n);
+    q_matrix_t expected = q_matrix_square_alloc(n);
+    q_matrix_t tmp = q_matrix_square_alloc(n);
+    q_matrix_t identity = q_matrix_square_alloc(n);
+    q_matrix_fill_rand_float(&m, -0.3f, 0.3f);
+    q_matrix_identity(&identity);
+
+    q_matrix_power(&m, 0, &power);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&power, &identity) == Q_MATRIX_OK);
+
+    q_matrix_power(&m, 1, &power);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&power, &m) == Q_MATRIX_OK);
+
+    q_matrix_cpy(&m, &expected);
+    for(uint32_t k = 2; k <= 13; k++)
+    {
+        q_matrix_dot_product(&expected, &m, &tmp);
+        q_matrix_cpy(&tmp, &expected);
+
+        q_matrix_power(&m, k, &power);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&power, &expected, 0.001f) == Q_MATRIX_OK);
+    }
+
+    // In place, A^13 again
+    q_matrix_cpy(&m, &tmp);
+    q_matrix_power(&tmp, 13, &tmp);
+    CU_ASSERT_TRUE(q_matrix_is_equal(&tmp, &power) == Q_MATRIX_OK);
+
+    // The powers of a rotation by pi / 8 in a 2 x 2 block, eight steps are a half turn
+    q_matrix_t r = q_matrix_square_alloc(2);
+    q_matrix_t r8 = q_matrix_square_alloc(2);
+    const float angle = 3.14159265358979323846f / 8;
+    Q_MATRIX_AT(&r, 0, 0) = float_to_q(cosf(angle));
+    Q_MATRIX_AT(&r, 0, 1) = float_to_q(-sinf(angle));
+    Q_MATRIX_AT(&r, 1, 0) = float_to_q(sinf(angle));
+    Q_MATRIX_AT(&r, 1, 1) = float_to_q(cosf(angle));
+    q_matrix_power(&r, 8, &r8);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&r8, 0, 0)), -1.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&r8, 0, 1)), 0.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&r8, 1, 0)), 0.0, 0.001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&r8, 1, 1)), -1.0, 0.001);
+
+    q_matrix_free(&m);
+    q_matrix_free(&power);
+    q_matrix_free(&expected);
+    q_matrix_free(&tmp);
+    q_matrix_free(&identity);
+    q_matrix_free(&r);
+    q_matrix_free(&r8);
+}
+
+void test_q_matrix_euclidean_norm()
+{
+    // The squares are summed without rounding, small elements still count and large ones do not overflow
+    q_matrix_t m = q_matrix_alloc(3, 4);
+    q_matrix_fill_rand_float(&m, -50.0f, 50.0f);
+
+    double squares = 0.0;
+    for(size_t i = 0; i < m.rows; i++)
+    {
+        for(size_t j = 0; j < m.cols; j++)
+        {
+            squares += (double) q_to_float(Q_MATRIX_AT(&m, i, j)) * q_to_float(Q_MATRIX_AT(&m, i, j));
+        }
+    }
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q_matrix_euclidean_norm(&m)), sqrt(squares), 1.0 / (1 << FRACTIONAL_BITS));
+
+    q_matrix_fill(&m, 1); // The square of one raw unit is below the resolution of q_t
+    CU_ASSERT_EQUAL(q_matrix_euclidean_norm(&m), q_sqrt_acc(12));
+
+    q_matrix_free(&m);
+}
+
 void add_matrix_tests(CU_pSuite suite)
 {
     if (NULL == suite) {
@@ -335,4 +682,28 @@ void add_matrix_tests(CU_pSuite suite)
         return;
     }
 
+    if(NULL == CU_add_test(suite, "test_q_matrix_determinant", test_q_matrix_determinant)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_views", test_q_matrix_views)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_aligned", test_q_matrix_aligned)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_triangular_solve", test_q_matrix_triangular_solve)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_power", test_q_matrix_power)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_matrix_euclidean_norm", test_q_matrix_euclidean_norm)) {
+        return;
+    }
+
 }
@@ -1,6 +1,7 @@
 #ifndef TEST_Q_MATRIX_H
 #define TEST_Q_MATRIX_H
 #include "CUnit/Basic.h"
+#include <math.h>
 #include "../include/fix_point_matrix.h"
 //TODO: Implement the tests for the matrix of fixed point numbers
 
@@ -9,6 +10,12 @@ void test_q_fill();
 void test_q_matrix_LU_decomposition();
 void test_q_matrix_PLU_decomposition();
 void test_q_matrix_inverse();
+void test_q_matrix_determinant();
+void test_q_matrix_views();
+void test_q_matrix_aligned();
+void test_q_matrix_triangular_solve();
+void test_q_matrix_power();
+void test_q_matrix_euclidean_norm();
 
 void add_matrix_tests(CU_pSuite suite);
 
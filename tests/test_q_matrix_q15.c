@@ -0,0 +1,175 @@
+#include "test_q_matrix_q15.h"
+
+#define N_Q15 37
+
+void test_q15_matrix_conversion()
+{
+    q_matrix_t m = q_matrix_alloc(N_Q15, N_Q15);
+    q_matrix_t back = q_matrix_alloc(N_Q15, N_Q15);
+    q15_matrix_t m15 = q15_matrix_alloc(N_Q15, N_Q15);
+
+    q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+    Q_MATRIX_AT(&m, 0, 0) = INT_TO_Q(2);   // Saturated to the Q15 range
+    Q_MATRIX_AT(&m, 0, 1) = -INT_TO_Q(2);
+
+    q15_matrix_from_q(&m, &m15);
+    q15_matrix_to_q(&m15, &back);
+
+    CU_ASSERT_EQUAL(Q15_MATRIX_AT(&m15, 0, 0), q15_MAX);
+    CU_ASSERT_EQUAL(Q15_MATRIX_AT(&m15, 0, 1), q15_MIN);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&back, 0, 1), Q_MINUS_ONE);
+
+    Q_MATRIX_AT(&m, 0, 0) = Q_MATRIX_AT(&back, 0, 0);
+    Q_MATRIX_AT(&m, 0, 1) = Q_MATRIX_AT(&back, 0, 1);
+    CU_ASSERT_EQUAL(q_matrix_is_approx(&m, &back, Q_EPSILON), Q_MATRIX_OK); // Q16.16 -> Q15 -> Q16.16 loses at most one bit
+
+    q_matrix_free(&m);
+    q_matrix_free(&back);
+    q15_matrix_free(&m15);
+}
+
+void test_q15_matrix_dot_product()
+{
+    q15_matrix_t a = q15_matrix_alloc(N_Q15, N_Q15 + 3);
+    q15_matrix_t b = q15_matrix_alloc(N_Q15 + 3, N_Q15 - 2);
+    q15_matrix_t c = q15_matrix_alloc(N_Q15, N_Q15 - 2);
+
+    // Small values so the result stays inside the Q15 range
+    for(size_t i = 0; i < a.rows; i++)
+        for(size_t j = 0; j < a.cols; j++)
+            Q15_MATRIX_AT(&a, i, j) = (q15_t) ((rand() % 2001) - 1000);
+    for(size_t i = 0; i < b.rows; i++)
+        for(size_t j = 0; j < b.cols; j++)
+            Q15_MATRIX_AT(&b, i, j) = (q15_t) ((rand() % 2001) - 1000);
+
+    q15_matrix_dot_product(&a, &b, &c);
+
+    for(size_t i = 0; i < c.rows; i++)
+    {
+        for(size_t j = 0; j < c.cols; j++)
+        {
+            int64_t expected = 0; // Exact sum of the Q30 products, rounded once
+            for(size_t k = 0; k < a.cols; k++)
+            {
+                expected += (int64_t) Q15_MATRIX_AT(&a, i, k) * Q15_MATRIX_AT(&b, k, j);
+            }
+            CU_ASSERT_EQUAL(Q15_MATRIX_AT(&c, i, j), q15_saturate((expected + (1 << 14)) >> 15));
+        }
+    }
+
+    // The accumulation does not overflow and the result saturates: every element is (-1) * (-1) * n
+    q15_matrix_t ones = q15_matrix_alloc(4, 4);
+    q15_matrix_t out = q15_matrix_alloc(4, 4);
+    for(size_t i = 0; i < 4; i++)
+        for(size_t j = 0; j < 4; j++)
+            Q15_MATRIX_AT(&ones, i, j) = q15_MIN;
+    q15_matrix_dot_product(&ones, &ones, &out);
+    CU_ASSERT_EQUAL(Q15_MATRIX_AT(&out, 2, 3), q15_MAX);
+
+    q15_matrix_free(&a);
+    q15_matrix_free(&b);
+    q15_matrix_free(&c);
+    q15_matrix_free(&ones);
+    q15_matrix_free(&out);
+}
+
+void test_q15_matrix_solve()
+{
+    /* A lower triangular L and upper triangular U stored in Q15 solve L * U * x = b, the vectors use the active format. */
+    const size_t n = 8;
+    q15_matrix_t L = q15_matrix_square_alloc(n);
+    q15_matrix_t U = q15_matrix_square_alloc(n);
+    q_matrix_t x = q_matrix_alloc(n, 1);
+    q_matrix_t y = q_matrix_alloc(n, 1);
+    q_matrix_t b = q_matrix_alloc(n, 1);
+    q_matrix_t Y = q_matrix_alloc(n, 1);
+    q_matrix_t X = q_matrix_alloc(n, 1);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            const q15_t v = q15_from_float(((float) ((i * 7 + j * 3) % 11) - 5.0f) / 80.0f);
+            Q15_MATRIX_AT(&L, i, j) = (j < i) ? v : ((j == i) ? q15_from_float(0.75f) : 0);
+            Q15_MATRIX_AT(&U, i, j) = (j > i) ? v : ((j == i) ? q15_from_float(-0.5f) : 0);
+        }
+        Q_MATRIX_AT(&x, i, 0) = float_to_q((float) i - 3.5f);
+    }
+
+    q15_matrix_vector_product(&U, &x, &y);
+    q15_matrix_vector_product(&L, &y, &b);
+
+    q15_matrix_forward_substitution(&L, &b, &Y);
+    q15_matrix_back_substitution(&U, &Y, &X);
+
+    CU_ASSERT_EQUAL(q_matrix_is_approx(&Y, &y, float_to_q(0.001f)), Q_MATRIX_OK);
+    CU_ASSERT_EQUAL(q_matrix_is_approx(&X, &x, float_to_q(0.001f)), Q_MATRIX_OK);
+
+    q15_matrix_free(&L);
+    q15_matrix_free(&U);
+    q_matrix_free(&x);
+    q_matrix_free(&y);
+    q_matrix_free(&b);
+    q_matrix_free(&Y);
+    q_matrix_free(&X);
+}
+
+void test_q15_matrix_reductions()
+{
+    q15_matrix_t m = q15_matrix_square_alloc(N_Q15);
+    double trace = 0.0, sum = 0.0, squares = 0.0, norm = 0.0;
+
+    for(size_t i = 0; i < N_Q15; i++)
+    {
+        double row = 0.0;
+        for(size_t j = 0; j < N_Q15; j++)
+        {
+            Q15_MATRIX_AT(&m, i, j) = (q15_t) (rand() - RAND_MAX / 2);
+            const double v = q15_to_float(Q15_MATRIX_AT(&m, i, j));
+            sum += v;
+            squares += v * v;
+            row += fabs(v);
+            trace += (i == j) ? v : 0.0;
+        }
+        norm = (row > norm) ? row : norm;
+    }
+
+    // The results are exact in 64 bits and rounded once to the active format
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q15_matrix_trace(&m)), trace, 1.0 / (1 << FRACTIONAL_BITS));
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q15_matrix_sum_contents(&m)), sum, 1.0 / (1 << FRACTIONAL_BITS));
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q15_matrix_infinity_norm(&m)), norm, 1.0 / (1 << FRACTIONAL_BITS));
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q15_matrix_euclidean_norm(&m)), sqrt(squares), 0.01);
+
+    // The sum of the squares (about 65000) exceeds the range of q_t but the norm does not
+    q15_matrix_t big = q15_matrix_square_alloc(256);
+    for(size_t i = 0; i < 256; i++)
+        for(size_t j = 0; j < 256; j++)
+            Q15_MATRIX_AT(&big, i, j) = q15_MAX;
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(q15_matrix_euclidean_norm(&big)), 256.0 * q15_to_float(q15_MAX), 0.001);
+
+    q15_matrix_free(&big);
+    q15_matrix_free(&m);
+}
+
+void add_matrix_q15_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q15_matrix_conversion", test_q15_matrix_conversion)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q15_matrix_dot_product", test_q15_matrix_dot_product)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q15_matrix_solve", test_q15_matrix_solve)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q15_matrix_reductions", test_q15_matrix_reductions)) {
+        return;
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef TEST_Q_MATRIX_Q15_H
+#define TEST_Q_MATRIX_Q15_H
+#include <math.h>
+#include "CUnit/Basic.h"
+#include "../include/fix_point_matrix_q15.h"
+
+void test_q15_matrix_conversion();
+void test_q15_matrix_dot_product();
+void test_q15_matrix_solve();
+void test_q15_matrix_reductions();
+
+void add_matrix_q15_tests(CU_pSuite suite);
+
+#endif // TEST_Q_MATRIX_Q15_H
@@ -0,0 +1,153 @@
+#include "test_q_matrix_q7.h"
+
+static void fill_rand_q7(q7_matrix_t* m)
+{
+    for(size_t i = 0; i < m->rows; i++)
+        for(size_t j = 0; j < m->cols; j++)
+            Q7_MATRIX_AT(m, i, j) = (q7_t) ((rand() % 256) - 128);
+}
+
+/**
+ * @brief Reference quantized product with 64 bits accumulators and the requantization formula of q7_gemm
+ */
+static void reference_q7_gemm(const q7_matrix_t* a, const q7_matrix_t* b, const int32_t* bias, q7_requant_t r, q7_matrix_t* dst)
+{
+    for(size_t i = 0; i < a->rows; i++)
+    {
+        for(size_t j = 0; j < b->cols; j++)
+        {
+            int64_t acc = (bias != NULL) ? bias[j] : 0;
+            for(size_t p = 0; p < a->cols; p++)
+            {
+                acc += (int64_t) Q7_MATRIX_AT(a, i, p) * Q7_MATRIX_AT(b, p, j);
+            }
+            Q7_MATRIX_AT(dst, i, j) = q7_saturate((acc * r.multiplier + ((int64_t) 1 << (r.shift - 1))) >> r.shift);
+        }
+    }
+}
+
+void test_q7_matrix_conversion()
+{
+    q_matrix_t m = q_matrix_alloc(5, 7);
+    q_matrix_t back = q_matrix_alloc(5, 7);
+    q7_matrix_t m7 = q7_matrix_alloc(5, 7);
+
+    q_matrix_fill_rand_float(&m, -1.0f, 1.0f);
+    Q_MATRIX_AT(&m, 4, 6) = INT_TO_Q(3);
+
+    q7_matrix_from_q(&m, &m7);
+    q7_matrix_to_q(&m7, &back);
+
+    CU_ASSERT_EQUAL(Q7_MATRIX_AT(&m7, 4, 6), q7_MAX);
+    Q_MATRIX_AT(&m, 4, 6) = Q_MATRIX_AT(&back, 4, 6);
+    CU_ASSERT_EQUAL(q_matrix_is_approx(&m, &back, float_to_q(1.0f / 128.0f)), Q_MATRIX_OK);
+
+    q_matrix_free(&m);
+    q_matrix_free(&back);
+    q7_matrix_free(&m7);
+}
+
+void test_q7_gemm_reference()
+{
+    /* Plain Q7 product: x * y / 128 rounded to nearest */
+    q7_matrix_t a = q7_matrix_alloc(1, 1), b = q7_matrix_alloc(1, 1), c = q7_matrix_alloc(1, 1);
+    Q7_MATRIX_AT(&a, 0, 0) = q7_from_float(0.5f);
+    Q7_MATRIX_AT(&b, 0, 0) = q7_from_float(-0.25f);
+    q7_matrix_dot_product(&a, &b, &c);
+    CU_ASSERT_EQUAL(Q7_MATRIX_AT(&c, 0, 0), q7_from_float(-0.125f));
+
+    Q7_MATRIX_AT(&a, 0, 0) = q7_MIN;
+    Q7_MATRIX_AT(&b, 0, 0) = q7_MIN;
+    q7_matrix_dot_product(&a, &b, &c);
+    CU_ASSERT_EQUAL(Q7_MATRIX_AT(&c, 0, 0), q7_MAX); // (-1) * (-1) saturates
+
+    q7_matrix_free(&a);
+    q7_matrix_free(&b);
+    q7_matrix_free(&c);
+}
+
+void test_q7_gemm_levels()
+{
+    /* Every kernel level must be bit-exact with the reference, for shapes that are not multiples of the tiles. */
+    const size_t shapes[][3] = {{1, 1, 1}, {3, 5, 7}, {4, 8, 8}, {17, 33, 9}, {32, 64, 48}, {5, 130, 3}};
+    const q7_gemm_level_t supported = q7_gemm_detect();
+
+    for(size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        const size_t m = shapes[s][0], k = shapes[s][1], n = shapes[s][2];
+        q7_matrix_t a = q7_matrix_alloc(m, k), b = q7_matrix_alloc(k, n);
+        q7_matrix_t expected = q7_matrix_alloc(m, n), result = q7_matrix_alloc(m, n);
+        int32_t* bias = (int32_t*) malloc(n * sizeof(int32_t));
+        fill_rand_q7(&a);
+        fill_rand_q7(&b);
+        Q7_MATRIX_AT(&a, 0, 0) = q7_MIN;
+        Q7_MATRIX_AT(&b, 0, 0) = q7_MIN;
+        for(size_t j = 0; j < n; j++)
+        {
+            bias[j] = (rand() % 20001) - 10000;
+        }
+
+        const q7_requant_t r = q7_requant_from_float(1.0f / (float) k);
+        reference_q7_gemm(&a, &b, bias, r, &expected);
+
+        for(int level = Q7_GEMM_SCALAR; level <= (int) supported; level++)
+        {
+            CU_ASSERT_EQUAL(q7_gemm_set_level((q7_gemm_level_t) level), (q7_gemm_level_t) level);
+            memset(result.elements, 0x55, m * n);
+            q7_gemm(&a, &b, bias, r, &result);
+            CU_ASSERT_TRUE(memcmp(expected.elements, result.elements, m * n) == 0);
+
+            q7_gemm(&a, &b, NULL, Q7_REQUANT_IDENTITY, &result); // Saturates heavily for large k
+            reference_q7_gemm(&a, &b, NULL, Q7_REQUANT_IDENTITY, &expected);
+            CU_ASSERT_TRUE(memcmp(expected.elements, result.elements, m * n) == 0);
+            reference_q7_gemm(&a, &b, bias, r, &expected);
+        }
+
+        q7_matrix_free(&a);
+        q7_matrix_free(&b);
+        q7_matrix_free(&expected);
+        q7_matrix_free(&result);
+        free(bias);
+    }
+
+    q7_gemm_set_level(supported);
+}
+
+void test_q7_requant()
+{
+    const float scales[] = {1.0f, 0.5f, 0.125f, 0.3f, 1.7f, 1e-3f};
+
+    for(size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++)
+    {
+        const q7_requant_t r = q7_requant_from_float(scales[s]);
+        CU_ASSERT_TRUE(r.multiplier >= (1 << 30));
+        CU_ASSERT_DOUBLE_EQUAL((double) r.multiplier / ldexp(1.0, r.shift), scales[s] / 128.0, scales[s] * 1e-8);
+    }
+
+    const q7_requant_t identity = q7_requant_from_float(1.0f);
+    CU_ASSERT_EQUAL(identity.multiplier, Q7_REQUANT_IDENTITY.multiplier);
+    CU_ASSERT_EQUAL(identity.shift, Q7_REQUANT_IDENTITY.shift);
+}
+
+void add_matrix_q7_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q7_matrix_conversion", test_q7_matrix_conversion)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q7_gemm_reference", test_q7_gemm_reference)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q7_gemm_levels", test_q7_gemm_levels)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q7_requant", test_q7_requant)) {
+        return;
+    }
+}
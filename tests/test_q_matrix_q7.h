@@ -0,0 +1,14 @@
+#ifndef TEST_Q_MATRIX_Q7_H
+#define TEST_Q_MATRIX_Q7_H
+#include <math.h>
+#include "CUnit/Basic.h"
+#include "../include/fix_point_matrix_q7.h"
+
+void test_q7_matrix_conversion();
+void test_q7_gemm_reference();
+void test_q7_gemm_levels();
+void test_q7_requant();
+
+void add_matrix_q7_tests(CU_pSuite suite);
+
+#endif // TEST_Q_MATRIX_Q7_H
@@ -0,0 +1,283 @@
+#include "test_q_qr.h"
+
+// Checks A = Q * R, Q^T * Q = I and R upper triangular
+static void check_factors(const q_matrix_t* m, const q_qr_t* qr, float tol)
+{
+    const size_t rows = m->rows, cols = m->cols;
+    q_matrix_t Q = q_matrix_alloc(rows, cols);
+    q_matrix_t Qt = q_matrix_alloc(cols, rows);
+    q_matrix_t R = q_matrix_square_alloc(cols);
+    q_matrix_t QR = q_matrix_alloc(rows, cols);
+    q_matrix_t QtQ = q_matrix_square_alloc(cols);
+    q_matrix_t I = q_matrix_square_alloc(cols);
+
+    q_qr_get_q(qr, &Q);
+    q_qr_get_r(qr, &R);
+    q_matrix_identity(&I);
+
+    q_matrix_dot_product(&Q, &R, &QR);
+    CU_ASSERT_TRUE(q_matrix_is_approx_float(&QR, m, tol) == Q_MATRIX_OK);
+
+    q_matrix_transpose(&Q, &Qt);
+    q_matrix_dot_product(&Qt, &Q, &QtQ);
+    CU_ASSERT_TRUE(q_matrix_is_approx_float(&QtQ, &I, tol) == Q_MATRIX_OK);
+
+    for(size_t i = 0; i < cols; i++)
+    {
+        for(size_t j = 0; j < i; j++)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&R, i, j), Q_ZERO);
+        }
+    }
+
+    q_matrix_free(&Q);
+    q_matrix_free(&Qt);
+    q_matrix_free(&R);
+    q_matrix_free(&QR);
+    q_matrix_free(&QtQ);
+    q_matrix_free(&I);
+}
+
+void test_q_qr_decompose()
+{
+    for(size_t n = 1; n < 16; n++)
+    {
+        for(size_t extra = 0; extra < 12; extra += 5)
+        {
+            const size_t m = n + extra;
+            q_matrix_t A = q_matrix_alloc(m, n);
+            q_qr_t qr = q_qr_alloc(m, n);
+            q_matrix_fill_rand_float(&A, -4.0f, 4.0f);
+
+            q_qr_decompose(&A, &qr);
+            check_factors(&A, &qr, 0.01f);
+
+            // The factorization can be computed in place
+            q_qr_t in_place = q_qr_alloc(m, n);
+            q_matrix_cpy(&A, &in_place.QR);
+            q_qr_decompose(&in_place.QR, &in_place);
+            CU_ASSERT_TRUE(q_matrix_is_equal(&in_place.QR, &qr.QR) == Q_MATRIX_OK);
+
+            q_qr_free(&in_place);
+            q_qr_free(&qr);
+            CU_ASSERT_PTR_NULL(qr.tau);
+            q_matrix_free(&A);
+        }
+    }
+
+    // A column that is already reduced gets the identity reflector
+    q_matrix_t A = q_matrix_alloc(3, 2);
+    q_qr_t qr = q_qr_alloc(3, 2);
+    Q_MATRIX_AT(&A, 0, 0) = INT_TO_Q(2);
+    Q_MATRIX_AT(&A, 1, 1) = INT_TO_Q(3);
+    Q_MATRIX_AT(&A, 2, 1) = INT_TO_Q(4);
+    q_qr_decompose(&A, &qr);
+    CU_ASSERT_EQUAL(qr.tau[0], Q_ZERO);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&qr.QR, 0, 0), INT_TO_Q(2));
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(Q_MATRIX_AT(&qr.QR, 1, 1)), -5.0, 0.0001); // -sign(alpha) * ||(3, 4)||
+    check_factors(&A, &qr, 0.001f);
+    q_qr_free(&qr);
+    q_matrix_free(&A);
+}
+
+void test_q_qr_decompose_blocked()
+{
+    /* The blocked factors must give back A for every panel width and number of threads, and be bit identical to the
+    unblocked reflections when there is a single panel.
+    */
+    const size_t shapes[][2] = {{7, 5}, {100, 40}, {300, 20}, {70, 70}};
+    const size_t blocks[] = {1, 8, 32, 200};
+    const size_t threads[] = {1, 4};
+
+    for(size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        const size_t m = shapes[s][0], n = shapes[s][1];
+        q_matrix_t A = q_matrix_alloc(m, n);
+        q_qr_t reference = q_qr_alloc(m, n);
+        q_qr_t qr = q_qr_alloc(m, n);
+        q_matrix_fill_rand_float(&A, -1.0f, 1.0f);
+
+        q_qr_decompose_blocked(&A, &reference, n, 1); // Unblocked
+
+        for(size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++)
+        {
+            for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+            {
+                q_qr_decompose_blocked(&A, &qr, blocks[b], threads[t]);
+                check_factors(&A, &qr, 0.01f);
+
+                if(blocks[b] >= n)
+                {
+                    CU_ASSERT_TRUE(q_matrix_is_equal(&qr.QR, &reference.QR) == Q_MATRIX_OK);
+                }
+                else
+                {
+                    CU_ASSERT_TRUE(q_matrix_is_approx_float(&qr.QR, &reference.QR, 0.01f) == Q_MATRIX_OK);
+                }
+            }
+        }
+
+        q_qr_free(&reference);
+        q_qr_free(&qr);
+        q_matrix_free(&A);
+    }
+}
+
+void test_q_qr_solve()
+{
+    for(size_t n = 1; n < 12; n++)
+    {
+        const size_t m = 3 * n + 2, k = 1 + n % 3;
+        q_matrix_t A = q_matrix_alloc(m, n);
+        q_matrix_t X = q_matrix_alloc(n, k);
+        q_matrix_t B = q_matrix_alloc(m, k);
+        q_matrix_t solution = q_matrix_alloc(n, k);
+        q_qr_t qr = q_qr_alloc(m, n);
+
+        q_matrix_fill_rand_float(&A, -2.0f, 2.0f);
+        q_matrix_fill_rand_float(&X, -2.0f, 2.0f);
+
+        // Consistent system, the least squares solution is the exact solution
+        q_matrix_dot_product(&A, &X, &B);
+        q_qr_decompose(&A, &qr);
+        q_qr_solve(&qr, &B, &solution);
+        CU_ASSERT_TRUE(q_matrix_is_approx_float(&solution, &X, 0.01f) == Q_MATRIX_OK);
+
+        q_matrix_least_squares(&A, &B, &X);
+        CU_ASSERT_TRUE(q_matrix_is_equal(&solution, &X) == Q_MATRIX_OK);
+
+        // Inconsistent system, the residual must be orthogonal to the columns of A: A^T * (b - A * x) = 0
+        q_matrix_fill_rand_float(&B, -2.0f, 2.0f);
+        q_qr_solve(&qr, &B, &solution);
+        for(size_t c = 0; c < k; c++)
+        {
+            for(size_t j = 0; j < n; j++)
+            {
+                double dot = 0.0;
+                for(size_t i = 0; i < m; i++)
+                {
+                    double residual = q_to_float(Q_MATRIX_AT(&B, i, c));
+                    for(size_t p = 0; p < n; p++)
+                    {
+                        residual -= q_to_float(Q_MATRIX_AT(&A, i, p)) * q_to_float(Q_MATRIX_AT(&solution, p, c));
+                    }
+                    dot += q_to_float(Q_MATRIX_AT(&A, i, j)) * residual;
+                }
+                CU_ASSERT_DOUBLE_EQUAL(dot, 0.0, 0.01);
+            }
+        }
+
+        q_qr_free(&qr);
+        q_matrix_free(&A);
+        q_matrix_free(&X);
+        q_matrix_free(&B);
+        q_matrix_free(&solution);
+    }
+}
+
+void test_q_givens()
+{
+    q_t c, s, r;
+
+    q_givens(INT_TO_Q(3), INT_TO_Q(4), &c, &s, &r);
+    CU_ASSERT_EQUAL(r, INT_TO_Q(5));
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(c), 0.6, 0.0001);
+    CU_ASSERT_DOUBLE_EQUAL(q_to_float(s), 0.8, 0.0001);
+
+    q_givens(-INT_TO_Q(2), Q_ZERO, &c, &s, &r);
+    CU_ASSERT_EQUAL(c, Q_ONE);
+    CU_ASSERT_EQUAL(s, Q_ZERO);
+    CU_ASSERT_EQUAL(r, -INT_TO_Q(2));
+
+    q_givens(Q_ZERO, -INT_TO_Q(7), &c, &s, &r);
+    CU_ASSERT_EQUAL(c, Q_ZERO);
+    CU_ASSERT_EQUAL(s, -Q_ONE);
+    CU_ASSERT_EQUAL(r, INT_TO_Q(7));
+
+    // The norm does not overflow when the squares exceed the Q range
+    q_givens(INT_TO_Q(300), INT_TO_Q(400), &c, &s, &r);
+    CU_ASSERT_EQUAL(r, INT_TO_Q(500));
+}
+
+void test_q_qr_givens_update()
+{
+    /* Adding the rows one at a time from R = 0 must give the least squares solution of the whole system, and R^T * R must
+    be A^T * A.
+    */
+    const size_t m = 40, n = 5, k = 2;
+    q_matrix_t A = q_matrix_alloc(m, n);
+    q_matrix_t B = q_matrix_alloc(m, k);
+    q_matrix_t R = q_matrix_square_alloc(n);
+    q_matrix_t R_only = q_matrix_square_alloc(n);
+    q_matrix_t z = q_matrix_alloc(n, k);
+    q_matrix_t x = q_matrix_alloc(n, k);
+    q_matrix_t reference = q_matrix_alloc(n, k);
+
+    q_matrix_fill_rand_float(&A, -1.0f, 1.0f);
+    q_matrix_fill_rand_float(&B, -1.0f, 1.0f);
+
+    for(size_t i = 0; i < m; i++)
+    {
+        q_matrix_t row = q_matrix_view_row(&A, i);
+        q_matrix_t rhs = q_matrix_view_row(&B, i);
+        q_qr_givens_update(&R, &z, &row, &rhs);
+        q_qr_givens_update(&R_only, NULL, &row, NULL);
+    }
+    CU_ASSERT_TRUE(q_matrix_is_equal(&R, &R_only) == Q_MATRIX_OK);
+
+    q_matrix_back_substitution(&R, &z, &x);
+    q_matrix_least_squares(&A, &B, &reference);
+    CU_ASSERT_TRUE(q_matrix_is_approx_float(&x, &reference, 0.01f) == Q_MATRIX_OK);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        for(size_t j = 0; j < n; j++)
+        {
+            double rtr = 0.0, ata = 0.0;
+            for(size_t p = 0; p < n; p++)
+            {
+                rtr += q_to_float(Q_MATRIX_AT(&R, p, i)) * q_to_float(Q_MATRIX_AT(&R, p, j));
+            }
+            for(size_t p = 0; p < m; p++)
+            {
+                ata += q_to_float(Q_MATRIX_AT(&A, p, i)) * q_to_float(Q_MATRIX_AT(&A, p, j));
+            }
+            CU_ASSERT_DOUBLE_EQUAL(rtr, ata, 0.01);
+        }
+        for(size_t j = 0; j < i; j++)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&R, i, j), Q_ZERO);
+        }
+    }
+
+    q_matrix_free(&A);
+    q_matrix_free(&B);
+    q_matrix_free(&R);
+    q_matrix_free(&R_only);
+    q_matrix_free(&z);
+    q_matrix_free(&x);
+    q_matrix_free(&reference);
+}
+
+void add_qr_tests(CU_pSuite suite)
+{
+    if(NULL == CU_add_test(suite, "test_q_qr_decompose", test_q_qr_decompose)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_qr_decompose_blocked", test_q_qr_decompose_blocked)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_qr_solve", test_q_qr_solve)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_givens", test_q_givens)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_qr_givens_update", test_q_qr_givens_update)) {
+        return;
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef TEST_Q_QR_H
+#define TEST_Q_QR_H
+#include "CUnit/Basic.h"
+#include "../include/fix_point_qr.h"
+
+void test_q_qr_decompose();
+void test_q_qr_decompose_blocked();
+void test_q_qr_solve();
+void test_q_givens();
+void test_q_qr_givens_update();
+
+void add_qr_tests(CU_pSuite suite);
+
+#endif // TEST_Q_QR_H
@@ -0,0 +1,96 @@
+#include "test_q_simd.h"
+
+#define N_SIMD 67 // Not a multiple of the vector width so the tails are tested as well
+
+void test_q_simd_kernels()
+{
+    /* We are evaluating every kernel level supported by the processor against the scalar kernels.
+    The results must be bit-exact for every length and every alignment of the rows.
+    */
+    q_t a[N_SIMD + 1], b[N_SIMD + 1], expected[N_SIMD + 1], result[N_SIMD + 1];
+
+    for(size_t i = 0; i <= N_SIMD; i++)
+    {
+        a[i] = q_rand(-INT_TO_Q(100), INT_TO_Q(100));
+        b[i] = q_rand(-INT_TO_Q(100), INT_TO_Q(100));
+    }
+    a[0] = Q_RAW_MIN; // Extreme values must wrap around exactly as the scalar code
+    b[1] = Q_RAW_MAX;
+
+    const q_simd_level_t supported = q_simd_detect();
+    q_simd_set_level(Q_SIMD_SCALAR);
+    const q_simd_kernels_t scalar = *q_simd_kernels();
+
+    for(int level = Q_SIMD_SCALAR; level <= (int) supported; level++)
+    {
+        CU_ASSERT_EQUAL(q_simd_set_level((q_simd_level_t) level), (q_simd_level_t) level);
+        const q_simd_kernels_t* kernels = q_simd_kernels();
+
+        for(size_t offset = 0; offset < 2; offset++)
+        {
+            for(size_t n = 0; n + offset <= N_SIMD; n++)
+            {
+                scalar.add(a + offset, b, expected, n);
+                kernels->add(a + offset, b, result, n);
+                CU_ASSERT_TRUE(memcmp(expected, result, n * sizeof(q_t)) == 0);
+
+                scalar.mul(a + offset, b, expected, n);
+                kernels->mul(a + offset, b, result, n);
+                CU_ASSERT_TRUE(memcmp(expected, result, n * sizeof(q_t)) == 0);
+
+                scalar.scale(a + offset, b[n], expected, n);
+                kernels->scale(a + offset, b[n], result, n);
+                CU_ASSERT_TRUE(memcmp(expected, result, n * sizeof(q_t)) == 0);
+
+                scalar.fill(expected, a[n], n);
+                kernels->fill(result, a[n], n);
+                CU_ASSERT_TRUE(memcmp(expected, result, n * sizeof(q_t)) == 0);
+
+                kernels->copy(a + offset, result, n);
+                CU_ASSERT_TRUE(memcmp(a + offset, result, n * sizeof(q_t)) == 0);
+            }
+        }
+    }
+
+    q_simd_set_level(supported);
+}
+
+void test_q_simd_matrix_operations()
+{
+    // The destination of the sum may be one of the sources
+    q_matrix_t a = q_matrix_alloc(2, 2);
+    q_matrix_t b = q_matrix_alloc(2, 2);
+    q_ones(&a);
+    q_ones(&b);
+    q_matrix_sum(&a, &b, &b);
+
+    for(size_t i = 0; i < 2; i++)
+    {
+        for(size_t j = 0; j < 2; j++)
+        {
+            CU_ASSERT_EQUAL(Q_MATRIX_AT(&b, i, j), Q_TWO);
+        }
+    }
+
+    q_matrix_elementwise_mul(&b, &b, &b);
+    q_matrix_scalar_mul(&b, Q_ONE_HALF);
+    CU_ASSERT_EQUAL(Q_MATRIX_AT(&b, 1, 1), Q_TWO);
+
+    q_matrix_free(&a);
+    q_matrix_free(&b);
+}
+
+void add_simd_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_simd_kernels", test_q_simd_kernels)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_simd_matrix_operations", test_q_simd_matrix_operations)) {
+        return;
+    }
+}
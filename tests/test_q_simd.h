@@ -0,0 +1,12 @@
+#ifndef TEST_Q_SIMD_H
+#define TEST_Q_SIMD_H
+#include "CUnit/Basic.h"
+#include "../include/fix_point_simd.h"
+#include "../include/fix_point_matrix.h"
+
+void test_q_simd_kernels();
+void test_q_simd_matrix_operations();
+
+void add_simd_tests(CU_pSuite suite);
+
+#endif // TEST_Q_SIMD_H
@@ -0,0 +1,90 @@
+#include "test_q_thread.h"
+
+#define N_TASKS 1000
+
+struct thread_test_t {
+    int runs[N_TASKS];
+    size_t workers[N_TASKS];
+};
+
+static void count_task(void* ctx, size_t task, size_t worker)
+{
+    struct thread_test_t* t = (struct thread_test_t*) ctx;
+    t->runs[task]++;
+    t->workers[task] = worker;
+
+    volatile size_t spin = (task % 7) * 1000; // Uneven tasks so the threads steal from each other
+    while(spin > 0) spin--;
+}
+
+void test_q_thread_parallel_for()
+{
+    /* Every task must run exactly once and on a worker index lower than the requested number of threads. */
+    const size_t threads[] = {1, 2, 3, 8, 64};
+    static struct thread_test_t t;
+
+    for(size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        for(size_t tasks = 0; tasks <= N_TASKS; tasks += (tasks < 10) ? 1 : 330)
+        {
+            for(size_t j = 0; j < N_TASKS; j++)
+            {
+                t.runs[j] = 0;
+            }
+
+            q_thread_parallel_for(tasks, threads[i], count_task, &t);
+
+            for(size_t j = 0; j < N_TASKS; j++)
+            {
+                CU_ASSERT_EQUAL(t.runs[j], (j < tasks) ? 1 : 0);
+                if(j < tasks)
+                {
+                    CU_ASSERT_TRUE(t.workers[j] < q_thread_resolve(threads[i]));
+                }
+            }
+        }
+    }
+}
+
+void test_q_thread_max_threads()
+{
+    const size_t initial = q_thread_get_max_threads();
+    CU_ASSERT_TRUE(initial >= 1 && initial <= Q_THREAD_MAX);
+
+    q_thread_set_max_threads(3);
+    CU_ASSERT_EQUAL(q_thread_get_max_threads(), 3);
+    CU_ASSERT_EQUAL(q_thread_resolve(0), 3);
+    CU_ASSERT_EQUAL(q_thread_resolve(5), 5);
+    CU_ASSERT_EQUAL(q_thread_resolve(Q_THREAD_MAX + 10), Q_THREAD_MAX);
+
+    q_thread_set_max_threads(0);
+    CU_ASSERT_EQUAL(q_thread_get_max_threads(), initial);
+
+    // The pool is created again after a shutdown
+    static struct thread_test_t t;
+    q_thread_pool_shutdown();
+    for(size_t j = 0; j < N_TASKS; j++)
+    {
+        t.runs[j] = 0;
+    }
+    q_thread_parallel_for(N_TASKS, 4, count_task, &t);
+    for(size_t j = 0; j < N_TASKS; j++)
+    {
+        CU_ASSERT_EQUAL(t.runs[j], 1);
+    }
+}
+
+void add_thread_tests(CU_pSuite suite)
+{
+    if (NULL == suite) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_thread_parallel_for", test_q_thread_parallel_for)) {
+        return;
+    }
+
+    if(NULL == CU_add_test(suite, "test_q_thread_max_threads", test_q_thread_max_threads)) {
+        return;
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef TEST_Q_THREAD_H
+#define TEST_Q_THREAD_H
+#include "CUnit/Basic.h"
+#include "../include/fix_point_thread.h"
+
+void test_q_thread_parallel_for();
+void test_q_thread_max_threads();
+
+void add_thread_tests(CU_pSuite suite);
+
+#endif // TEST_Q_THREAD_H